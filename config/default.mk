@@ -15,5 +15,6 @@ OMPFLAG=-fopenmp #openmp flag for CC and MPICC
 INCLUDE = -I$(HOME)/include# cusp, thrust, jsoncpp and the draw libraries
 LIBS=-lnetcdf -lhdf5 -lhdf5_hl -llapacke # netcdf library for file output
 JSONLIB=-L$(HOME)/include/json/../../src/lib_json -ljsoncpp # json library for input parameters
+FFTWLIB=-lfftw3 -lfftw3_omp # fftw library for the Fourier spectra (dg/spectra.h)
 GLFLAGS =$$(pkg-config --static --libs glfw3) -lGL #glfw3 installation
 endif # INCLUDED
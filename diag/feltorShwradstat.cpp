@@ -77,14 +77,16 @@ int main( int argc, char* argv[])
 	std::cout << p.alpha << " " << p.invkappa<< " " ;
 	//read and write data
 	
+	//the time integrals are accumulated profile by profile, so only one
+	//profile per variable is in memory at a time
 	for( unsigned m=0; m<12; m++) 
 	{
+	err = nc_inq_varid(ncid, names[m].data(), &dataIDs[m]);
 	for (unsigned n=timepos_min; n<timepos_max; n++)
 	{
 	    start1d[0] = n;
 
 	    //read 1d profiles
-	    err = nc_inq_varid(ncid, names[m].data(), &dataIDs[m]);
 	    err = nc_get_vara_double(ncid, dataIDs[m], start1d, count1d, temp1d.data());
 	    
 	    //integrate with trapez rule
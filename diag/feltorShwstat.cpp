@@ -6,24 +6,27 @@
 #include <sstream>
 #include <numeric>
 #include <iterator>
+#include <algorithm>
 #include "dg/algorithm.h"
 
 #include "dg/file/file.h"
 #include "feltorShw/parameters.h"
 
-double Mean(std::vector<double> v, unsigned imin, unsigned imax)
-{     
-       double sum=0;
-       for(unsigned i=imin;i<imax;i++)
-               sum+=v[i];
-       return sum/(imax-imin);
-}
-double StdDev(std::vector<double> v, double mean, unsigned imin, unsigned imax)
+//Moments of the values imin <= i < imax of a time series, read in blocks
+dg::StreamingMoments<double> Moments(int ncid, int varID, unsigned imin, unsigned imax)
 {
-       double E=0.;
-       for(unsigned i=imin;i<imax;i++)
-               E+=(v[i] - mean)*(v[i] - mean);
-       return sqrt(E/(imax-imin));
+    dg::file::NC_Error_Handle err;
+    const size_t block = 1000;
+    dg::StreamingMoments<double> moments;
+    dg::HVec temp;
+    for( size_t start=imin; start<imax; start+=block)
+    {
+        size_t count = std::min( block, imax-start);
+        temp.resize( count);
+        err = nc_get_vara_double( ncid, varID, &start, &count, temp.data());
+        moments.add( temp);
+    }
+    return moments;
 }
 
 int main( int argc, char* argv[])
@@ -58,7 +61,6 @@ int main( int argc, char* argv[])
 	size_t numOut;
         err = nc_inq_dimid(ncid, "time", &timeID);        
         err = nc_inq_dimlen(ncid, timeID, &numOut);
-	std::vector<double> temp(numOut);
 	std::vector<double> vt(numOut);
 	
 	err = nc_get_vara_double( ncid, timeID,     &start0d, &numOut, vt.data());
@@ -73,8 +75,8 @@ int main( int argc, char* argv[])
     unsigned timepos_min = std::distance( vt.begin(),timepoint_min);
 	unsigned timepos_max = std::distance( vt.begin(),timepoint_max);
     
-    if (timepos_max > temp.size()) {
-        timepos_max = temp.size();
+    if (timepos_max > vt.size()) {
+        timepos_max = vt.size();
     }
     
 	std::cout << p.alpha << " " << p.invkappa;
@@ -82,17 +84,18 @@ int main( int argc, char* argv[])
 
 	for( unsigned m=0; m<30; m++) {
 	    err = nc_inq_varid(ncid, names[m].data(), &dataIDs[m]);
-	    err = nc_get_vara_double( ncid, dataIDs[m], &start0d, &numOut, temp.data());
-
-	    double mean   = Mean(  temp,      timepos_min, timepos_max);
-	    double stddev = StdDev(temp, mean, timepos_min, timepos_max); 
-	    std::cout << " " << mean << " " << stddev; // << " " << stddev/mean;
+	    dg::StreamingMoments<double> moments = Moments( ncid, dataIDs[m], timepos_min, timepos_max);
+	    std::cout << " " << moments.mean() << " " << moments.stddev(); // << " " << moments.stddev()/moments.mean();
 	}
 	//[[vy]]_norm
 
     err = nc_inq_varid(ncid, names[30].data(), &dataIDs[30]);
-    err = nc_get_vara_double( ncid, dataIDs[30], &start0d, &numOut, temp.data());
-    std::cout << " " << temp[timepos_max-1]-temp[timepos_min];
+    double vy_min, vy_max;
+    size_t pos = timepos_min;
+    err = nc_get_var1_double( ncid, dataIDs[30], &pos, &vy_min);
+    pos = timepos_max-1;
+    err = nc_get_var1_double( ncid, dataIDs[30], &pos, &vy_max);
+    std::cout << " " << vy_max-vy_min;
     
     std::cout << " " << vt[timepos_min]/p.invkappa;
     std::cout << " " << vt[timepos_max-1]/p.invkappa;
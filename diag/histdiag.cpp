@@ -12,24 +12,12 @@
 /**
  * @brief normalizes input vector 
  */ 
-void NormalizeToFluc(std::vector<double>& in) {
-    double ex= 0.;
-    double exx= 0.;
-    double ex2= 0.;
-    double sigma = 0.;    
-    for (unsigned j=0;j<in.size();j++)
-    {
-        ex+=in[j];
-        exx+=in[j]*in[j];
-    }
-    ex/=in.size();
-    exx/=in.size();
-    ex2=ex*ex;
-    sigma=sqrt(exx-ex2);
-    for (unsigned j=0;j<in.size();j++)
-    {
-        in[j] = (in[j]-  ex)/sigma; 
-    }
+void NormalizeToFluc(dg::HVec& in) {
+    dg::StreamingMoments<double> moments;
+    moments.add( in);
+    const double ex = moments.mean(), sigma = moments.stddev();
+    dg::blas1::transform( in, in, dg::PLUS<double>( -ex));
+    dg::blas1::scal( in, 1./sigma);
     std::cout << "Sigma = " <<sigma << " Meanvalue = " << ex << std::endl;
 }
 
@@ -47,8 +35,8 @@ int main( int argc, char* argv[])
     const unsigned nhist = 1;
     const unsigned Ninput =100;
     const double Nsigma =4.;
-    std::vector<double> input1(Ninput,0.);    
-    std::vector<double> input2(Ninput,0.);    
+    dg::HVec input1(Ninput,0.);    
+    dg::HVec input2(Ninput,0.);    
 
     thrust::random::minstd_rand generator;
     thrust::random::normal_distribution<double> d1;
@@ -80,16 +68,19 @@ int main( int argc, char* argv[])
     dg::Grid1d  g1d1(-Nsigma,Nsigma, nhist, Nhist,dg::DIR);
     dg::Grid1d  g1d2(-Nsigma,Nsigma, nhist, Nhist,dg::DIR); 
     dg::Grid2d  g2d( -Nsigma,Nsigma,-Nsigma,Nsigma, nhist, Nhist,Nhist,dg::DIR,dg::DIR); 
-    dg::Histogram<dg::HVec> hist1(g1d1,input1);  
-    dg::Histogram<dg::HVec> hist2(g1d2,input2);    
-    dg::Histogram2D<dg::HVec> hist12(g2d,input1,input2);    
+    //the bin midpoints coincide with the abscissas of the grids
+    dg::StreamingHistogram<double> hist1( -Nsigma, Nsigma, Nhist);
+    dg::StreamingHistogram<double> hist2( -Nsigma, Nsigma, Nhist);
+    dg::StreamingHistogram2d<double> hist12( -Nsigma, Nsigma, Nhist, -Nsigma, Nsigma, Nhist);
+    hist1.add( input1);
+    hist2.add( input2);
+    hist12.add( input1, input2);
 
- 
-    dg::HVec PA1 = dg::evaluate(hist1,g1d1);
-    dg::HVec A1 = dg::evaluate(dg::cooX1d,g1d1);
-    dg::HVec PA2= dg::evaluate(hist2,g1d2);
-    dg::HVec A2 = dg::evaluate(dg::cooX1d,g1d2);
-    dg::HVec PA1A2= dg::evaluate(hist12,g2d);
+    dg::HVec PA1 = hist1.pdf();
+    dg::HVec A1 = hist1.abscissas();
+    dg::HVec PA2= hist2.pdf();
+    dg::HVec A2 = hist2.abscissas();
+    dg::HVec PA1A2= hist12.pdf();
     
     //-----------------NC output start
     int dataIDs1[2],dataIDs2[2],dataIDs12[1];
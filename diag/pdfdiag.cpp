@@ -0,0 +1,87 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dg/algorithm.h"
+#include "dg/file/nc_utilities.h"
+
+/**
+ * Compute the moments and the pdf of the normalized fluctuations
+ * (X - <X>)/sigma of a time dependent variable X in a netcdf file.
+ * The frames are read one after the other, so only one frame needs to fit into memory.
+ * All values are weighted equally.
+ */
+int main( int argc, char* argv[])
+{
+    if( argc != 4 && argc != 5)
+    {
+        std::cerr << "Usage: "<<argv[0]<<" [input.nc] [output.nc] [variable] ([bins])\n";
+        return -1;
+    }
+    std::cout << argv[1]<< " -> "<<argv[2]<<std::endl;
+    const std::string name = argv[3];
+    const unsigned Nhist = argc == 5 ? std::stoi( argv[4]) : 50;
+    const double Nsigma = 4.;
+
+    dg::file::NC_Error_Handle err;
+    int ncid, varID, ndims;
+    err = nc_open( argv[1], NC_NOWRITE, &ncid);
+    err = nc_inq_varid( ncid, name.data(), &varID);
+    err = nc_inq_varndims( ncid, varID, &ndims);
+    std::vector<int> dimIDs( ndims);
+    err = nc_inq_vardimid( ncid, varID, dimIDs.data());
+    std::vector<size_t> start( ndims, 0), count( ndims, 1);
+    size_t frames, size = 1;
+    err = nc_inq_dimlen( ncid, dimIDs[0], &frames);
+    for( int i=1; i<ndims; i++)
+    {
+        err = nc_inq_dimlen( ncid, dimIDs[i], &count[i]);
+        size *= count[i];
+    }
+    std::cout << "Variable "<<name<<" has "<<frames<<" frames of size "<<size<<"\n";
+    dg::HVec frame( size);
+
+    //first pass: moments
+    dg::StreamingMoments<double> moments;
+    for( unsigned k=0; k<frames; k++)
+    {
+        start[0] = k;
+        err = nc_get_vara_double( ncid, varID, start.data(), count.data(), frame.data());
+        moments.add( frame);
+    }
+    const double mean = moments.mean(), sigma = moments.stddev();
+    std::cout << "Sigma = " <<sigma << " Meanvalue = " << mean << std::endl;
+    std::cout << "Skewness = " <<moments.skewness() << " Kurtosis = " << moments.kurtosis() << std::endl;
+
+    //second pass: pdf of normalized fluctuations
+    dg::StreamingHistogram<double> hist( -Nsigma, Nsigma, Nhist);
+    for( unsigned k=0; k<frames; k++)
+    {
+        start[0] = k;
+        err = nc_get_vara_double( ncid, varID, start.data(), count.data(), frame.data());
+        dg::blas1::transform( frame, frame, dg::PLUS<double>( -mean));
+        dg::blas1::scal( frame, sigma > 0 ? 1./sigma : 1.);
+        hist.add( frame);
+    }
+    err = nc_close( ncid);
+    dg::HVec PA = hist.pdf();
+    dg::HVec A = hist.abscissas();
+
+    //-----------------NC output start
+    int dim_id, dataIDs[2];
+    err = nc_create( argv[2], NC_NETCDF4|NC_CLOBBER, &ncid);
+    dg::Grid1d g1d( -Nsigma, Nsigma, 1, Nhist, dg::DIR);
+    err = dg::file::define_dimension( ncid, &dim_id, g1d, "A_");
+    err = nc_def_var( ncid, "P(A)", NC_DOUBLE, 1, &dim_id, &dataIDs[0]);
+    err = nc_def_var( ncid, "A",    NC_DOUBLE, 1, &dim_id, &dataIDs[1]);
+    double stats[4] = { mean, sigma, moments.skewness(), moments.kurtosis()};
+    std::string stat_names[4] = { "mean", "stddev", "skewness", "kurtosis"};
+    for( unsigned i=0; i<4; i++)
+        err = nc_put_att_double( ncid, NC_GLOBAL, stat_names[i].data(), NC_DOUBLE, 1, &stats[i]);
+    err = nc_enddef( ncid);
+    err = nc_put_var_double( ncid, dataIDs[0], PA.data() );
+    err = nc_put_var_double( ncid, dataIDs[1], A.data() );
+    err = nc_close( ncid);
+
+    return 0;
+}
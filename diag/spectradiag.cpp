@@ -0,0 +1,110 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dg/algorithm.h"
+#include "dg/spectra.h"
+#include "dg/file/file.h"
+#include "toefl/parameters.h"
+
+/**
+ * Compute the time averaged Fourier spectra of the fields in a toefl output file
+ * and the coherence between each pair of fields. The frames are read one after
+ * the other and transformed in batches, so only one batch needs to fit into memory.
+ * The FFTW wisdom is cached in the file "spectradiag.wisdom".
+ */
+int main( int argc, char* argv[])
+{
+    if( argc < 4)
+    {
+        std::cerr << "Usage: "<<argv[0]<<" [input.nc] [output.nc] [variable] ([variable] ...)\n";
+        return -1;
+    }
+    std::cout << argv[1]<< " -> "<<argv[2]<<std::endl;
+    std::vector<std::string> names( argv+3, argv+argc);
+    const unsigned num = names.size(), batch = 10;
+
+    dg::file::NC_Error_Handle err;
+    int ncid;
+    err = nc_open( argv[1], NC_NOWRITE, &ncid);
+    size_t length;
+    err = nc_inq_attlen( ncid, NC_GLOBAL, "inputfile", &length);
+    std::string input(length, 'x');
+    err = nc_get_att_text( ncid, NC_GLOBAL, "inputfile", &input[0]);
+    Json::Value js;
+    dg::file::string2Json( input, js, dg::file::comments::are_forbidden);
+    const Parameters p(js);
+    p.display(std::cout);
+    dg::Grid2d g2d( 0., p.lx, 0., p.ly, p.n_out, p.Nx_out, p.Ny_out, p.bc_x, p.bc_y);
+
+    std::vector<int> dataIDs( num);
+    for( unsigned i=0; i<num; i++)
+        err = nc_inq_varid( ncid, names[i].data(), &dataIDs[i]);
+    int timeID;
+    size_t frames;
+    err = nc_inq_dimid( ncid, "time", &timeID);
+    err = nc_inq_dimlen( ncid, timeID, &frames);
+    std::cout << "Transform "<<frames<<" frames of "<<num<<" fields\n";
+
+    dg::FFTSpectra2d spectra( g2d, num, batch, "spectradiag.wisdom");
+    std::vector<dg::HVec> fields( num, dg::evaluate( dg::zero, g2d));
+    std::vector<const dg::HVec*> ptrs( num);
+    size_t start2d[3]  = {0, 0, 0};
+    size_t count2d[3]  = {1, g2d.n()*g2d.Ny(), g2d.n()*g2d.Nx()};
+    for( unsigned k=0; k<frames; k++)
+    {
+        start2d[0] = k;
+        for( unsigned i=0; i<num; i++)
+        {
+            err = nc_get_vara_double( ncid, dataIDs[i], start2d, count2d, fields[i].data());
+            ptrs[i] = &fields[i];
+        }
+        spectra.add( ptrs);
+    }
+    spectra.flush();
+    err = nc_close( ncid);
+
+    //-----------------NC output start
+    err = nc_create( argv[2], NC_NETCDF4|NC_CLOBBER, &ncid);
+    err = nc_put_att_text( ncid, NC_GLOBAL, "inputfile", input.size(), input.data());
+    int dim_ids[2], kxID, kyID;
+    err = nc_def_dim( ncid, "ky", spectra.Ny(), &dim_ids[0]);
+    err = nc_def_dim( ncid, "kx", spectra.Nx()/2+1, &dim_ids[1]);
+    err = nc_def_var( ncid, "ky", NC_DOUBLE, 1, &dim_ids[0], &kyID);
+    err = nc_def_var( ncid, "kx", NC_DOUBLE, 1, &dim_ids[1], &kxID);
+    std::vector<int> S2dIDs( num), SkxIDs( num), SkyIDs( num);
+    for( unsigned i=0; i<num; i++)
+    {
+        err = nc_def_var( ncid, ("S("+names[i]+")").data(), NC_DOUBLE, 2, dim_ids, &S2dIDs[i]);
+        err = nc_def_var( ncid, ("S_kx("+names[i]+")").data(), NC_DOUBLE, 1, &dim_ids[1], &SkxIDs[i]);
+        err = nc_def_var( ncid, ("S_ky("+names[i]+")").data(), NC_DOUBLE, 1, &dim_ids[0], &SkyIDs[i]);
+    }
+    std::vector<int> CkxIDs, CkyIDs;
+    for( unsigned i=0; i<num; i++)
+        for( unsigned j=i+1; j<num; j++)
+        {
+            std::string pair = "("+names[i]+","+names[j]+")";
+            CkxIDs.push_back(0), CkyIDs.push_back(0);
+            err = nc_def_var( ncid, ("C_kx"+pair).data(), NC_DOUBLE, 1, &dim_ids[1], &CkxIDs.back());
+            err = nc_def_var( ncid, ("C_ky"+pair).data(), NC_DOUBLE, 1, &dim_ids[0], &CkyIDs.back());
+        }
+    err = nc_enddef( ncid);
+    err = nc_put_var_double( ncid, kyID, spectra.ky().data());
+    err = nc_put_var_double( ncid, kxID, spectra.kx().data());
+    for( unsigned i=0; i<num; i++)
+    {
+        err = nc_put_var_double( ncid, S2dIDs[i], spectra.power2d(i).data());
+        err = nc_put_var_double( ncid, SkxIDs[i], spectra.power_kx(i).data());
+        err = nc_put_var_double( ncid, SkyIDs[i], spectra.power_ky(i).data());
+    }
+    unsigned k=0;
+    for( unsigned i=0; i<num; i++)
+        for( unsigned j=i+1; j<num; j++)
+        {
+            err = nc_put_var_double( ncid, CkxIDs[k], spectra.coherence_kx(i,j).data());
+            err = nc_put_var_double( ncid, CkyIDs[k], spectra.coherence_ky(i,j).data());
+            k++;
+        }
+    err = nc_close( ncid);
+    return 0;
+}
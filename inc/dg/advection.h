@@ -1,5 +1,8 @@
 #ifndef _DG_ADVECTION_H
 #define _DG_ADVECTION_H
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
 #include "blas.h"
 #include "topology/geometry.h"
 #include "enums.h"
@@ -15,6 +18,66 @@
   */
 namespace dg
 {
+///@cond
+namespace detail
+{
+//the fused upwind kernel for MPI matrices and vectors
+struct MPIEllFusableTag{};
+template<class Matrix, class ...Containers>
+struct is_mpi_ell_fusable : std::false_type{};
+
+//halo buffers of the x and y derivatives (only MPI matrices need them)
+template<class Matrix>
+struct UpwindHalo
+{
+    UpwindHalo() = default;
+    UpwindHalo( const Matrix& dx, const Matrix& dy){}
+};
+
+//check that the four derivatives can be used in the fused kernel
+template<class Matrix>
+bool upwind_fusable( const Matrix& dxb, const Matrix& dxf, const Matrix& dyb, const Matrix& dyf)
+{
+    return ell_fusable_2d( dxb, dyb) && ell_fusable_2d( dxf, dyf);
+}
+#ifdef MPI_VERSION
+template<class Container>
+struct is_mpi_host_thrust_vector : std::false_type{};
+template<class LocalContainer>
+struct is_mpi_host_thrust_vector<MPI_Vector<LocalContainer>> :
+    is_host_thrust_vector<LocalContainer>{};
+
+template<class T, class Collective, class ...Containers>
+struct is_mpi_ell_fusable<RowColDistMat<EllSparseBlockMat<T>, CooSparseBlockMat<T>, Collective>, Containers...> :
+    std::integral_constant<bool, dg::all_true<is_mpi_host_thrust_vector<std::decay_t<Containers>>::value...>::value>{};
+
+template<class Inner, class Outer, class Collective>
+struct UpwindHalo<RowColDistMat<Inner, Outer, Collective>>
+{
+    UpwindHalo() = default;
+    UpwindHalo( const RowColDistMat<Inner, Outer, Collective>& dx,
+        const RowColDistMat<Inner, Outer, Collective>& dy):
+        x( dx.collective().allocate_buffer()), y( dy.collective().allocate_buffer()){}
+    Buffer<typename Collective::buffer_type> x, y;
+};
+
+template<class Inner, class Outer, class Collective>
+bool upwind_fusable( const RowColDistMat<Inner, Outer, Collective>& dxb,
+    const RowColDistMat<Inner, Outer, Collective>& dxf,
+    const RowColDistMat<Inner, Outer, Collective>& dyb,
+    const RowColDistMat<Inner, Outer, Collective>& dyf)
+{
+    return upwind_fusable( dxb.inner_matrix(), dxf.inner_matrix(),
+        dyb.inner_matrix(), dyf.inner_matrix());
+}
+#endif //MPI_VERSION
+
+template<class Matrix, class ...Containers>
+using upwind_kernel_tag = std::conditional_t<
+    is_mpi_ell_fusable<Matrix, Containers...>::value, MPIEllFusableTag,
+    is_ell_fusable<Matrix, Containers...>>;
+}//namespace detail
+///@endcond
 
     //MW this scheme cannot be formulated as a weak form
 
@@ -34,6 +97,14 @@ dg::Advection < dg::CartesianGrid2d, dg::DMatrix, dg::DVec> advection(grid);
 // df = - v Grad f
 advection.upwind( -1., vx, vy, f, 0., df);
 @endcode
+ * @note If \c Matrix is \c dg::EllSparseBlockMat or \c dg::EllSparseBlockMatDevice
+ * and \c Container is a shared vector with serial or OpenMP execution policy
+ * the four derivatives and the upwind selection are computed by a fused
+ * kernel in one sweep without temporaries. Only the derivative selected by
+ * the sign of the velocity is evaluated. The same holds for the MPI versions
+ * (\c dg::RowColDistMat of Ell matrices and \c dg::MPI_Vector of host
+ * vectors), where one halo exchange per direction serves both the forward
+ * and the backward derivative and overlaps with the fused inner kernel.
  * @note This scheme brings its own numerical diffusion and thus does not need any other artificial viscosity mechanisms. The only places where the scheme might run into oscillations is if there is a stagnation point with v==0 at a fixed position
  * @sa A discussion of this and other advection schemes can be found here https://mwiesenberger.github.io/advection
  * @copydoc hide_geometry_matrix_container
@@ -89,11 +160,126 @@ struct Advection
     void upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result);
 
   private:
+    template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+    void do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, std::false_type);
+    template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+    void do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, std::true_type);
+    template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+    void do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, detail::MPIEllFusableTag);
     Container m_temp0, m_temp1;
     Matrix m_dxf, m_dyf, m_dxb, m_dyb;
+    detail::UpwindHalo<Matrix> m_halo;
+    bool m_fused = false;
 };
 
 ///@cond
+namespace detail
+{
+//Compute alpha*( vx*dx f + vy*dy f) + beta*result in one sweep where dx and
+//dy are the backward derivatives for positive v and the forward ones else
+//The order of operations is the same as in the unfused version
+template<class T, class Matrix>
+void upwind_fused( bool parallel, const Matrix& dxb, const Matrix& dxf,
+    const Matrix& dyb, const Matrix& dyf, T alpha, const T* RESTRICT vx,
+    const T* RESTRICT vy, const T* RESTRICT f, T beta, T* RESTRICT result)
+{
+    const int n = dyb.n, Nx = dxb.num_rows, Ny = dyb.num_rows;
+    const int planes = dyb.left_size, nx = n*Nx;
+    //index 0 is backward, 1 is forward
+    const EllStencilIndex sx[2] = { ell_index( dxb), ell_index( dxf)};
+    const EllStencilIndex sy[2] = { ell_index( dyb), ell_index( dyf)};
+    const int bplx[2] = { dxb.blocks_per_line, dxf.blocks_per_line};
+    const int bply[2] = { dyb.blocks_per_line, dyf.blocks_per_line};
+    const T* xdata[2] = { thrust::raw_pointer_cast( dxb.data.data()),
+        thrust::raw_pointer_cast( dxf.data.data())};
+    const T* ydata[2] = { thrust::raw_pointer_cast( dyb.data.data()),
+        thrust::raw_pointer_cast( dyf.data.data())};
+    auto do_row = [&]( int row)
+    {
+        const int k = row/(Ny*n), j = (row/n)%Ny, ky = row%n;
+        for( int i=0; i<Nx; i++)
+        for( int kx=0; kx<n; kx++)
+        {
+            const int I = row*nx + i*n+kx;
+            const int ux = vx[I] >= 0 ? 0 : 1, uy = vy[I] >= 0 ? 0 : 1;
+            T derx = 0, dery = 0;
+            for( int d=0; d<bplx[ux]; d++)
+            {
+                int col, D;
+                sx[ux]( i, d, col, D);
+                const int B = (D*n+kx)*n, J = (row*Nx+col)*n;
+                T temp = 0;
+                for( int q=0; q<n; q++) //multiplication-loop
+                    temp = DG_FMA( xdata[ux][B+q], f[J+q], temp);
+                derx += temp;
+            }
+            for( int d=0; d<bply[uy]; d++)
+            {
+                int col, D;
+                sy[uy]( j, d, col, D);
+                const int B = (D*n+ky)*n;
+                T temp = 0;
+                for( int q=0; q<n; q++) //multiplication-loop
+                    temp = DG_FMA( ydata[uy][B+q],
+                        f[((k*Ny+col)*n+q)*nx + i*n+kx], temp);
+                dery += temp;
+            }
+            T temp = result[I]*beta;
+            temp = DG_FMA( alpha, derx*vx[I], temp);
+            result[I] = DG_FMA( alpha, dery*vy[I], temp);
+        }
+    };
+#ifdef _OPENMP
+    if( parallel && omp_in_parallel())
+    {
+        #pragma omp for
+        for( int row=0; row<planes*Ny*n; row++)
+            do_row( row);
+        return;
+    }
+    if( parallel)
+    {
+        #pragma omp parallel for
+        for( int row=0; row<planes*Ny*n; row++)
+            do_row( row);
+        return;
+    }
+#endif
+    for( int row=0; row<planes*Ny*n; row++)
+        do_row( row);
+}
+
+//Add alpha*v*M_o f of the outer (halo) matrix selected by the sign of v
+//(backward for positive v and forward else) to result
+template<class T>
+void upwind_outer( const CooSparseBlockMat<T>& mb, const CooSparseBlockMat<T>&
+    mf, T alpha, const T* RESTRICT v, const T** x, T* RESTRICT result)
+{
+    //index 0 is backward, 1 is forward
+    const CooSparseBlockMat<T>* m[2] = { &mb, &mf};
+    for( int u=0; u<2; u++)
+    {
+        const CooSparseBlockMat<T>& mu = *m[u];
+        const int n = mu.n, left_size = mu.left_size, right_size = mu.right_size;
+        for( int s=0; s<left_size; s++)
+        for( int k=0; k<n; k++)
+        for( int j=0; j<right_size; j++)
+        for( int i=0; i<mu.num_entries; i++)
+        {
+            const int I = ((s*mu.num_rows + mu.rows_idx[i])*n+k)*right_size+j;
+            if( (v[I] >= 0 ? 0 : 1) != u)
+                continue;
+            T temp = 0;
+            for( int q=0; q<n; q++) //multiplication-loop
+                temp = DG_FMA( mu.data[ (mu.data_idx[i]*n + k)*n+q],
+                        x[mu.cols_idx[i]][(q*left_size +s )*right_size+j],
+                        temp);
+            result[I] = DG_FMA( alpha, temp*v[I], result[I]);
+        }
+    }
+}
+}//namespace detail
+
 template<class Geometry, class Matrix, class Container>
 Advection<Geometry, Matrix, Container>::Advection( const Geometry& g ):
     Advection( g, g.bcx(), g.bcy()) { }
@@ -104,13 +290,90 @@ Advection<Geometry, Matrix, Container>::Advection( const Geometry& g, bc bcx, bc
     m_dxf(dg::create::dx( g, bcx, dg::forward)),
     m_dyf(dg::create::dy( g, bcy, dg::forward)),
     m_dxb(dg::create::dx( g, bcx, dg::backward)),
-    m_dyb(dg::create::dy( g, bcy, dg::backward))
+    m_dyb(dg::create::dy( g, bcy, dg::backward)),
+    m_halo( m_dxb, m_dyb)
 {
+    m_fused = ( detail::is_ell_fusable<Matrix,Container>::value ||
+        detail::is_mpi_ell_fusable<Matrix,Container>::value) &&
+        detail::upwind_fusable( m_dxb, m_dxf, m_dyb, m_dyf);
 }
 
 template< class Geometry, class Matrix, class Container>
 template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
 void Advection<Geometry, Matrix, Container>::upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result)
+{
+    do_upwind( alpha, vx, vy, f, beta, result, detail::upwind_kernel_tag<Matrix,
+        Container, ContainerType0, ContainerType1, ContainerType2, ContainerType3>());
+}
+
+template< class Geometry, class Matrix, class Container>
+template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+void Advection<Geometry, Matrix, Container>::do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, std::true_type)
+{
+    const value_type* f_ptr = thrust::raw_pointer_cast( f.data());
+    value_type* result_ptr = thrust::raw_pointer_cast( result.data());
+    //neighbouring points of f are read after result is written
+    if( !m_fused || result_ptr == f_ptr)
+    {
+        do_upwind( alpha, vx, vy, f, beta, result, std::false_type());
+        return;
+    }
+    detail::upwind_fused<value_type>(
+        std::is_same<get_execution_policy<Container>, OmpTag>::value,
+        m_dxb, m_dxf, m_dyb, m_dyf, alpha,
+        thrust::raw_pointer_cast( vx.data()),
+        thrust::raw_pointer_cast( vy.data()), f_ptr, beta, result_ptr);
+}
+
+#ifdef MPI_VERSION
+template< class Geometry, class Matrix, class Container>
+template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+void Advection<Geometry, Matrix, Container>::do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, detail::MPIEllFusableTag)
+{
+    const value_type* f_ptr = thrust::raw_pointer_cast( f.data().data());
+    value_type* result_ptr = thrust::raw_pointer_cast( result.data().data());
+    //neighbouring points of f are read after result is written
+    if( !m_fused || result_ptr == f_ptr)
+    {
+        do_upwind( alpha, vx, vy, f, beta, result, std::false_type());
+        return;
+    }
+    const value_type* vx_ptr = thrust::raw_pointer_cast( vx.data().data());
+    const value_type* vy_ptr = thrust::raw_pointer_cast( vy.data().data());
+    //1. initiate communication: the forward and backward derivatives have
+    //the same halo, so one exchange per direction serves both
+    const auto& cx = m_dxb.collective();
+    const auto& cy = m_dyb.collective();
+    MPI_Request rqstx[4], rqsty[4];
+    if( cx.isCommunicating())
+        cx.global_gather_init( f_ptr, m_halo.x.data(), rqstx);
+    if( cy.isCommunicating())
+        cy.global_gather_init( f_ptr, m_halo.y.data(), rqsty);
+    //2. compute inner points
+    detail::upwind_fused<value_type>(
+        std::is_same<get_execution_policy<Container>, OmpTag>::value,
+        m_dxb.inner_matrix(), m_dxf.inner_matrix(),
+        m_dyb.inner_matrix(), m_dyf.inner_matrix(), alpha,
+        vx_ptr, vy_ptr, f_ptr, beta, result_ptr);
+    //3. wait for communication to finish and add outer points
+    if( cx.isCommunicating())
+    {
+        cx.global_gather_wait( f_ptr, m_halo.x.data(), rqstx);
+        detail::upwind_outer( m_dxb.outer_matrix(), m_dxf.outer_matrix(), alpha,
+            vx_ptr, thrust::raw_pointer_cast( m_halo.x.data().data()), result_ptr);
+    }
+    if( cy.isCommunicating())
+    {
+        cy.global_gather_wait( f_ptr, m_halo.y.data(), rqsty);
+        detail::upwind_outer( m_dyb.outer_matrix(), m_dyf.outer_matrix(), alpha,
+            vy_ptr, thrust::raw_pointer_cast( m_halo.y.data().data()), result_ptr);
+    }
+}
+#endif //MPI_VERSION
+
+template< class Geometry, class Matrix, class Container>
+template<class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3>
+void Advection<Geometry, Matrix, Container>::do_upwind( value_type alpha, const ContainerType0& vx, const ContainerType1& vy, const ContainerType2& f, value_type beta, ContainerType3& result, std::false_type)
 {
     blas2::symv( m_dxb, f, m_temp0);
     blas2::symv( m_dxf, f, m_temp1);
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "advection.h"
+#include "backend/mpi_init.h"
+
+const double lx = 2*M_PI;
+const double ly = 2*M_PI;
+
+double function( double x, double y) {
+    return sin(x)*cos(y);
+}
+double velocityX( double x, double y) {
+    return -cos(x)*sin(y);
+}
+double velocityY( double x, double y) {
+    return sin(x)*cos(y);
+}
+double solution( double x, double y) {
+    return -cos(x)*sin(y)*cos(x)*cos(y) - sin(x)*cos(y)*sin(x)*sin(y);
+}
+
+int main(int argc, char* argv[])
+{
+    MPI_Init( &argc, &argv);
+    int rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank);
+    MPI_Comm comm[2]; //periodic and non-periodic
+    dg::mpi_init2d( dg::PER, dg::PER, comm[0]);
+    int dims[2], periods[2], coords[2];
+    MPI_Cart_get( comm[0], 2, dims, periods, coords);
+    int non_periodic[2] = {false, false};
+    MPI_Cart_create( MPI_COMM_WORLD, 2, dims, non_periodic, true, &comm[1]);
+    if(rank==0)std::cout<<"This program tests the upwind advection scheme!\n";
+    unsigned n = 3, Nx = 32, Ny = 48;
+    if(rank==0)std::cout << "Computing on the Grid " <<n<<" x "<<Nx<<" x "<<Ny <<std::endl;
+    if(rank==0)std::cout << "A test is passed if the number in the second column shows zero!\n";
+    for( unsigned u=0; u<2; u++)
+    {
+        const dg::bc bc = u == 0 ? dg::PER : dg::DIR;
+        const dg::CartesianMPIGrid2d grid( 0, lx, 0, ly, n, Nx, Ny, bc, bc, comm[u]);
+        const dg::MHVec f  = dg::evaluate( function, grid);
+        const dg::MHVec vx = dg::evaluate( velocityX, grid);
+        const dg::MHVec vy = dg::evaluate( velocityY, grid);
+        const dg::MHVec sol = dg::evaluate( solution, grid);
+        const dg::MHVec w2d = dg::create::weights( grid);
+        dg::MHVec result( f), reference( f), temp0( f), temp1( f);
+
+        dg::Advection<dg::CartesianMPIGrid2d, dg::MHMatrix, dg::MHVec> advection( grid);
+        dg::blas1::copy( 1., result);
+        advection.upwind( 2., vx, vy, f, 0.5, result);
+
+        // the six passes of the unfused scheme
+        dg::MHMatrix dxb = dg::create::dx( grid, bc, dg::backward);
+        dg::MHMatrix dxf = dg::create::dx( grid, bc, dg::forward);
+        dg::MHMatrix dyb = dg::create::dy( grid, bc, dg::backward);
+        dg::MHMatrix dyf = dg::create::dy( grid, bc, dg::forward);
+        dg::blas1::copy( 1., reference);
+        dg::blas2::symv( dxb, f, temp0);
+        dg::blas2::symv( dxf, f, temp1);
+        dg::blas1::evaluate( reference, dg::Axpby<double>( 2., 0.5), dg::UpwindProduct(), vx, temp0, temp1);
+        dg::blas2::symv( dyb, f, temp0);
+        dg::blas2::symv( dyf, f, temp1);
+        dg::blas1::evaluate( reference, dg::Axpby<double>( 2., 1.), dg::UpwindProduct(), vy, temp0, temp1);
+
+        dg::blas1::axpby( 1., reference, -1., result, temp0);
+        double diff = sqrt( dg::blas2::dot( w2d, temp0));
+        if(rank==0)std::cout << (bc == dg::PER ? "PER" : "DIR")<<" Difference to unfused "<<diff<<"\t0\n";
+        // 2 v Grad f + 0.5
+        dg::blas1::axpby( 2., sol, -1., result);
+        dg::blas1::plus( result, 0.5);
+        double dist = sqrt( dg::blas2::dot( w2d, result));
+        if(rank==0)std::cout << (bc == dg::PER ? "PER" : "DIR")<<" Distance to solution  "<<dist<<"\n";
+    }
+    MPI_Finalize();
+    return 0;
+}
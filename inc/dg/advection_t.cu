@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+
+#include "advection.h"
+
+const double lx = 2*M_PI;
+const double ly = 2*M_PI;
+
+double function( double x, double y) {
+    return sin(x)*cos(y);
+}
+double velocityX( double x, double y) {
+    return -cos(x)*sin(y);
+}
+double velocityY( double x, double y) {
+    return sin(x)*cos(y);
+}
+double solution( double x, double y) {
+    return -cos(x)*sin(y)*cos(x)*cos(y) - sin(x)*cos(y)*sin(x)*sin(y);
+}
+
+int main()
+{
+    std::cout<<"This program tests the upwind advection scheme!\n";
+    unsigned n = 3, Nx = 32, Ny = 48;
+    std::cout << "Computing on the Grid " <<n<<" x "<<Nx<<" x "<<Ny <<std::endl;
+    std::cout << "A test is passed if the number in the second column shows zero!\n";
+    for( dg::bc bc : {dg::PER, dg::DIR})
+    {
+        const dg::CartesianGrid2d grid( 0, lx, 0, ly, n, Nx, Ny, bc, bc);
+        const dg::DVec f  = dg::construct<dg::DVec>( dg::evaluate( function, grid));
+        const dg::DVec vx = dg::construct<dg::DVec>( dg::evaluate( velocityX, grid));
+        const dg::DVec vy = dg::construct<dg::DVec>( dg::evaluate( velocityY, grid));
+        const dg::DVec sol = dg::construct<dg::DVec>( dg::evaluate( solution, grid));
+        const dg::DVec w2d = dg::create::weights( grid);
+        dg::DVec result( f), reference( f), temp0( f), temp1( f);
+
+        dg::Advection<dg::aGeometry2d, dg::DMatrix, dg::DVec> advection( grid);
+        dg::blas1::copy( 1., result);
+        advection.upwind( 2., vx, vy, f, 0.5, result);
+
+        // the six passes of the unfused scheme
+        dg::DMatrix dxb = dg::create::dx( grid, bc, dg::backward);
+        dg::DMatrix dxf = dg::create::dx( grid, bc, dg::forward);
+        dg::DMatrix dyb = dg::create::dy( grid, bc, dg::backward);
+        dg::DMatrix dyf = dg::create::dy( grid, bc, dg::forward);
+        dg::blas1::copy( 1., reference);
+        dg::blas2::symv( dxb, f, temp0);
+        dg::blas2::symv( dxf, f, temp1);
+        dg::blas1::evaluate( reference, dg::Axpby<double>( 2., 0.5), dg::UpwindProduct(), vx, temp0, temp1);
+        dg::blas2::symv( dyb, f, temp0);
+        dg::blas2::symv( dyf, f, temp1);
+        dg::blas1::evaluate( reference, dg::Axpby<double>( 2., 1.), dg::UpwindProduct(), vy, temp0, temp1);
+
+        dg::blas1::axpby( 1., reference, -1., result, temp0);
+        std::cout << (bc == dg::PER ? "PER" : "DIR")<<" Difference to unfused "<<sqrt( dg::blas2::dot( w2d, temp0))<<"\t0\n";
+        // 2 v Grad f + 0.5
+        dg::blas1::axpby( 2., sol, -1., result);
+        dg::blas1::plus( result, 0.5);
+        std::cout << (bc == dg::PER ? "PER" : "DIR")<<" Distance to solution  "<<sqrt( dg::blas2::dot( w2d, result))<<"\n";
+    }
+    return 0;
+}
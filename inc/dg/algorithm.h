@@ -31,7 +31,9 @@
 #include "arakawa.h"
 #include "advection.h"
 #include "poisson.h"
+#include "tracers.h"
 #include "simpsons.h"
+#include "statistics.h"
 #include "topology/average.h"
 #ifdef MPI_VERSION
 #include "topology/average_mpi.h"
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include "blas.h"
+#include "gram_schmidt.h"
 
 namespace dg{
 ///@cond
@@ -197,11 +198,12 @@ unsigned AndersonAcceleration<ContainerType>::solve(
 
                     }
                     // Now update the QR decomposition to incorporate the new column.
-                    for (unsigned j = 1; j < mAA; j++) {
-                        m_R[j-1][mAA-1] = dg::blas1::dot(m_Q[j-1],m_df);      //Q(:,j)’*m_df; //Changed mAA -> mAA-1
-
-                        dg::blas1::axpby(-m_R[j-1][mAA-1],m_Q[j-1],1.,m_df);  //m_df = m_df - R(j,mAA)*Q(:,j);
-                    }
+                    std::vector<const ContainerType*> basis( mAA-1);
+                    for (unsigned j = 1; j < mAA; j++)
+                        basis[j-1] = &m_Q[j-1];
+                    std::vector<value_type> h = dg::cgs2( basis, m_df);  //m_df = m_df - Q*(Q'*m_df) (twice)
+                    for (unsigned j = 1; j < mAA; j++)
+                        m_R[j-1][mAA-1] = h[j-1];
                     m_R[mAA-1][mAA-1] = sqrt(dg::blas1::dot(m_df,m_df));
                     dg::blas1::axpby(1./m_R[mAA-1][mAA-1],m_df,0.,m_Q[mAA-1]);
                 }
@@ -211,8 +213,12 @@ unsigned AndersonAcceleration<ContainerType>::solve(
                 //Here should be the check for whether to proceed.
 
                 //Solve least squares problem.
+                std::vector<const ContainerType*> basis( mAA);
+                for (unsigned i = 0; i < mAA; i++)
+                    basis[i] = &m_Q[i];
+                std::vector<value_type> qf = dg::blas1::multi_dot( m_fval, basis); //Q'*m_fval
                 for(int i = (int)mAA-1; i>=0; i--){
-                    m_gamma[i] = dg::blas1::dot(m_Q[i],m_fval);
+                    m_gamma[i] = qf[i];
                     for(int j = i + 1; j < (int)mAA; j++){
                         m_gamma[i] -= m_R[i][j]*m_gamma[j];
                     }
@@ -1,6 +1,11 @@
 #ifndef _DG_ARAKAWA_CUH
 #define _DG_ARAKAWA_CUH
 
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
 #include "blas.h"
 #include "topology/geometry.h"
 #include "enums.h"
@@ -25,6 +30,12 @@ namespace dg
  * If \f$ \chi=1\f$, then the discretization conserves, mass, energy and enstrophy.
  * @snippet arakawa_t.cu function
  * @snippet arakawa_t.cu doxygen
+ * @note If \c Matrix is \c dg::EllSparseBlockMat or \c dg::EllSparseBlockMatDevice
+ * and \c Container is a shared vector with serial or OpenMP execution policy
+ * the bracket is computed by a fused kernel that works on tiles of a few cells
+ * in y. The derivatives then stay in cache instead of making about eight
+ * passes through memory. The result is the same as the unfused version up
+ * to the sign of zeros.
  * @note This is the algorithm published in
  * <a href="https://doi.org/10.1016/j.cpc.2014.07.007">L. Einkemmer, M. Wiesenberger A conservative discontinuous Galerkin scheme for the 2D incompressible Navier-Stokes equations Computer Physics Communications 185, 2865-2873 (2014)</a>
  * @sa A discussion of this and other advection schemes can also be found here https://mwiesenberger.github.io/advection
@@ -115,25 +126,16 @@ struct ArakawaX
     }
 
   private:
+    template<class ContainerType0, class ContainerType1, class ContainerType2>
+    void do_bracket( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result, std::false_type);
+    template<class ContainerType0, class ContainerType1, class ContainerType2>
+    void do_bracket( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result, std::true_type);
     Container m_dxlhs, m_dxrhs, m_dylhs, m_dyrhs, m_helper;
     Matrix m_bdxf, m_bdyf;
     Container m_chi, m_perp_vol;
+    bool m_fused = false;
 };
 ///@cond
-template<class Geometry, class Matrix, class Container>
-ArakawaX<Geometry, Matrix, Container>::ArakawaX( const Geometry& g ):
-    ArakawaX( g, g.bcx(), g.bcy()) { }
-
-template<class Geometry, class Matrix, class Container>
-ArakawaX<Geometry, Matrix, Container>::ArakawaX( const Geometry& g, bc bcx, bc bcy):
-    m_dxlhs( dg::construct<Container>(dg::evaluate( one, g)) ), m_dxrhs(m_dxlhs), m_dylhs(m_dxlhs), m_dyrhs( m_dxlhs), m_helper( m_dxlhs),
-    m_bdxf(dg::create::dx( g, bcx, dg::centered)),
-    m_bdyf(dg::create::dy( g, bcy, dg::centered))
-{
-    m_chi = m_perp_vol = dg::tensor::volume2d(g.metric());
-    dg::blas1::pointwiseDivide( 1., m_perp_vol, m_chi);
-}
-
 template<class T>
 struct ArakawaFunctor
 {
@@ -155,9 +157,218 @@ struct ArakawaFunctor
     }
 };
 
+namespace detail
+{
+//Compute alpha*chi*{lhs,rhs} + beta*result on a few cells in y at a time:
+//1. evaluate the derivatives and the ArakawaFunctor on all cells that the
+//y-derivative of the tile reads from and keep them in a small buffer
+//2. apply the derivatives to the buffer and write the result of the tile
+//The order of operations is the same as in the unfused version
+template<class T, class Matrix>
+void arakawa_fused( bool parallel, const Matrix& dx, const Matrix& dy, T alpha,
+    const T* RESTRICT lhs, const T* RESTRICT rhs, const T* RESTRICT chi,
+    T beta, T* RESTRICT result)
+{
+    const int n = dy.n, Nx = dx.num_rows, Ny = dy.num_rows;
+    const int planes = dy.left_size, nx = n*Nx;
+    const int bplx = dx.blocks_per_line, bply = dy.blocks_per_line;
+    const EllStencilIndex sx = ell_index( dx), sy = ell_index( dy);
+    const auto* RESTRICT dxdata = thrust::raw_pointer_cast( dx.data.data());
+    const auto* RESTRICT dydata = thrust::raw_pointer_cast( dy.data.data());
+    //the three buffers of a tile hold about 32768 values (256KB in double)
+    const int tile = std::max( 1, 32768/(3*n*nx));
+    const int tiles = (Ny+tile-1)/tile;
+    //each thread owns its buffers; work_share distributes the tiles over
+    //the threads of the enclosing parallel region
+    auto do_tiles = [&]( bool work_share)
+    {
+    std::vector<T> bufR, bufA, bufB;
+    std::vector<int> slot( Ny, -1), cells;
+    auto do_tile = [&]( int kt)
+    {
+        const int k = kt/tiles, J0 = (kt%tiles)*tile, J1 = std::min( J0+tile, Ny);
+        //find all cells the tile and its y-derivative need
+        cells.clear();
+        for( int j=J0; j<J1; j++)
+            for( int d=-1; d<bply; d++)
+            {
+                int col = j, D;
+                if( d >= 0)
+                    sy( j, d, col, D);
+                if( slot[col] < 0)
+                {
+                    slot[col] = 0;
+                    cells.push_back( col);
+                }
+            }
+        std::sort( cells.begin(), cells.end());
+        const int num_cells = cells.size();
+        for( int l=0; l<num_cells; l++)
+            slot[cells[l]] = l;
+        const unsigned size = num_cells*n*nx;
+        if( bufR.size() < size)
+            bufR.resize( size), bufA.resize( size), bufB.resize( size);
+        //derivatives and ArakawaFunctor on these cells
+        for( int l=0; l<num_cells; l++)
+        for( int ky=0; ky<n; ky++)
+        {
+            const int j = cells[l], row = (k*Ny+j)*n+ky;
+            for( int i=0; i<Nx; i++)
+            for( int kx=0; kx<n; kx++)
+            {
+                T dxl = 0, dxr = 0, dyl = 0, dyr = 0;
+                for( int d=0; d<bplx; d++)
+                {
+                    int col, D;
+                    sx( i, d, col, D);
+                    const int B = (D*n+kx)*n, J = (row*Nx+col)*n;
+                    T tl = 0, tr = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                    {
+                        tl = DG_FMA( dxdata[B+q], lhs[J+q], tl);
+                        tr = DG_FMA( dxdata[B+q], rhs[J+q], tr);
+                    }
+                    dxl += tl, dxr += tr;
+                }
+                for( int d=0; d<bply; d++)
+                {
+                    int col, D;
+                    sy( j, d, col, D);
+                    const int B = (D*n+ky)*n;
+                    T tl = 0, tr = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                    {
+                        const int J = ((k*Ny+col)*n+q)*nx + i*n+kx;
+                        tl = DG_FMA( dydata[B+q], lhs[J], tl);
+                        tr = DG_FMA( dydata[B+q], rhs[J], tr);
+                    }
+                    dyl += tl, dyr += tr;
+                }
+                const int I = row*nx + i*n+kx, L = (l*n+ky)*nx + i*n+kx;
+                ArakawaFunctor<T>()( lhs[I], rhs[I], dxl, dyl, dxr, dyr);
+                bufR[L] = dyr, bufA[L] = dyl, bufB[L] = dxr;
+            }
+        }
+        //apply the remaining derivatives on the tile
+        for( int j=J0; j<J1; j++)
+        for( int ky=0; ky<n; ky++)
+        {
+            const int row = (k*Ny+j)*n+ky, lj = slot[j];
+            for( int i=0; i<Nx; i++)
+            for( int kx=0; kx<n; kx++)
+            {
+                T value = bufR[(lj*n+ky)*nx + i*n+kx];
+                for( int d=0; d<bplx; d++)
+                {
+                    int col, D;
+                    sx( i, d, col, D);
+                    const int B = (D*n+kx)*n, J = (lj*n+ky)*nx + col*n;
+                    T temp = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp = DG_FMA( dxdata[B+q], bufA[J+q], temp);
+                    value += temp;
+                }
+                for( int d=0; d<bply; d++)
+                {
+                    int col, D;
+                    sy( j, d, col, D);
+                    const int B = (D*n+ky)*n;
+                    T temp = 0;
+                    for( int q=0; q<n; q++) //multiplication-loop
+                        temp = DG_FMA( dydata[B+q],
+                            bufB[(slot[col]*n+q)*nx + i*n+kx], temp);
+                    value += temp;
+                }
+                const int I = row*nx + i*n+kx;
+                T temp = result[I]*beta;
+                result[I] = DG_FMA( alpha*chi[I], value, temp);
+            }
+        }
+        for( int l=0; l<num_cells; l++)
+            slot[cells[l]] = -1;
+    };
+#ifdef _OPENMP
+    if( work_share)
+    {
+        #pragma omp for
+        for( int kt=0; kt<planes*tiles; kt++)
+            do_tile( kt);
+        return;
+    }
+#endif
+    for( int kt=0; kt<planes*tiles; kt++)
+        do_tile( kt);
+    };
+#ifdef _OPENMP
+    if( parallel && omp_in_parallel())
+    {
+        do_tiles( true);
+        return;
+    }
+    if( parallel)
+    {
+        #pragma omp parallel
+        {
+            do_tiles( true);
+        }
+        return;
+    }
+#endif
+    do_tiles( false);
+}
+}//namespace detail
+
+template<class Geometry, class Matrix, class Container>
+ArakawaX<Geometry, Matrix, Container>::ArakawaX( const Geometry& g ):
+    ArakawaX( g, g.bcx(), g.bcy()) { }
+
+template<class Geometry, class Matrix, class Container>
+ArakawaX<Geometry, Matrix, Container>::ArakawaX( const Geometry& g, bc bcx, bc bcy):
+    m_dxlhs( dg::construct<Container>(dg::evaluate( one, g)) ), m_dxrhs(m_dxlhs), m_dylhs(m_dxlhs), m_dyrhs( m_dxlhs), m_helper( m_dxlhs),
+    m_bdxf(dg::create::dx( g, bcx, dg::centered)),
+    m_bdyf(dg::create::dy( g, bcy, dg::centered))
+{
+    m_chi = m_perp_vol = dg::tensor::volume2d(g.metric());
+    dg::blas1::pointwiseDivide( 1., m_perp_vol, m_chi);
+    m_fused = detail::is_ell_fusable<Matrix,Container>::value &&
+        detail::ell_fusable_2d( m_bdxf, m_bdyf);
+}
+
 template< class Geometry, class Matrix, class Container>
 template<class ContainerType0, class ContainerType1, class ContainerType2>
 void ArakawaX< Geometry, Matrix, Container>::operator()( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result)
+{
+    do_bracket( alpha, lhs, rhs, beta, result, detail::is_ell_fusable<Matrix,
+        Container, ContainerType0, ContainerType1, ContainerType2>());
+}
+
+template< class Geometry, class Matrix, class Container>
+template<class ContainerType0, class ContainerType1, class ContainerType2>
+void ArakawaX< Geometry, Matrix, Container>::do_bracket( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result, std::true_type)
+{
+    const value_type* lhs_ptr = thrust::raw_pointer_cast( lhs.data());
+    const value_type* rhs_ptr = thrust::raw_pointer_cast( rhs.data());
+    value_type* result_ptr = thrust::raw_pointer_cast( result.data());
+    //the tiles write the result while other tiles still read the input
+    if( !m_fused || result_ptr == lhs_ptr || result_ptr == rhs_ptr)
+    {
+        do_bracket( alpha, lhs, rhs, beta, result, std::false_type());
+        return;
+    }
+    if( alpha == value_type(0))
+    {
+        dg::blas1::scal( result, beta);
+        return;
+    }
+    detail::arakawa_fused<value_type>(
+        std::is_same<get_execution_policy<Container>, OmpTag>::value,
+        m_bdxf, m_bdyf, alpha, lhs_ptr, rhs_ptr,
+        thrust::raw_pointer_cast( m_chi.data()), beta, result_ptr);
+}
+
+template< class Geometry, class Matrix, class Container>
+template<class ContainerType0, class ContainerType1, class ContainerType2>
+void ArakawaX< Geometry, Matrix, Container>::do_bracket( value_type alpha, const ContainerType0& lhs, const ContainerType1& rhs, value_type beta, ContainerType2& result, std::false_type)
 {
     //compute derivatives in x-space
     blas2::symv( m_bdxf, lhs, m_dxlhs);
@@ -95,6 +95,26 @@ int main()
     dg::blas1::axpby( 1., sol, -1., jac);
     res.d = sqrt(dg::blas2::dot( w2d, jac)); //don't forget sqrt when computing errors
     std::cout << "Distance to solution "<<res.d<<"\t\t"<<res.i-binary[3]<<std::endl;
+
+    // the unfused scheme ( the Cartesian grid has chi = 1)
+    dg::DVec result( lhs), reference( lhs), dxlhs( lhs), dylhs( lhs), dxrhs( lhs), dyrhs( lhs);
+    dg::blas1::copy( 1., result);
+    arakawa( 2., lhs, rhs, 0.5, result);
+    dg::DMatrix dx = dg::create::dx( grid, bcx, dg::centered);
+    dg::DMatrix dy = dg::create::dy( grid, bcy, dg::centered);
+    dg::blas2::symv( dx, lhs, dxlhs);
+    dg::blas2::symv( dy, lhs, dylhs);
+    dg::blas2::symv( dx, rhs, dxrhs);
+    dg::blas2::symv( dy, rhs, dyrhs);
+    dg::blas1::subroutine( dg::ArakawaFunctor<double>(), lhs, rhs, dxlhs, dylhs, dxrhs, dyrhs);
+    dg::blas2::symv( 1., dx, dylhs, 1., dyrhs);
+    dg::blas2::symv( 1., dy, dxrhs, 1., dyrhs);
+    dg::blas1::copy( 1., reference);
+    const dg::DVec chi = dg::evaluate( dg::one, grid);
+    dg::blas1::pointwiseDot( 2., chi, dyrhs, 0.5, reference);
+    dg::blas1::axpby( 1., reference, -1., result);
+    res.d = sqrt(dg::blas2::dot( w2d, result));
+    std::cout << "Difference to unfused "<<res.d<<"\t0\n";
     //periocid bc       |  dirichlet bc
     //n = 1 -> p = 2    |
     //n = 2 -> p = 1    |
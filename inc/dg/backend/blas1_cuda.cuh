@@ -4,6 +4,7 @@
 #include <thrust/system/cuda/execution_policy.h>
 #include "exceptions.h"
 #include "exblas/exdot_cuda.cuh"
+#include "broadcast.h"
 namespace dg
 {
 namespace blas1
@@ -67,6 +68,33 @@ inline void doSubroutine_dispatch( CudaTag, int size, Subroutine f, PointerOrVal
     subroutine_kernel<Subroutine, PointerOrValue, PointerOrValues...><<<NUM_BLOCKS, BLOCK_SIZE>>>(size, f, x, xs...);
 }
 
+template<class Subroutine, class PointerOrValue, class ...PointerOrValues>
+__device__ void subroutine_plane( int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    const int thread_id = blockDim.x * blockIdx.x + threadIdx.x;
+    const int grid_size = gridDim.x*blockDim.x;
+    for( int i = thread_id; i<size; i += grid_size)
+        f(get_device_element(x,i), get_device_element(xs,i)...);
+}
+//the y-dimension of the grid runs over the planes
+template<class Subroutine, class PointerOrValue, class ...PointerOrValues>
+ __global__ void subroutine_planes_kernel( int planes, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    for( int k = blockIdx.y; k<planes; k += gridDim.y)
+        subroutine_plane( size, f, dg::detail::get_plane( x, k*size),
+            dg::detail::get_plane( xs, k*size)...);
+}
+
+//size is the size of one plane
+template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
+inline void doSubroutine_planes_dispatch( CudaTag, int planes, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    const size_t BLOCK_SIZE = 256;
+    const size_t NUM_PLANES = std::min<size_t>( planes, 65000);
+    const size_t NUM_BLOCKS = std::min<size_t>((size-1)/BLOCK_SIZE+1, std::max<size_t>( 65000/NUM_PLANES, 1));
+    subroutine_planes_kernel<Subroutine, PointerOrValue, PointerOrValues...><<<dim3(NUM_BLOCKS, NUM_PLANES), BLOCK_SIZE>>>(planes, size, f, x, xs...);
+}
+
 template<class T, class Pointer, class BinaryOp>
 inline T doReduce_dispatch( CudaTag, int size, Pointer x, T init, BinaryOp op)
 {
@@ -81,6 +81,25 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, MPIVect
     return receive;
 }
 
+template< class Vector1, class Vector2>
+std::vector<int64_t> doMultiDot_superacc( const Vector1& x, const std::vector<const Vector2*>& ys, MPIVectorTag)
+{
+#ifdef DG_DEBUG
+    for( unsigned i=0; i<ys.size(); i++)
+        mpi_assert( x,*ys[i]);
+#endif //DG_DEBUG
+    //local computation
+    using container_type = typename std::decay_t<Vector2>::container_type;
+    std::vector<const container_type*> local( ys.size());
+    for( unsigned i=0; i<ys.size(); i++)
+        local[i] = &ys[i]->data();
+    std::vector<int64_t> acc = doMultiDot_superacc( x.data(), local);
+    std::vector<int64_t> receive(ys.size()*exblas::BIN_COUNT, (int64_t)0);
+    //all superaccumulators are reduced in one go
+    exblas::reduce_mpi_cpu( ys.size(), acc.data(), receive.data(),
+        x.communicator(), x.communicator_mod(), x.communicator_mod_reduce());
+    return receive;
+}
 
 template< class Subroutine, class container, class ...Containers>
 inline void doSubroutine( MPIVectorTag, Subroutine f, container&& x, Containers&&... xs)
@@ -5,6 +5,7 @@
 #include <cassert>
 #endif //DG_DEBUG
 
+#include <algorithm>
 #include <thrust/host_vector.h>
 #include <thrust/device_vector.h>
 
@@ -12,6 +13,7 @@
 #include "scalar_categories.h"
 #include "tensor_traits.h"
 #include "predicate.h"
+#include "broadcast.h"
 
 #include "blas1_serial.h"
 #if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
@@ -48,6 +50,8 @@ namespace detail
 {
 template< class ContainerType1, class ContainerType2>
 inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const ContainerType2& y);
+template< class ContainerType1, class ContainerType2>
+inline std::vector<int64_t> doMultiDot_superacc( const ContainerType1& x, const std::vector<const ContainerType2*>& ys);
 //we need to distinguish between Scalars and Vectors
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +77,47 @@ std::vector<int64_t> doDot_superacc( const Vector1& x, const Vector2& y, SharedV
             do_get_pointer_or_reference(y, get_tensor_category<Vector2>()));
 }
 
+//one superaccumulator per y, concatenated; there is no communication here
+template< class Vector1, class Vector2>
+std::vector<int64_t> doMultiDot_superacc( const Vector1& x, const std::vector<const Vector2*>& ys, SharedVectorTag)
+{
+    std::vector<int64_t> acc( ys.size()*exblas::BIN_COUNT);
+    for( unsigned i=0; i<ys.size(); i++)
+    {
+        std::vector<int64_t> temp = doDot_superacc( x, *ys[i], SharedVectorTag());
+        std::copy( temp.begin(), temp.end(), acc.begin() + i*exblas::BIN_COUNT);
+    }
+    return acc;
+}
+
+//no broadcasts: one loop over all elements
+template< unsigned vector_idx, class ExecutionPolicy, class Subroutine, class ContainerType, class ...ContainerTypes>
+inline void doSubroutine_shared( std::false_type, std::integral_constant<unsigned, vector_idx>, ExecutionPolicy, Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
+{
+    doSubroutine_dispatch(
+            ExecutionPolicy(),
+            get_idx<vector_idx>( std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...).size(),
+            f,
+            do_get_pointer_or_reference(std::forward<ContainerType>(x),get_tensor_category<ContainerType>()) ,
+            do_get_pointer_or_reference(std::forward<ContainerTypes>(xs),get_tensor_category<ContainerTypes>()) ...
+            );
+}
+//at least one broadcast: loop plane by plane
+template< unsigned broadcast_idx, class ExecutionPolicy, class Subroutine, class ContainerType, class ...ContainerTypes>
+inline void doSubroutine_shared( std::true_type, std::integral_constant<unsigned, broadcast_idx>, ExecutionPolicy, Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
+{
+    const auto& broadcast = get_idx<broadcast_idx>( std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...);
+    const int size = broadcast.plane().size(), planes = broadcast.planes();
+    if( size == 0 || planes == 0)
+        return;
+    doSubroutine_planes_dispatch(
+            ExecutionPolicy(), planes, size,
+            f,
+            do_get_pointer_or_reference(std::forward<ContainerType>(x),get_tensor_category<ContainerType>()) ,
+            do_get_pointer_or_reference(std::forward<ContainerTypes>(xs),get_tensor_category<ContainerTypes>()) ...
+            );
+}
+
 template< class Subroutine, class ContainerType, class ...ContainerTypes>
 inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, ContainerTypes&&... xs)
 {
@@ -90,13 +135,11 @@ inline void doSubroutine( SharedVectorTag, Subroutine f, ContainerType&& x, Cont
             >::value,
         "All ContainerType types must have compatible execution policies (AnyPolicy or Same)!");
     constexpr unsigned vector_idx = find_if_v<dg::is_not_scalar_has_not_any_policy, get_value_type<ContainerType>, ContainerType, ContainerTypes...>::value;
-    doSubroutine_dispatch(
+    constexpr unsigned broadcast_idx = find_if_v<dg::is_broadcast, get_value_type<ContainerType>, ContainerType, ContainerTypes...>::value;
+    doSubroutine_shared( std::integral_constant<bool, (broadcast_idx <= sizeof...(ContainerTypes))>(),
+            std::integral_constant<unsigned, (broadcast_idx <= sizeof...(ContainerTypes) ? broadcast_idx : vector_idx)>(),
             get_execution_policy<vector_type>(),
-            get_idx<vector_idx>( std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...).size(),
-            f,
-            do_get_pointer_or_reference(std::forward<ContainerType>(x),get_tensor_category<ContainerType>()) ,
-            do_get_pointer_or_reference(std::forward<ContainerTypes>(xs),get_tensor_category<ContainerTypes>()) ...
-            );
+            f, std::forward<ContainerType>(x), std::forward<ContainerTypes>(xs)...);
 }
 
 template<class T, class ContainerType, class BinaryOp>
@@ -104,6 +147,15 @@ inline T doReduce( SharedVectorTag, const ContainerType& x, T init, BinaryOp op)
 {
     return doReduce_dispatch( get_execution_policy<ContainerType>(), x.size(), thrust::raw_pointer_cast( x.data()), init, op);
 }
+template<class T, class ContainerType, class BinaryOp>
+inline T doReduce( BroadcastVectorTag, const ContainerType& x, T init, BinaryOp op)
+{
+    //op is associative and commutative so we can reduce plane by plane
+    for( unsigned k=0; k<x.planes(); k++)
+        init = doReduce_dispatch( get_execution_policy<ContainerType>(),
+            x.plane().size(), thrust::raw_pointer_cast( x.plane().data()), init, op);
+    return init;
+}
 
 } //namespace detail
 } //namespace blas1
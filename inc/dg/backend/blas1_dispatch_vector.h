@@ -155,6 +155,33 @@ inline std::vector<int64_t> doDot_superacc( const Vector1& x1, const Vector2& x2
     }
     return acc;
 }
+
+template< class Vector1, class Vector2>
+inline std::vector<int64_t> doMultiDot_superacc( const Vector1& x, const std::vector<const Vector2*>& ys, RecursiveVectorTag)
+{
+    using inner_type = std::decay_t<decltype( (*ys[0])[0])>;
+    std::vector<int64_t> acc( ys.size()*exblas::BIN_COUNT, (int64_t)0);
+    std::vector<const inner_type*> inner( ys.size());
+    for( unsigned i=0; i<x.size(); i++)
+    {
+        for( unsigned k=0; k<ys.size(); k++)
+            inner[k] = &(*ys[k])[i];
+        std::vector<int64_t> temp = doMultiDot_superacc( x[i], inner);
+        for( unsigned k=0; k<ys.size(); k++)
+        {
+            int imin = exblas::IMIN, imax = exblas::IMAX;
+            exblas::cpu::Normalize( &(temp[k*exblas::BIN_COUNT]), imin, imax);
+            for( int l=exblas::IMIN; l<=exblas::IMAX; l++)
+                acc[k*exblas::BIN_COUNT+l] += temp[k*exblas::BIN_COUNT+l];
+            if( (i+1)%128 == 0)
+            {
+                imin = exblas::IMIN, imax = exblas::IMAX;
+                exblas::cpu::Normalize( &(acc[k*exblas::BIN_COUNT]), imin, imax);
+            }
+        }
+    }
+    return acc;
+}
 /////////////////////////////////////////////////////////////////////////////////////
 #ifdef _OPENMP
 //omp tag implementation
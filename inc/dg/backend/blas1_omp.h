@@ -68,6 +68,35 @@ inline void doSubroutine_dispatch( OmpTag, int size, Subroutine f, PointerOrValu
         doSubroutine_dispatch( SerialTag(), size, f, x, xs...);
 }
 
+template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
+inline void doSubroutine_planes_omp( int planes, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    //planes are disjoint so no barrier is needed in between
+    for( int k=0; k<planes; k++)
+        doSubroutine_omp( size, f, dg::detail::get_plane( x, k*size),
+            dg::detail::get_plane( xs, k*size)...);
+}
+
+//size is the size of one plane
+template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
+inline void doSubroutine_planes_dispatch( OmpTag, int planes, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    if(omp_in_parallel())
+    {
+        doSubroutine_planes_omp( planes, size, f, x, xs... );
+        return;
+    }
+    if(planes*size>MIN_SIZE)
+    {
+        #pragma omp parallel
+        {
+            doSubroutine_planes_omp( planes, size, f, x, xs...);
+        }
+    }
+    else
+        doSubroutine_planes_dispatch( SerialTag(), planes, size, f, x, xs...);
+}
+
 template<class T, class Pointer, class BinaryOp>
 inline T doReduce_dispatch( OmpTag, int size, Pointer x, T init, BinaryOp op)
 {
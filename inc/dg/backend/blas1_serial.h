@@ -4,6 +4,7 @@
 #include "exceptions.h"
 #include "execution_policy.h"
 #include "exblas/exdot_serial.h"
+#include "broadcast.h"
 
 namespace dg
 {
@@ -49,6 +50,15 @@ inline void doSubroutine_dispatch( SerialTag, int size, Subroutine f, PointerOrV
     }
 }
 
+//size is the size of one plane
+template< class Subroutine, class PointerOrValue, class ...PointerOrValues>
+inline void doSubroutine_planes_dispatch( SerialTag, int planes, int size, Subroutine f, PointerOrValue x, PointerOrValues... xs)
+{
+    for( int k=0; k<planes; k++)
+        doSubroutine_dispatch( SerialTag(), size, f, dg::detail::get_plane( x, k*size),
+            dg::detail::get_plane( xs, k*size)...);
+}
+
 template<class T, class Pointer, class BinaryOp>
 inline T doReduce_dispatch( SerialTag, int size, Pointer x, T init, BinaryOp op)
 {
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <thrust/memory.h>
+#include "exblas/config.h"
+#include "tensor_traits.h"
+#include "vector_categories.h"
+
+namespace dg
+{
+
+///@cond
+namespace detail
+{
+//A pointer to one plane that is indexed modulo the plane size
+template<class T>
+struct BroadcastPointer
+{
+    T* ptr;
+    int size;
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    T& operator[]( int i) const { return ptr[i%size];}
+};
+
+//The element access functions are found via argument dependent lookup
+//from dg::blas1::detail and dg::exblas
+template<class T>
+#ifdef __CUDACC__
+__host__ __device__
+#endif
+inline T& get_element( BroadcastPointer<T> x, int i){
+    return x[i];
+}
+#ifdef __CUDACC__
+template<class T>
+__device__
+inline T& get_device_element( BroadcastPointer<T> x, int i){
+    return x[i];
+}
+#endif //__CUDACC__
+#ifndef _WITHOUT_VCL
+template<class T>
+inline vcl::Vec8d make_vcl_vec8d( BroadcastPointer<T> x, int i, int num = 8){
+    double tmp[8];
+    for(int j=0; j<num; j++)
+        tmp[j] = (double)x[i+j];
+    return vcl::Vec8d().load_partial( num, tmp);
+}
+#endif//_WITHOUT_VCL
+
+//The part of a pointer or value that belongs to the plane starting at offset
+//Broadcasts resolve to their plane data, so the blas1 kernels can index
+//plane by plane without a modulo per element
+template<class T>
+#ifdef __CUDACC__
+__host__ __device__
+#endif
+inline T get_plane( T x, int offset){
+    return x;
+}
+template<class T>
+#ifdef __CUDACC__
+__host__ __device__
+#endif
+inline T* get_plane( T* x, int offset){
+    return x + offset;
+}
+template<class T>
+#ifdef __CUDACC__
+__host__ __device__
+#endif
+inline T* get_plane( BroadcastPointer<T> x, int offset){
+    return x.ptr;
+}
+}//namespace detail
+namespace exblas
+{
+template<class T>
+struct ValueTraits<dg::detail::BroadcastPointer<T>>
+{
+    using value_type = std::remove_const_t<T>;
+};
+}//namespace exblas
+///@endcond
+
+/**
+ * @brief A read-only vector that stores one plane and broadcasts it to all planes of a 3d vector
+ *
+ * @ingroup view
+ * Many 3d vectors are axisymmetric, i.e. the same 2d data is repeated in
+ * every plane (for example magnetic field quantities or the metric of a
+ * product geometry). A \c PlaneBroadcast stores only one plane and is
+ * indexed modulo the plane size, so it can be used in place of such a 3d
+ * container in any \c dg::blas1 function and as the diagonal matrix or the
+ * weights in \c dg::blas2::symv and \c dg::blas2::dot, as long as it is only read.
+ * This saves the memory and the memory bandwidth of the Nz-1 copies.
+ * The \c dg::blas1 kernels run plane by plane if one of their arguments is a
+ * broadcast, so elements are not indexed with a modulo operation.
+ * @code
+dg::DVec bphi2d = dg::pullback( bphi, g2d); // 2d data
+dg::PlaneBroadcast<dg::DVec> bphi3d( bphi2d, g3d.Nz()); // no copy to 3d
+dg::blas1::pointwiseDot( bphi3d, f, f); // f is a 3d vector on g3d
+ * @endcode
+ * @note For MPI use \c dg::MPI_Vector<dg::PlaneBroadcast<Container>>
+ * with the local plane of the 3d communicator
+ * @note cannot be used in \c dg::construct or \c dg::assign and cannot be
+ * written to
+ * @tparam ThrustVector \c TensorTraits exists for this class and the
+ * \c tensor_category derives from \c ThrustVectorTag
+ */
+template<class ThrustVector>
+struct PlaneBroadcast
+{
+    using container_type = ThrustVector;
+    using value_type = get_value_type<ThrustVector>;
+    ///@brief Initialize empty
+    PlaneBroadcast() = default;
+    /**
+     * @brief Construct from the data of one plane
+     *
+     * @param plane the data of one plane
+     * @param planes the number of planes to broadcast to
+     */
+    PlaneBroadcast( const ThrustVector& plane, unsigned planes): m_plane(plane), m_planes(planes){}
+    /**
+     * @brief Set plane data and number of planes
+     *
+     * @param plane the data of one plane
+     * @param planes the number of planes to broadcast to
+     */
+    void construct( const ThrustVector& plane, unsigned planes){
+        m_plane = plane;
+        m_planes = planes;
+    }
+    ///@brief Read access to the data of one plane
+    const ThrustVector& plane() const{ return m_plane;}
+    ///@brief Write access to the data of one plane (changes all planes)
+    ThrustVector& plane() { return m_plane;}
+    ///@brief Number of planes
+    unsigned planes() const{ return m_planes;}
+    ///@brief The apparent size, i.e. \c planes()*plane().size()
+    unsigned size() const{ return m_planes*m_plane.size();}
+    ///@brief Pointer to the plane data
+    auto data() const{ return m_plane.data();}
+    ///@brief Swap with another broadcast
+    void swap( PlaneBroadcast& src){
+        m_plane.swap( src.m_plane);
+        std::swap( m_planes, src.m_planes);
+    }
+    private:
+    ThrustVector m_plane;
+    unsigned m_planes = 0;
+};
+
+/**
+ * @brief A PlaneBroadcast has identical value_type and execution_policy as the underlying container
+ * @ingroup dispatch
+ */
+template<class ThrustVector>
+struct TensorTraits< PlaneBroadcast<ThrustVector>>
+{
+    using value_type = get_value_type<ThrustVector>;
+    using tensor_category = BroadcastVectorTag;
+    using execution_policy = get_execution_policy<ThrustVector>;
+};
+
+///@cond
+template< class T>
+using is_broadcast = std::conditional_t< std::is_base_of<BroadcastVectorTag, get_tensor_category<T>>::value, std::true_type, std::false_type>;
+
+template<class T>
+inline detail::BroadcastPointer<const get_value_type<T>> do_get_pointer_or_reference( T&& v, BroadcastVectorTag)
+{
+    return { thrust::raw_pointer_cast(v.plane().data()), (int)v.plane().size()};
+}
+///@endcond
+
+}//namespace dg
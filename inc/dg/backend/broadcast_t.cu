@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "broadcast.h"
+#include "typedefs.h"
+#include "../blas1.h"
+
+
+int main()
+{
+    unsigned size = 100, planes = 4;
+    thrust::host_vector<double> plane( size);
+    for( unsigned i=0; i<size; i++)
+        plane[i] = (double)i/(double)size;
+    thrust::host_vector<double> full( planes*size);
+    for( unsigned k=0; k<planes; k++)
+        for( unsigned i=0; i<size; i++)
+            full[k*size+i] = plane[i];
+
+    dg::PlaneBroadcast<thrust::host_vector<double>> broadcast( plane, planes);
+    std::cout << "Apparent size is "<<broadcast.size()<<" ("<<planes*size<<")\n";
+    thrust::host_vector<double> result( planes*size);
+    dg::blas1::copy( broadcast, result);
+    dg::blas1::axpby( 1., full, -1., result);
+    std::cout << "Difference in copy           "<<dg::blas1::dot( result, result)<<" (0)\n";
+    dg::blas1::pointwiseDot( broadcast, full, result);
+    dg::blas1::pointwiseDot( -1., full, full, 1., result);
+    std::cout << "Difference in pointwiseDot   "<<dg::blas1::dot( result, result)<<" (0)\n";
+    dg::blas1::axpbypgz( 1., full, -1., broadcast, 0., result);
+    std::cout << "Difference in axpbypgz       "<<dg::blas1::dot( result, result)<<" (0)\n";
+    std::cout << "Difference in dot            "<<dg::blas1::dot( broadcast, full) - dg::blas1::dot( full, full)<<" (0)\n";
+    std::cout << "Difference in reduce         "<<dg::blas1::reduce( broadcast, 0., thrust::plus<double>()) - dg::blas1::reduce( full, 0., thrust::plus<double>())<<" (0)\n";
+    dg::blas1::scal( broadcast.plane(), 2.);
+    dg::blas1::copy( broadcast, result);
+    std::cout << "Writing to the plane changes "<<result[(planes-1)*size+10]<<" ("<<2.*plane[10]<<")\n";
+
+    return 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <vector>
+#include <memory>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/gather.h>
@@ -24,6 +26,13 @@ namespace dg{
  * to send (or gather from) and connects it to an intermediate "store"
  * In this way gather and scatter are defined with respect to the buffer and
  * the store is the vector.
+ *
+ * At construction the set of processes with which the calling process
+ * actually exchanges data is determined and a distributed graph communicator
+ * (\c MPI_Dist_graph_create_adjacent) is created from it. The scatter and
+ * gather operations then use \c MPI_Neighbor_alltoallv with count arrays of
+ * the size of the neighbourhood only instead of a dense \c MPI_Alltoallv
+ * over the whole communicator, which scales with the total number of processes.
  */
 template<class Index, class Vector>
 struct Collective
@@ -44,22 +53,48 @@ struct Collective
 
     void construct( thrust::host_vector<int> sendTo, MPI_Comm comm){
         //sollte schnell sein
-        thrust::host_vector<int> recvFrom(sendTo), accS(sendTo), accR(sendTo);
+        thrust::host_vector<int> recvFrom(sendTo);
         m_comm=comm;
         int rank, size;
         MPI_Comm_rank( m_comm, &rank);
         MPI_Comm_size( m_comm, &size);
         assert( sendTo.size() == (unsigned)size);
-        thrust::host_vector<unsigned> global( size*size);
-        MPI_Allgather( sendTo.data(), size, MPI_UNSIGNED,
-                       global.data(), size, MPI_UNSIGNED,
-                       m_comm);
-        for( unsigned i=0; i<(unsigned)size; i++)
-            recvFrom[i] = global[i*size+rank];
-        thrust::exclusive_scan( sendTo.begin(),   sendTo.end(),   accS.begin());
-        thrust::exclusive_scan( recvFrom.begin(), recvFrom.end(), accR.begin());
-        m_sendTo=sendTo, m_recvFrom=recvFrom, m_accS=accS, m_accR=accR;
-    
+        //every process only needs to know how much it receives from whom
+        MPI_Alltoall( sendTo.data(), 1, MPI_INT,
+                      recvFrom.data(), 1, MPI_INT,
+                      m_comm);
+        //the neighbourhood is the union of the processes we send to and
+        //receive from; a symmetric graph lets us transpose without a new communicator
+        m_neighbors.clear();
+        for( int i=0; i<size; i++)
+            if( sendTo[i] != 0 || recvFrom[i] != 0)
+                m_neighbors.push_back( i);
+        unsigned degree = m_neighbors.size();
+        m_sendTo.resize( degree), m_recvFrom.resize( degree);
+        for( unsigned i=0; i<degree; i++)
+        {
+            m_sendTo[i]   = sendTo[m_neighbors[i]];
+            m_recvFrom[i] = recvFrom[m_neighbors[i]];
+        }
+        m_accS = m_sendTo, m_accR = m_recvFrom;
+        thrust::exclusive_scan( m_sendTo.begin(),   m_sendTo.end(),   m_accS.begin());
+        thrust::exclusive_scan( m_recvFrom.begin(), m_recvFrom.end(), m_accR.begin());
+        //MPI does not like null pointers for empty arrays
+        int empty = 0;
+        const int* neighbors = degree == 0 ? &empty : m_neighbors.data();
+        //copies share the graph communicator; the last one frees it
+        m_graph.reset( new MPI_Comm( MPI_COMM_NULL), []( MPI_Comm* graph)
+        {
+            int finalized;
+            MPI_Finalized( &finalized);
+            if( !finalized && *graph != MPI_COMM_NULL)
+                MPI_Comm_free( graph);
+            delete graph;
+        });
+        MPI_Dist_graph_create_adjacent( m_comm,
+            degree, neighbors, MPI_UNWEIGHTED,
+            degree, neighbors, MPI_UNWEIGHTED,
+            MPI_INFO_NULL, false, m_graph.get());
     }
     /**
      * @brief Number of processes in the communicator
@@ -71,8 +106,8 @@ struct Collective
     unsigned size() const {return values_size();}
     MPI_Comm comm() const {return m_comm;}
 
-    void transpose(){ m_sendTo.swap( m_recvFrom);}
-    void invert(){ m_sendTo.swap( m_recvFrom);}
+    void transpose(){ m_sendTo.swap( m_recvFrom); m_accS.swap( m_accR);}
+    void invert(){ m_sendTo.swap( m_recvFrom); m_accS.swap( m_accR);}
 
     void scatter( const Vector& values, Vector& store) const;
     void gather( const Vector& store, Vector& values) const;
@@ -87,9 +122,23 @@ struct Collective
         return thrust::reduce( m_sendTo.begin(), m_sendTo.end() );
     }
     MPI_Comm communicator() const{return m_comm;}
+    /**
+     * @brief The ranks (in \c communicator()) with which data is exchanged
+     *
+     * @return list of neighbor ranks in ascending order (may contain the calling rank)
+     */
+    const std::vector<int>& neighbors() const{return m_neighbors;}
     private:
-    unsigned sendTo( unsigned pid) const {return m_sendTo[pid];}
-    unsigned recvFrom( unsigned pid) const {return m_recvFrom[pid];}
+    void alltoallv( const get_value_type<Vector>* send, const int* sendcounts, const int* sdispls,
+            get_value_type<Vector>* recv, const int* recvcounts, const int* rdispls) const
+    {
+        MPI_Neighbor_alltoallv(
+            send, sendcounts, sdispls, getMPIDataType<get_value_type<Vector> >(),
+            recv, recvcounts, rdispls, getMPIDataType<get_value_type<Vector> >(),
+            *m_graph);
+    }
+    //all count and displacement arrays are indexed by position in m_neighbors
+    std::vector<int> m_neighbors;
 #ifdef _DG_CUDA_UNAWARE_MPI
     thrust::host_vector<int> m_sendTo,   m_accS;
     thrust::host_vector<int> m_recvFrom, m_accR;
@@ -101,6 +150,7 @@ struct Collective
     thrust::host_vector<int> m_recvFrom, m_accR; //accumulated recv
 #endif // _DG_CUDA_UNAWARE_MPI
     MPI_Comm m_comm;
+    std::shared_ptr<MPI_Comm> m_graph; //the neighborhood of m_comm
 };
 
 template< class Index, class Device>
@@ -114,22 +164,22 @@ void Collective<Index, Device>::scatter( const Device& values, Device& store) co
 #ifdef _DG_CUDA_UNAWARE_MPI
     m_values.data() = values;
     m_store.data().resize( store.size());
-    MPI_Alltoallv(
+    alltoallv(
             thrust::raw_pointer_cast( m_values.data().data()),
             thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(),
+            thrust::raw_pointer_cast( m_accS.data()),
             thrust::raw_pointer_cast( m_store.data().data()),
             thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+            thrust::raw_pointer_cast( m_accR.data()));
     store = m_store.data();
 #else
-    MPI_Alltoallv(
+    alltoallv(
             thrust::raw_pointer_cast( values.data()),
             thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(),
+            thrust::raw_pointer_cast( m_accS.data()),
             thrust::raw_pointer_cast( store.data()),
             thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+            thrust::raw_pointer_cast( m_accR.data()));
 #endif //_DG_CUDA_UNAWARE_MPI
 }
 
@@ -145,22 +195,22 @@ void Collective<Index, Device>::gather( const Device& gatherFrom, Device& values
 #ifdef _DG_CUDA_UNAWARE_MPI
     m_store.data() = gatherFrom;
     m_values.data().resize( values.size());
-    MPI_Alltoallv(
+    alltoallv(
             thrust::raw_pointer_cast( m_store.data().data()),
             thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(),
+            thrust::raw_pointer_cast( m_accR.data()),
             thrust::raw_pointer_cast( m_values.data().data()),
             thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+            thrust::raw_pointer_cast( m_accS.data()));
     values = m_values.data();
 #else
-    MPI_Alltoallv(
+    alltoallv(
             thrust::raw_pointer_cast( gatherFrom.data()),
             thrust::raw_pointer_cast( m_recvFrom.data()),
-            thrust::raw_pointer_cast( m_accR.data()), getMPIDataType<get_value_type<Device> >(),
+            thrust::raw_pointer_cast( m_accR.data()),
             thrust::raw_pointer_cast( values.data()),
             thrust::raw_pointer_cast( m_sendTo.data()),
-            thrust::raw_pointer_cast( m_accS.data()), getMPIDataType<get_value_type<Device> >(), m_comm);
+            thrust::raw_pointer_cast( m_accS.data()));
 #endif //_DG_CUDA_UNAWARE_MPI
 }
 //BijectiveComm ist der Spezialfall, dass jedes Element nur ein einziges Mal gebraucht wird.
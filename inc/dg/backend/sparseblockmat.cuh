@@ -1,12 +1,45 @@
 #pragma once
 
+#include <algorithm>
 #include <thrust/device_vector.h>
 //#include <cusp/system/cuda/utils.h>
 #include "sparseblockmat.h"
+#include "predicate.h"
 
 namespace dg
 {
 
+///@cond
+//The index arrays of an EllSparseBlockMatDevice as seen by the kernels
+//Rows in [begin, end) follow the stencil pattern, i.e. the column of block d
+//in row i is i+offset[d] and its data index is block[d]; all other rows
+//are stored explicitly in cols_idx and data_idx
+struct EllStencilIndex
+{
+    const int* cols_idx;
+    const int* data_idx;
+    const int* offset;
+    const int* block;
+    int begin, end;
+    int blocks_per_line;
+#ifdef __CUDACC__
+    __host__ __device__
+#endif
+    void operator()( int i, int d, int& col, int& data) const
+    {
+        if( i >= begin && i < end)
+        {
+            col = i + offset[d];
+            data = block[d];
+            return;
+        }
+        int ii = i < begin ? i : i - (end - begin);
+        col  = cols_idx[ii*blocks_per_line+d];
+        data = data_idx[ii*blocks_per_line+d];
+    }
+};
+///@endcond
+
 /**
 * @brief Ell Sparse Block Matrix format device version
 *
@@ -15,6 +48,13 @@ namespace dg
 be gpu or omp depending on the THRUST_DEVICE_SYSTEM macro. It can be applied
 to device vectors and does the same thing as the host version
 
+In derivatives and jumps all interior rows follow the same stencil pattern,
+i.e. the column indices are the row index plus a constant offset and the data
+indices are the same in each row. On construction the largest range of rows
+around the center that follows such a pattern is detected. Only the offsets
+and blocks of that pattern and the remaining (boundary) rows are stored, so
+the kernels do not need to load indices in the interior.
+
 @copydetails EllSparseBlockMat
 */
 template<class value_type>
@@ -31,10 +71,42 @@ struct EllSparseBlockMatDevice
     EllSparseBlockMatDevice( const EllSparseBlockMat<value_type>& src)
     {
         data = src.data;
-        cols_idx = src.cols_idx, data_idx = src.data_idx;
         num_rows = src.num_rows, num_cols = src.num_cols, blocks_per_line = src.blocks_per_line;
         n = src.n, left_size = src.left_size, right_size = src.right_size;
         right_range = src.right_range;
+        //find the stencil pattern of the center row and how far it reaches
+        const int bpl = blocks_per_line;
+        thrust::host_vector<int> offset( bpl, 0), block( bpl, 0);
+        int begin = num_rows/2, end = num_rows/2;
+        if( num_rows > 0)
+        {
+            for( int d=0; d<bpl; d++)
+            {
+                offset[d] = src.cols_idx[begin*bpl+d] - begin;
+                block[d]  = src.data_idx[begin*bpl+d];
+            }
+            auto is_stencil = [&]( int i) {
+                for( int d=0; d<bpl; d++)
+                    if( src.cols_idx[i*bpl+d] != i + offset[d] ||
+                        src.data_idx[i*bpl+d] != block[d])
+                        return false;
+                return true;
+            };
+            end = begin+1;
+            while( begin > 0 && is_stencil( begin-1))
+                begin--;
+            while( end < num_rows && is_stencil( end))
+                end++;
+        }
+        stencil_begin = begin, stencil_end = end;
+        stencil_offset = offset, stencil_block = block;
+        //store only the rows outside the stencil range
+        thrust::host_vector<int> cols( (num_rows-(end-begin))*bpl), blocks( cols.size());
+        std::copy( src.cols_idx.begin(), src.cols_idx.begin() + begin*bpl, cols.begin());
+        std::copy( src.cols_idx.begin() + end*bpl, src.cols_idx.begin() + num_rows*bpl, cols.begin() + begin*bpl);
+        std::copy( src.data_idx.begin(), src.data_idx.begin() + begin*bpl, blocks.begin());
+        std::copy( src.data_idx.begin() + end*bpl, src.data_idx.begin() + num_rows*bpl, blocks.begin() + begin*bpl);
+        cols_idx = cols, data_idx = blocks;
     }
     /**
     * @brief Display internal data to a stream
@@ -63,13 +135,23 @@ struct EllSparseBlockMatDevice
     void symv(SharedVectorTag, OmpTag, value_type alpha, const value_type* x, value_type beta, value_type* y) const;
 #endif //_OPENMP
     void launch_multiply_kernel(value_type alpha, const value_type* x, value_type beta, value_type* y) const;
+    ///@brief The index arrays as seen by the kernels
+    EllStencilIndex stencil_index() const{
+        return { thrust::raw_pointer_cast( cols_idx.data()),
+            thrust::raw_pointer_cast( data_idx.data()),
+            thrust::raw_pointer_cast( stencil_offset.data()),
+            thrust::raw_pointer_cast( stencil_block.data()),
+            stencil_begin, stencil_end, blocks_per_line};
+    }
 
     thrust::device_vector<value_type> data;
-    thrust::device_vector<int> cols_idx, data_idx;
+    thrust::device_vector<int> cols_idx, data_idx; // only rows outside [stencil_begin, stencil_end)
+    thrust::device_vector<int> stencil_offset, stencil_block; // column offsets and data indices of the interior rows
     thrust::device_vector<int> right_range; // behold that right_size != right_range[1]-right_range[0] in general
     int num_rows, num_cols, blocks_per_line;
     int n;
     int left_size, right_size;
+    int stencil_begin, stencil_end; // the interior rows that follow the stencil pattern
 };
 
 
@@ -193,15 +275,23 @@ void EllSparseBlockMatDevice<value_type>::display( std::ostream& os) const
     os << "right_size            "<<right_size<<"\n";
     os << "right_range_0         "<<right_range[0]<<"\n";
     os << "right_range_1         "<<right_range[1]<<"\n";
-    os << " Columns: \n";
-    for( int i=0; i<num_rows; i++)
+    os << "stencil_begin         "<<stencil_begin<<"\n";
+    os << "stencil_end           "<<stencil_end<<"\n";
+    os << "Stencil offsets: ";
+    for( int d=0; d<blocks_per_line; d++)
+        os << stencil_offset[d] <<" ";
+    os << "\nStencil blocks:  ";
+    for( int d=0; d<blocks_per_line; d++)
+        os << stencil_block[d] <<" ";
+    os << "\n Columns (boundary rows): \n";
+    for( int i=0; i<(int)cols_idx.size()/blocks_per_line; i++)
     {
         for( int d=0; d<blocks_per_line; d++)
             os << cols_idx[i*blocks_per_line + d] <<" ";
         os << "\n";
     }
-    os << "\n Data: \n";
-    for( int i=0; i<num_rows; i++)
+    os << "\n Data (boundary rows): \n";
+    for( int i=0; i<(int)data_idx.size()/blocks_per_line; i++)
     {
         for( int d=0; d<blocks_per_line; d++)
             os << data_idx[i*blocks_per_line + d] <<" ";
@@ -233,6 +323,63 @@ void CooSparseBlockMatDevice<value_type>::display( std::ostream& os) const
 
 }
 
+///@endcond
+///@cond
+namespace detail
+{
+template<class Matrix>
+struct is_ell_matrix : std::false_type{};
+template<class T>
+struct is_ell_matrix<EllSparseBlockMat<T>> : std::true_type{};
+template<class T>
+struct is_ell_matrix<EllSparseBlockMatDevice<T>> : std::true_type{};
+
+template<class Container>
+using is_host_thrust_vector = std::integral_constant<bool,
+    std::is_base_of<ThrustVectorTag, get_tensor_category<Container>>::value &&
+    ( std::is_same<get_execution_policy<Container>, SerialTag>::value ||
+      std::is_same<get_execution_policy<Container>, OmpTag>::value)>;
+//fused derivative kernels (e.g. in ArakawaX and Advection) exist for
+//Ell matrices and contiguous vectors on the host
+template<class Matrix, class ...Containers>
+using is_ell_fusable = std::integral_constant<bool,
+    is_ell_matrix<Matrix>::value &&
+    dg::all_true<is_host_thrust_vector<std::decay_t<Containers>>::value...>::value>;
+
+template<class T>
+EllStencilIndex ell_index( const EllSparseBlockMat<T>& m)
+{
+    return { thrust::raw_pointer_cast( m.cols_idx.data()),
+        thrust::raw_pointer_cast( m.data_idx.data()), nullptr, nullptr, 0, 0,
+        m.blocks_per_line};
+}
+template<class T>
+EllStencilIndex ell_index( const EllSparseBlockMatDevice<T>& m)
+{
+    return m.stencil_index();
+}
+
+//check that dx and dy are the derivatives of a (stack of) 2d grid(s)
+template<class Matrix>
+bool ell_fusable_2d( const Matrix& dx, const Matrix& dy, std::true_type)
+{
+    return dx.n == dy.n && dx.num_rows == dx.num_cols && dy.num_rows == dy.num_cols
+        && dx.right_size == 1 && dy.right_size == dx.num_rows*dx.n
+        && dx.left_size == dy.left_size*dy.num_rows*dy.n
+        && dx.right_range[0] == 0 && dx.right_range[1] == 1
+        && dy.right_range[0] == 0 && dy.right_range[1] == dy.right_size;
+}
+template<class Matrix>
+bool ell_fusable_2d( const Matrix& dx, const Matrix& dy, std::false_type)
+{
+    return false;
+}
+template<class Matrix>
+bool ell_fusable_2d( const Matrix& dx, const Matrix& dy)
+{
+    return ell_fusable_2d( dx, dy, is_ell_matrix<Matrix>());
+}
+}//namespace detail
 ///@endcond
 ///@addtogroup dispatch
 ///@{
@@ -6,8 +6,7 @@ namespace dg
 // general multiply kernel
 template<class value_type>
  __global__ void ell_multiply_kernel( value_type alpha, value_type beta,
-         const value_type* __restrict__  data,
-         const int* __restrict__  cols_idx, const int* __restrict__  data_idx,
+         const value_type* __restrict__  data, const EllStencilIndex stencil,
          const int num_rows, const int num_cols, const int blocks_per_line,
          const int n, const int size,
          const int right_size,
@@ -32,8 +31,10 @@ template<class value_type>
         for( int d=0; d<blocks_per_line; d++)
         {
             value_type temp=0;
-            int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-            int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+            int col, D;
+            stencil( i, d, col, D);
+            int B = (D*n+k)*n;
+            int J = (s*num_cols+col)*n;
             for( int q=0; q<n; q++) //multiplication-loop
                 temp =fma( data[ B+q], x[(J+q)*right_size+j], temp);
             y[idx]=fma( alpha, temp, y[idx]);
@@ -46,8 +47,7 @@ template<class value_type>
 //specialized multiply kernel
 template<class value_type, size_t n, size_t blocks_per_line>
  __global__ void ell_multiply_kernel(value_type alpha, value_type beta,
-         const value_type* __restrict__  data,
-         const int* __restrict__  cols_idx, const int* __restrict__  data_idx,
+         const value_type* __restrict__  data, const EllStencilIndex stencil,
          const int num_rows, const int num_cols,
          const int size, const int right_size,
          const int* __restrict__  right_range,
@@ -68,8 +68,10 @@ template<class value_type, size_t n, size_t blocks_per_line>
             int s=rrn/num_rows, i = (rrn)%num_rows;
             for( int d=0; d<blocks_per_line; d++)
             {
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+                int col, D;
+                stencil( i, d, col, D);
+                int B = (D*n+k)*n;
+                int J = (s*num_cols+col)*n;
                 for( int q=0; q<n; q++) //multiplication-loop
                     temp[d] = fma( data[ B+q], x[(J+q)], temp[d]);
             }
@@ -85,8 +87,10 @@ template<class value_type, size_t n, size_t blocks_per_line>
             int j=right_range[0]+row%right_;
             for( int d=0; d<blocks_per_line; d++)
             {
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+                int col, D;
+                stencil( i, d, col, D);
+                int B = (D*n+k)*n;
+                int J = (s*num_cols+col)*n;
                 for( int q=0; q<n; q++) //multiplication-loop
                     temp[d] = fma( data[ B+q], x[(J+q)*right_size+j], temp[d]);
             }
@@ -101,8 +105,7 @@ template<class value_type, size_t n, size_t blocks_per_line>
 
 template<class value_type, size_t n>
 void call_ell_multiply_kernel( value_type alpha, value_type beta,
-         const value_type * __restrict__ data_ptr,
-         const int * __restrict__ cols_ptr, const int * __restrict__ block_ptr,
+         const value_type * __restrict__ data_ptr, const EllStencilIndex stencil,
          const int num_rows, const int num_cols, const int blocks_per_line,
          const int left_size, const int right_size,
          const int * __restrict__ right_range_ptr,
@@ -115,23 +118,23 @@ void call_ell_multiply_kernel( value_type alpha, value_type beta,
     //note that the following use size instead of left_size
     if( blocks_per_line == 1)
         ell_multiply_kernel<value_type, n, 1><<<NUM_BLOCKS, BLOCK_SIZE>>>
-        (alpha, beta, data_ptr, cols_ptr, block_ptr, num_rows, num_cols, size,
+        (alpha, beta, data_ptr, stencil, num_rows, num_cols, size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 2)
         ell_multiply_kernel<value_type, n, 2><<<NUM_BLOCKS, BLOCK_SIZE>>>
-        (alpha, beta, data_ptr, cols_ptr, block_ptr, num_rows, num_cols, size,
+        (alpha, beta, data_ptr, stencil, num_rows, num_cols, size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 3)
         ell_multiply_kernel<value_type, n, 3><<<NUM_BLOCKS, BLOCK_SIZE>>>
-        (alpha, beta, data_ptr, cols_ptr, block_ptr, num_rows, num_cols, size,
+        (alpha, beta, data_ptr, stencil, num_rows, num_cols, size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 4)
         ell_multiply_kernel<value_type, n, 4><<<NUM_BLOCKS, BLOCK_SIZE>>>
-        (alpha, beta, data_ptr, cols_ptr, block_ptr, num_rows, num_cols, size,
+        (alpha, beta, data_ptr, stencil, num_rows, num_cols, size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else
         ell_multiply_kernel<value_type><<<NUM_BLOCKS, BLOCK_SIZE>>>
-        (alpha, beta, data_ptr, cols_ptr, block_ptr, num_rows, num_cols,
+        (alpha, beta, data_ptr, stencil, num_rows, num_cols,
         blocks_per_line, n, size, right_size, right_range_ptr,  x_ptr,y_ptr);
 }
 
@@ -139,33 +142,34 @@ void call_ell_multiply_kernel( value_type alpha, value_type beta,
 template<class value_type>
 void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alpha, const value_type* x_ptr, value_type beta, value_type* y_ptr) const
 {
+    if( num_rows == 0)
+        return;
     const value_type* data_ptr = thrust::raw_pointer_cast( &data[0]);
-    const int* cols_ptr = thrust::raw_pointer_cast( &cols_idx[0]);
-    const int* block_ptr = thrust::raw_pointer_cast( &data_idx[0]);
+    const EllStencilIndex stencil = stencil_index();
     const int* right_range_ptr = thrust::raw_pointer_cast( &right_range[0]);
     if( n == 1)
         call_ell_multiply_kernel<value_type, 1>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 2)
         call_ell_multiply_kernel<value_type, 2>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 3)
         call_ell_multiply_kernel<value_type, 3>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 4)
         call_ell_multiply_kernel<value_type, 4>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 5)
         call_ell_multiply_kernel<value_type, 5>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 6)
         call_ell_multiply_kernel<value_type, 6>  (alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             left_size, right_size, right_range_ptr,  x_ptr,y_ptr);
     else
     {
@@ -174,7 +178,7 @@ void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alp
         const size_t size = left_size*right_size*num_rows*n; //number of lines
         const size_t NUM_BLOCKS = std::min<size_t>((size-1)/BLOCK_SIZE+1, 65000);
         ell_multiply_kernel<value_type><<<NUM_BLOCKS, BLOCK_SIZE>>>( alpha, beta,
-            data_ptr, cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line,
+            data_ptr, stencil, num_rows, num_cols, blocks_per_line,
             n, size, right_size, right_range_ptr,  x_ptr,y_ptr);
     }
 }
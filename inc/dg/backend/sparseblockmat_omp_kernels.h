@@ -8,8 +8,7 @@ namespace dg{
 // general multiply kernel
 template<class value_type>
 void ell_multiply_kernel( value_type alpha, value_type beta,
-         const value_type * RESTRICT data, const int * RESTRICT cols_idx,
-         const int * RESTRICT data_idx,
+         const value_type * RESTRICT data, const EllStencilIndex stencil,
          const int num_rows, const int num_cols, const int blocks_per_line,
          const int n,
          const int left_size, const int right_size,
@@ -24,11 +23,17 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
 		int i = si % num_rows;
 #ifdef _MSC_VER //MSVC does not support variable lenght arrays...
 		int* J = (int*)alloca(blocks_per_line * sizeof(int));
+		int* D = (int*)alloca(blocks_per_line * sizeof(int));
 #else
         int J[blocks_per_line];
+        int D[blocks_per_line];
 #endif
         for( int d=0; d<blocks_per_line; d++)
-            J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
+        {
+            int col;
+            stencil( i, d, col, D[d]);
+            J[d] = (s*num_cols+col)*n;
+        }
         for( int k=0; k<n; k++)
         {
 #ifdef _MSC_VER
@@ -37,7 +42,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
             int B[blocks_per_line];
 #endif
             for( int d=0; d<blocks_per_line; d++)
-                B[d] = (data_idx[i*blocks_per_line+d]*n+k)*n;
+                B[d] = (D[d]*n+k)*n;
             for( int j=right_range[0]; j<right_range[1]; j++)
             {
                 int I = ((s*num_rows + i)*n+k)*right_size+j;
@@ -55,69 +60,75 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
         }
     }
 }
+//one row of the specialized kernel for right_size==1 (used for boundary rows)
+template<class value_type, int n, int blocks_per_line>
+inline void ell_multiply_row( value_type alpha, value_type beta,
+         const value_type * RESTRICT data, const EllStencilIndex& stencil,
+         const int s, const int i, const int num_rows, const int num_cols,
+         const value_type * RESTRICT x, value_type * RESTRICT y
+         )
+{
+    value_type xprivate[blocks_per_line*n];
+    int D[blocks_per_line];
+    for( int d=0; d<blocks_per_line; d++)
+    {
+        int col;
+        stencil( i, d, col, D[d]);
+        int J = (s*num_cols+col)*n;
+        for(int q=0; q<n; q++)
+            xprivate[d*n+q] = x[J+q];
+    }
+    for( int k=0; k<n; k++)
+    {
+        value_type temp[blocks_per_line] = {0};
+        for( int d=0; d<blocks_per_line; d++)
+        {
+            int B = (D[d]*n+k)*n;
+            for( int q=0; q<n; q++) //multiplication-loop
+                temp[d] = DG_FMA(data[B+q], xprivate[d*n+q], temp[d]);
+        }
+        int I = ((s*num_rows + i)*n+k);
+        y[I]*= beta;
+        for( int d=0; d<blocks_per_line; d++)
+            y[I] = DG_FMA(alpha, temp[d], y[I]);
+    }
+}
 //specialized multiply kernel
 template<class value_type, int n, int blocks_per_line>
 void ell_multiply_kernel( value_type alpha, value_type beta,
-         const value_type * RESTRICT data, const int * RESTRICT cols_idx,
-         const int * RESTRICT data_idx,
+         const value_type * RESTRICT data, const EllStencilIndex stencil,
          const int num_rows, const int num_cols,
          const int left_size, const int right_size,
          const int * RESTRICT right_range,
          const value_type * RESTRICT x, value_type * RESTRICT y
          )
 {
+    //the stencil pattern of the interior rows is kept in registers
+    int offset[blocks_per_line];
+    for( int d=0; d<blocks_per_line; d++)
+        offset[d] = stencil.offset[d];
     //basically we check which direction is the largest and parallelize that one
     if(right_size==1)
     {
-    //trivial means that the data blocks do not change among rows
-    bool trivial = true;
-    for( int i=1; i<num_rows-1; i++)
-        for( int d=0; d<blocks_per_line; d++)
-        {
-            if( data_idx[i*blocks_per_line+d]
-                    != data_idx[blocks_per_line+d]) trivial = false;
-        }
-    if(trivial)
-    {
-    value_type xprivate[blocks_per_line*n];
+    //the data blocks do not change among the interior rows
     value_type dprivate[blocks_per_line*n*n];
     for( int d=0; d<blocks_per_line; d++)
     for( int k=0; k<n; k++)
     for( int q=0; q<n; q++)
     {
-        int B = data_idx[blocks_per_line+d];
+        int B = stencil.block[d];
         dprivate[(k*blocks_per_line+d)*n+q] = data[(B*n+k)*n+q];
     }
     #pragma omp for nowait
     for( int s=0; s<left_size; s++)
     {
-        for( int i=0; i<1; i++)
-        {
-            for( int d=0; d<blocks_per_line; d++)
-            {
-                int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                for(int q=0; q<n; q++)
-                    xprivate[d*n+q] = x[J+q];
-            }
-            for( int k=0; k<n; k++)
-            {
-                value_type temp[blocks_per_line] = {0};
-                for( int d=0; d<blocks_per_line; d++)
-                {
-                    int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                    for( int q=0; q<n; q++) //multiplication-loop
-                        temp[d] = DG_FMA(data[B+q], xprivate[d*n+q], temp[d]);
-                }
-                int I = ((s*num_rows + i)*n+k);
-                y[I]*= beta;
-                for( int d=0; d<blocks_per_line; d++)
-                    y[I] = DG_FMA(alpha, temp[d], y[I]);
-            }
-        }
+        for( int i=0; i<stencil.begin; i++)
+            ell_multiply_row<value_type, n, blocks_per_line>( alpha, beta,
+                data, stencil, s, i, num_rows, num_cols, x, y);
         #ifndef _MSC_VER
         #pragma omp SIMD //very important for KNL
         #endif
-        for( int i=1; i<num_rows-1; i++)
+        for( int i=stencil.begin; i<stencil.end; i++)
         {
             for( int k=0; k<n; k++)
             {
@@ -127,69 +138,17 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
                 for( int d=0; d<blocks_per_line; d++)
                 {
                     value_type temp = 0;
+                    int J = (s*num_cols+i+offset[d])*n;
                     for( int q=0; q<n; q++)
-                    {
-                        int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n+q;
-                        temp = DG_FMA( dprivate[B+d*n+q], x[J], temp);
-                    }
+                        temp = DG_FMA( dprivate[B+d*n+q], x[J+q], temp);
                     y[I] = DG_FMA(alpha, temp, y[I]);
                 }
             }
         }
-        for( int i=num_rows-1; i<num_rows; i++)
-        {
-            for( int d=0; d<blocks_per_line; d++)
-            {
-                int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                for(int q=0; q<n; q++)
-                    xprivate[d*n+q] = x[J+q];
-            }
-            for( int k=0; k<n; k++)
-            {
-                value_type temp[blocks_per_line] = {0};
-                for( int d=0; d<blocks_per_line; d++)
-                {
-                    int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                    for( int q=0; q<n; q++) //multiplication-loop
-                        temp[d] = DG_FMA( data[B+q], xprivate[d*n+q], temp[d]);
-                }
-                int I = ((s*num_rows + i)*n+k);
-                y[I]*= beta;
-                for( int d=0; d<blocks_per_line; d++)
-                    y[I] = DG_FMA(alpha, temp[d], y[I]);
-            }
-        }
-    }
-    } //trivial
-    else // not trivial
-    {
-    value_type xprivate[blocks_per_line*n];
-    #pragma omp for nowait
-    for( int s=0; s<left_size; s++)
-    for( int i=0; i<num_rows; i++)
-    {
-        for( int d=0; d<blocks_per_line; d++)
-        {
-            int J = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-            for(int q=0; q<n; q++)
-                xprivate[d*n+q] = x[J+q];
-        }
-        for( int k=0; k<n; k++)
-        {
-            value_type temp[blocks_per_line] = {0};
-            for( int d=0; d<blocks_per_line; d++)
-            {
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
-                for( int q=0; q<n; q++) //multiplication-loop
-                    temp[d] = DG_FMA( data[B+q], xprivate[d*n+q], temp[d]);
-            }
-            int I = ((s*num_rows + i)*n+k);
-            y[I]*= beta;
-            for( int d=0; d<blocks_per_line; d++)
-                y[I] = DG_FMA(alpha, temp[d], y[I]);
-        }
+        for( int i=stencil.end; i<num_rows; i++)
+            ell_multiply_row<value_type, n, blocks_per_line>( alpha, beta,
+                data, stencil, s, i, num_rows, num_cols, x, y);
     }
-    }// trivial
     }// right_size==1
     else // right_size != 1
     {
@@ -206,8 +165,13 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
 
             for( int d=0; d<blocks_per_line; d++)
             {
-                J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
+                int col, D;
+                if( i >= stencil.begin && i < stencil.end)
+                    col = i + offset[d], D = stencil.block[d];
+                else
+                    stencil( i, d, col, D);
+                J[d] = (s*num_cols+col)*n;
+                int B = (D*n+k)*n;
                 for(int q=0; q<n; q++)
                     dprivate[d*n+q] = data[B+q];
             }
@@ -242,8 +206,13 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
 
             for( int d=0; d<blocks_per_line; d++)
             {
-                J[d] = (s*num_cols+cols_idx[i*blocks_per_line+d])*n;
-                int B = (data_idx[i*blocks_per_line+d]*n+k)*n;
+                int col, D;
+                if( i >= stencil.begin && i < stencil.end)
+                    col = i + offset[d], D = stencil.block[d];
+                else
+                    stencil( i, d, col, D);
+                J[d] = (s*num_cols+col)*n;
+                int B = (D*n+k)*n;
                 for(int q=0; q<n; q++)
                     dprivate[d*n+q] = data[B+q];
             }
@@ -270,8 +239,7 @@ void ell_multiply_kernel( value_type alpha, value_type beta,
 
 template<class value_type, int n>
 void call_ell_multiply_kernel( value_type alpha, value_type beta,
-         const value_type * RESTRICT data_ptr, const int * RESTRICT cols_ptr,
-         const int * RESTRICT block_ptr,
+         const value_type * RESTRICT data_ptr, const EllStencilIndex stencil,
          const int num_rows, const int num_cols, const int blocks_per_line,
          const int left_size, const int right_size,
          const int * RESTRICT right_range_ptr,
@@ -279,23 +247,23 @@ void call_ell_multiply_kernel( value_type alpha, value_type beta,
 {
     if( blocks_per_line == 1)
         ell_multiply_kernel<value_type, n, 1>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        stencil, num_rows, num_cols, left_size, right_size,
         right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 2)
         ell_multiply_kernel<value_type, n, 2>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        stencil, num_rows, num_cols, left_size, right_size,
         right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 3)
         ell_multiply_kernel<value_type, n, 3>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        stencil, num_rows, num_cols, left_size, right_size,
         right_range_ptr,  x_ptr,y_ptr);
     else if (blocks_per_line == 4)
         ell_multiply_kernel<value_type, n, 4>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, left_size, right_size,
+        stencil, num_rows, num_cols, left_size, right_size,
         right_range_ptr,  x_ptr,y_ptr);
     else
-        ell_multiply_kernel<value_type>  (alpha, beta, data_ptr, cols_ptr,
-        block_ptr, num_rows, num_cols, blocks_per_line, n, left_size,
+        ell_multiply_kernel<value_type>  (alpha, beta, data_ptr, stencil,
+        num_rows, num_cols, blocks_per_line, n, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
 }
 
@@ -303,34 +271,35 @@ void call_ell_multiply_kernel( value_type alpha, value_type beta,
 template<class value_type>
 void EllSparseBlockMatDevice<value_type>::launch_multiply_kernel( value_type alpha, const value_type* x_ptr, value_type beta, value_type* y_ptr) const
 {
+    if( num_rows == 0)
+        return;
     const value_type* data_ptr = thrust::raw_pointer_cast( &data[0]);
-    const int* cols_ptr = thrust::raw_pointer_cast( &cols_idx[0]);
-    const int* block_ptr = thrust::raw_pointer_cast( &data_idx[0]);
+    const EllStencilIndex stencil = stencil_index();
     const int* right_range_ptr = thrust::raw_pointer_cast( &right_range[0]);
     if( n == 1)
         call_ell_multiply_kernel<value_type, 1>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        stencil, num_rows, num_cols, blocks_per_line, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
 
     else if( n == 2)
         call_ell_multiply_kernel<value_type, 2>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        stencil, num_rows, num_cols, blocks_per_line, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 3)
         call_ell_multiply_kernel<value_type, 3>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        stencil, num_rows, num_cols, blocks_per_line, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 4)
         call_ell_multiply_kernel<value_type, 4>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        stencil, num_rows, num_cols, blocks_per_line, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else if( n == 5)
         call_ell_multiply_kernel<value_type, 5>  (alpha, beta, data_ptr,
-        cols_ptr, block_ptr, num_rows, num_cols, blocks_per_line, left_size,
+        stencil, num_rows, num_cols, blocks_per_line, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
     else
-        ell_multiply_kernel<value_type> ( alpha, beta, data_ptr, cols_ptr,
-        block_ptr, num_rows, num_cols, blocks_per_line, n, left_size,
+        ell_multiply_kernel<value_type> ( alpha, beta, data_ptr, stencil,
+        num_rows, num_cols, blocks_per_line, n, left_size,
         right_size, right_range_ptr,  x_ptr,y_ptr);
 }
 
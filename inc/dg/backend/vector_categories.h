@@ -88,6 +88,16 @@ struct ArrayVectorTag   : public RecursiveVectorTag{}; //!< \c std::array of con
  *  @note \c thrust::host_vector and \c thrust::device_vector meet these requirements
  */
 struct ThrustVectorTag  : public SharedVectorTag {};
+/**
+ * @brief Indicate a read-only vector that repeats the contiguous data of one plane
+ *
+ * Element \c i of the vector is element \c i%plane().size() of the data
+ * @note We assume a class with this Tag has the methods \c size(), which
+ * returns the apparent size and \c plane(), which returns the container of
+ * the plane data
+ * @see dg::PlaneBroadcast
+ */
+struct BroadcastVectorTag : public SharedVectorTag {};
 struct CuspVectorTag    : public ThrustVectorTag {}; //!< special tag for cusp arrays
 struct StdArrayTag      : public ThrustVectorTag {}; //!< <tt> std::array< primitive_type, N> </tt>
 
@@ -8,6 +8,7 @@
 
 #include "blas.h"
 #include "functors.h"
+#include "gram_schmidt.h"
 
 /*!@file
  * BICGSTABl class
@@ -166,12 +167,17 @@ unsigned BICGSTABl< ContainerType>::solve( Matrix& A, ContainerType0& x, const C
 
         /// MR part ///
         for(unsigned j = 1; j<=l; j++){
-            for(unsigned i = 1; i<j;i++){
-                tau[i][j] = 1.0/sigma[i]*dg::blas1::dot(rhat[j],rhat[i]);
-                dg::blas1::axpby(-tau[i][j],rhat[i],1.,rhat[j]);
-            }
-            sigma[j] = dg::blas1::dot(rhat[j],rhat[j]);
-            gammap[j] = 1.0/sigma[j]*dg::blas1::dot(rhat[0],rhat[j]);
+            std::vector<const ContainerType*> basis( j-1);
+            for(unsigned i = 1; i<j;i++)
+                basis[i-1] = &rhat[i];
+            std::vector<value_type> h = dg::cgs2( basis, rhat[j],
+                std::vector<value_type>( sigma.begin()+1, sigma.begin()+j));
+            for(unsigned i = 1; i<j;i++)
+                tau[i][j] = h[i-1];
+            std::vector<value_type> dots = dg::blas1::multi_dot( rhat[j],
+                std::vector<const ContainerType*>{ &rhat[j], &rhat[0]});
+            sigma[j] = dots[0];
+            gammap[j] = 1.0/sigma[j]*dots[1];
         }
 
         gamma[l] = gammap[l];
@@ -90,6 +90,45 @@ inline get_value_type<ContainerType1> dot( const ContainerType1& x, const Contai
     return exblas::cpu::Round(acc.data());
 }
 
+/*! @brief \f$ x^T y_k\f$ Binary reproducible dot products of one vector with several vectors
+ *
+ * This routine computes \f[ d_k = x^T y_k = \sum_{i=0}^{N-1} x_i y_{ki} \f]
+ * for all \f$ k\f$ in one go. The results are bitwise identical to
+ * \c dg::blas1::dot( x, *ys[k]) but all superaccumulators are reduced together,
+ * i.e. with MPI there is only one \c MPI_Reduce and one \c MPI_Bcast instead of one each per vector.
+ * This is what makes classical Gram-Schmidt orthogonalization cheaper than the modified one
+ * when the dot products are latency bound.
+ * @copydoc hide_iterations
+ *
+For example
+@code
+dg::DVec two( 100,2), three(100,3), four(100,4);
+std::vector<double> result = dg::blas1::multi_dot( two,
+    std::vector<const dg::DVec*>{ &three, &four}); // result = {600, 800}
+@endcode
+ * @param x Left Container
+ * @param ys pointers to the right containers (may alias \c x); none of the
+ * containers may be a scalar
+ * @return Scalar products as defined above (same order as \c ys)
+ * @attention if one of the input vectors contains \c Inf or \c NaN or the
+ * product of the input numbers reaches \c Inf or \c Nan then the behaviour
+ * is undefined and the function may throw. See @ref dg::ISNFINITE and @ref
+ * dg::ISNSANE in that case
+ * @note For containers with the \c RecursiveVectorTag the reduction is done per element
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType1, class ContainerType2>
+inline std::vector<get_value_type<ContainerType1>> multi_dot( const ContainerType1& x, const std::vector<const ContainerType2*>& ys)
+{
+    std::vector<get_value_type<ContainerType1>> result( ys.size());
+    if( ys.empty())
+        return result;
+    std::vector<int64_t> acc = dg::blas1::detail::doMultiDot_superacc( x, ys);
+    for( unsigned k=0; k<ys.size(); k++)
+        result[k] = exblas::cpu::Round(&acc[k*exblas::BIN_COUNT]);
+    return result;
+}
+
 /*! @brief \f$ x_0 \otimes x_1 \otimes \dots \otimes x_{N-1} \f$ Custom reduction
  *
  * This routine computes \f[ s = s_0 + x_0 \otimes x_1 \otimes \dots \otimes x_i \otimes \dots \otimes x_{N-1} \f]
@@ -558,6 +597,19 @@ inline std::vector<int64_t> doDot_superacc( const ContainerType1& x, const Conta
     return doDot_superacc( x, y, tensor_category());
 }
 
+template< class ContainerType1, class ContainerType2>
+inline std::vector<int64_t> doMultiDot_superacc( const ContainerType1& x, const std::vector<const ContainerType2*>& ys)
+{
+    static_assert( all_true<
+            dg::is_not_scalar<ContainerType1>::value,
+            dg::is_not_scalar<ContainerType2>::value>::value,
+        "All container types must be vectors!");
+    using tensor_category  = get_tensor_category<ContainerType1>;
+    static_assert( dg::is_scalar_or_same_base_category<ContainerType2, tensor_category>::value,
+        "All container types must have compatible Vector categories (AnyVector or Same base class)!");
+    return doMultiDot_superacc( x, ys, tensor_category());
+}
+
 }//namespace detail
 ///@endcond
 
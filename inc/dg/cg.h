@@ -2,6 +2,7 @@
 #define _DG_CG_
 
 #include <cmath>
+#include <vector>
 
 #include "blas.h"
 #include "functors.h"
@@ -261,6 +262,209 @@ unsigned CG< ContainerType>::operator()( Matrix& A, ContainerType0& x, const Con
 }
 ///@endcond
 
+/**
+* @brief Multi-shift preconditioned conjugate gradient method to solve
+* \f[ (A + \sigma_j P^{-1}) x_j = b\f] for many shifts \f$ \sigma_j \ge 0\f$ at once
+*
+* The Krylov space of \f$ P(A+\sigma P^{-1}) = PA + \sigma I\f$ does not depend on
+* \f$\sigma\f$. Thus, all shifted systems are solved from the single sequence of search
+* directions of the unshifted system \f$ Ax=b\f$ and the iteration costs one
+* application of \f$ A\f$ regardless of the number of shifts.
+* The coefficients of the shifted systems follow from the recurrences in
+* <a href="https://arxiv.org/abs/hep-lat/9612014">Krylov space solvers for shifted linear systems</a> by B. Jegerlehner.
+* The shifted systems converge faster than the unshifted one, which is not iterated to convergence.
+* @note If \f$ A\f$ is a \c not_normed operator, then with the inverse weights as
+* preconditioner the shift is \f$ \sigma_j W\f$, i.e. the normed systems
+* \f$ (\sigma_j I + V A) x_j = V b\f$ are solved
+* @attention The initial guess is always zero. Each shift needs memory for two vectors
+* (one if only a linear combination of the solutions is needed)
+*
+* @ingroup invert
+* @copydoc hide_ContainerType
+*/
+template< class ContainerType>
+class MultiShiftCG
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    MultiShiftCG(){}
+    ///@copydoc construct()
+    MultiShiftCG( const ContainerType& copyable, unsigned max_iterations){
+        construct( copyable, max_iterations);
+    }
+    ///@brief Set the maximum number of iterations
+    ///@param new_max New maximum number
+    void set_max( unsigned new_max) {m_max_iter = new_max;}
+    ///@brief Get the current maximum number of iterations
+    ///@return the current maximum
+    unsigned get_max() const {return m_max_iter;}
+    ///@brief Return an object of same size as the object used for construction
+    ///@return A copyable object; what it contains is undefined, its size is important
+    const ContainerType& copyable()const{ return m_r;}
+
+    /**
+     * @brief Allocate memory for the multi-shift pcg method
+     *
+     * The memory for the shifted search directions is allocated in the first solve
+     * @param copyable A ContainerType must be copy-constructible from this
+     * @param max_iterations Maximum number of iterations to be used
+     */
+    void construct( const ContainerType& copyable, unsigned max_iterations) {
+        m_ap = m_p = m_z = m_r = copyable;
+        m_ps.clear();
+        m_max_iter = max_iterations;
+    }
+    /**
+     * @brief Solve \f$ (A+\sigma_j P^{-1})x_j = b\f$ for all shifts
+     *
+     * The iteration stops if \f$ ||b - (A+\sigma_j P^{-1})x_j||_S < \epsilon( ||b||_S + C) \f$
+     * for all \f$ j\f$ where \f$C\f$ is the absolute error in units of \f$ \epsilon\f$
+     * @param A A symmetric, positive definit matrix
+     * @param x (write only) the solutions (resized to the number of shifts if necessary)
+     * @param b The right hand side vector
+     * @param shifts The non-negative shifts \f$ \sigma_j\f$
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @return Number of iterations used to achieve desired precision (\c get_max() if not converged)
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned solve( MatrixType& A, std::vector<ContainerType0>& x, const ContainerType1& b, const std::vector<value_type>& shifts, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1)
+    {
+        x.resize( shifts.size(), m_r);
+        for( unsigned j=0; j<shifts.size(); j++)
+            blas1::copy( 0., x[j]);
+        return iterate( A, b, shifts, P, S, eps, nrmb_correction,
+            [&x]( unsigned j, value_type alpha, const ContainerType& p){
+                blas1::axpby( alpha, p, 1., x[j]);
+            });
+    }
+    /**
+     * @brief Compute the linear combination \f$ x = \sum_j \gamma_j (A+\sigma_j P^{-1})^{-1} b\f$
+     *
+     * The solutions of the shifted systems are never stored, which is e.g.
+     * useful in rational approximations and contour integrals of matrix functions.
+     * The iteration stops under the same condition as in \c solve
+     * @param A A symmetric, positive definit matrix
+     * @param x (write only) the linear combination of the solutions
+     * @param b The right hand side vector
+     * @param shifts The non-negative shifts \f$ \sigma_j\f$
+     * @param coeffs The coefficients \f$ \gamma_j\f$ (same size as \c shifts)
+     * @param P The preconditioner to be used
+     * @param S (Inverse) Weights used to compute the norm for the error condition
+     * @param eps The relative error to be respected
+     * @param nrmb_correction the absolute error \c C in units of \c eps to be respected
+     * @return Number of iterations used to achieve desired precision (\c get_max() if not converged)
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     * @tparam Preconditioner A type for which the blas2::symv(Preconditioner&, ContainerType&, ContainerType&) function is callable.
+     * @tparam SquareNorm A type for which the blas2::dot( const SquareNorm&, const ContainerType&) function is callable. This can e.g. be one of the ContainerType types.
+     */
+    template< class MatrixType, class ContainerType0, class ContainerType1, class Preconditioner, class SquareNorm >
+    unsigned operator()( MatrixType& A, ContainerType0& x, const ContainerType1& b, const std::vector<value_type>& shifts, const std::vector<value_type>& coeffs, Preconditioner& P, SquareNorm& S, value_type eps = 1e-12, value_type nrmb_correction = 1)
+    {
+        if( coeffs.size() != shifts.size())
+            throw dg::Error( dg::Message(_ping_)<<"MultiShiftCG: "<<coeffs.size()<<" coefficients given for "<<shifts.size()<<" shifts!");
+        blas1::copy( 0., x);
+        return iterate( A, b, shifts, P, S, eps, nrmb_correction,
+            [&x, &coeffs]( unsigned j, value_type alpha, const ContainerType& p){
+                blas1::axpby( coeffs[j]*alpha, p, 1., x);
+            });
+    }
+  private:
+    template< class MatrixType, class ContainerType1, class Preconditioner, class SquareNorm, class Update >
+    unsigned iterate( MatrixType& A, const ContainerType1& b, const std::vector<value_type>& shifts, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction, Update update);
+    ContainerType m_r, m_z, m_p, m_ap;
+    std::vector<ContainerType> m_ps;
+    std::vector<value_type> m_zeta, m_zeta_old, m_zeta_new;
+    std::vector<bool> m_converged;
+    unsigned m_max_iter;
+};
+
+///@cond
+template< class ContainerType>
+template< class Matrix, class ContainerType1, class Preconditioner, class SquareNorm, class Update>
+unsigned MultiShiftCG< ContainerType>::iterate( Matrix& A, const ContainerType1& b, const std::vector<value_type>& shifts, Preconditioner& P, SquareNorm& S, value_type eps, value_type nrmb_correction, Update update)
+{
+    const unsigned num = shifts.size();
+    value_type nrmb = sqrt( blas2::dot( S, b));
+    if( nrmb == 0 || num == 0)
+        return 0;
+    const value_type crit = eps*(nrmb + nrmb_correction);
+    //x_j = 0 thus r = b and p_j = p = Pb
+    blas1::copy( b, m_r);
+    blas2::symv( P, m_r, m_z);
+    blas1::copy( m_z, m_p);
+    m_ps.resize( num, m_r);
+    for( unsigned j=0; j<num; j++)
+        blas1::copy( m_z, m_ps[j]);
+    m_zeta.assign( num, 1.), m_zeta_old.assign( num, 1.), m_zeta_new.assign( num, 1.);
+    m_converged.assign( num, false);
+    value_type nrmzr_old = blas1::dot( m_z, m_r);
+    value_type alpha_old = 1., beta_old = 0.;
+    for( unsigned i=1; i<m_max_iter; i++)
+    {
+        blas2::symv( A, m_p, m_ap);
+        value_type alpha = nrmzr_old/blas1::dot( m_p, m_ap);
+        for( unsigned j=0; j<num; j++)
+        {
+            if( m_converged[j])
+                continue;
+            m_zeta_new[j] = m_zeta[j]*m_zeta_old[j]*alpha_old/(
+                alpha*beta_old*(m_zeta_old[j]-m_zeta[j]) +
+                m_zeta_old[j]*alpha_old*(1.+shifts[j]*alpha));
+            update( j, alpha*m_zeta_new[j]/m_zeta[j], m_ps[j]);
+        }
+        blas1::axpby( -alpha, m_ap, 1., m_r);
+        //residual of system j is zeta_j r
+        value_type nrmr = sqrt( blas2::dot( S, m_r));
+        bool converged = true;
+        for( unsigned j=0; j<num; j++)
+        {
+            if( !m_converged[j] && fabs( m_zeta_new[j])*nrmr < crit)
+                m_converged[j] = true;
+            converged = converged && m_converged[j];
+        }
+#ifdef DG_DEBUG
+#ifdef MPI_VERSION
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if(rank==0)
+#endif //MPI
+        {
+            std::cout << "# Absolute unshifted residual "<<nrmr <<"\t ";
+            std::cout << "#  < Critical "<<crit <<"\n";
+        }
+#endif //DG_DEBUG
+        if( converged)
+            return i;
+        blas2::symv( P, m_r, m_z);
+        value_type nrmzr_new = blas1::dot( m_z, m_r);
+        value_type beta = nrmzr_new/nrmzr_old;
+        blas1::axpby( 1., m_z, beta, m_p);
+        for( unsigned j=0; j<num; j++)
+        {
+            if( m_converged[j])
+                continue;
+            value_type ratio = m_zeta_new[j]/m_zeta[j];
+            blas1::axpby( m_zeta_new[j], m_z, beta*ratio*ratio, m_ps[j]);
+            m_zeta_old[j] = m_zeta[j];
+            m_zeta[j] = m_zeta_new[j];
+        }
+        nrmzr_old = nrmzr_new;
+        alpha_old = alpha, beta_old = beta;
+    }
+    return m_max_iter;
+}
+///@endcond
+
 /**
 * @brief Extrapolate a polynomial passing through up to three points
 *
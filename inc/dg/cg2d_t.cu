@@ -7,6 +7,7 @@
 #include "lgmres.h"
 #include "elliptic.h"
 #include "chebyshev.h"
+#include "helmholtz.h"
 
 const double lx = 2.*M_PI;
 const double ly = 2.*M_PI;
@@ -158,6 +159,44 @@ int main()
         res.d = sqrt(dg::blas2::dot( w2d, resi));
         std::cout << "L2 Norm of Residuum is        " << res.d<<"\n\n";
     }
+    std::cout << " MULTI-SHIFT PCG SOLVER:\n";
+    // solve ( -Delta + sigma ) x = f for all sigma at once: x = f/(2+sigma)
+    std::vector<double> shifts{ 0.1, 1., 10., 100.};
+    std::vector<dg::HVec> xs;
+    dg::MultiShiftCG<dg::HVec> mscg( copyable_vector, max_iter);
+    dg::HVec f = dg::evaluate( fct, grid), wf( f);
+    dg::blas2::symv( w2d, f, wf);
+    num_iter = mscg.solve( A, xs, wf, shifts, v2d, w2d, eps);
+    std::cout << "Number of multi-shift pcg iterations "<< num_iter<<std::endl;
+    for( unsigned j=0; j<shifts.size(); j++)
+    {
+        dg::blas1::axpby( 1./(2.+shifts[j]), f, -1., xs[j], error);
+        res.d = sqrt(dg::blas2::dot( w2d, error)/dg::blas2::dot( w2d, f));
+        std::cout << "Shift "<<shifts[j]<<" relative error "<<res.d<<"\n";
+    }
+    dg::HVec sum( x);
+    mscg( A, sum, wf, shifts, shifts, v2d, w2d, eps);
+    double ref = 0.;
+    for( unsigned j=0; j<shifts.size(); j++)
+        ref += shifts[j]/(2.+shifts[j]);
+    dg::blas1::axpby( ref, f, -1., sum, error);
+    res.d = sqrt(dg::blas2::dot( w2d, error)/dg::blas2::dot( w2d, f));
+    std::cout << "Linear combination relative error "<<res.d<<"\n\n";
+    std::cout << " CHEBYSHEV HELMHOLTZ:\n";
+    // (1 - 0.5 Delta) f = 2f
+    dg::Helmholtz<dg::CartesianGrid2d, dg::HMatrix, dg::HVec> gamma( grid, -0.5, dg::centered);
+    dg::ChebyshevHelmholtz<dg::HVec> chebyG( copyable_vector, eps);
+    chebyG.set_bounds( gamma, dg::evaluate( dg::WhiteNoise(), grid));
+    std::cout << "Spectrum in ["<<chebyG.min_ev()<<", "<<chebyG.max_ev()<<"]\n";
+    dg::blas1::copy( 0., x);
+    num_iter = chebyG.inverse( gamma, x, f);
+    dg::blas1::axpby( 0.5, f, -1., x, error);
+    res.d = sqrt(dg::blas2::dot( w2d, error)/dg::blas2::dot( w2d, f));
+    std::cout << "Inverse      with "<<num_iter<<" iterations relative error "<<res.d<<"\n";
+    num_iter = chebyG.inverse_sqrt( gamma, x, f);
+    dg::blas1::axpby( 1./sqrt(2.), f, -1., x, error);
+    res.d = sqrt(dg::blas2::dot( w2d, error)/dg::blas2::dot( w2d, f));
+    std::cout << "Inverse sqrt with degree "<<num_iter<<" relative error "<<res.d<<"\n\n";
     // Test Extrapolation object
     double value;
     dg::Extrapolation<double> extra(3,-1);
@@ -2,8 +2,12 @@
 #define _DG_CHEB_
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "blas.h"
+#include "eve.h"
+#include "topology/functions.h"
 
 /*!@file
  * Polynomial Preconditioners and solvers
@@ -67,6 +71,26 @@ class ChebyshevIteration
     ///@return A copyable object; what it contains is undefined, its size is important
     const ContainerType& copyable()const{ return m_ax;}
 
+    /**
+     * @brief Number of iterations needed to reduce the error by a given factor
+     *
+     * Uses the classic bound
+     * \f[ \|x-x_k\|_A \leq 2\left(\frac{\sqrt{\kappa}-1}{\sqrt{\kappa}+1}\right)^k \|x-x_0\|_A\f]
+     * with \f$ \kappa = \lambda_\max/\lambda_\min\f$, which holds if the
+     * spectrum lies within the given bounds
+     * @param min_ev a lower bound for the minimum Eigenvalue (must be positive)
+     * @param max_ev an upper bound for the maximum Eigenvalue (must be larger than \c min_ev)
+     * @param eps the relative accuracy to reach
+     * @return the smallest \c k that satisfies the above bound
+     */
+    static unsigned num_iterations( value_type min_ev, value_type max_ev, value_type eps)
+    {
+        assert( 0 < min_ev && min_ev < max_ev);
+        value_type sqrtk = sqrt( max_ev/min_ev);
+        value_type q = (sqrtk-1.)/(sqrtk+1.);
+        return (unsigned)ceil( log( eps/2.)/log( q));
+    }
+
     /**
      * @brief Allocate memory for the pcg method
      *
@@ -401,6 +425,293 @@ struct LeastSquaresPreconditioner
     unsigned m_degree;
 };
 
+/**
+ * @brief Approximate matrix function \f[ x = f(M^{-1}A) b \approx \frac{c_0}{2}b + \sum_{k=1}^{m}c_kT_k( Z)b\f]
+ *
+ * with \f$ Z = ( M^{-1}A - \theta I)/\delta\f$, \f$ \theta = (\lambda_\max + \lambda_\min)/2\f$,
+ * \f$ \delta = (\lambda_\max - \lambda_\min)/2\f$ and \f$ T_k\f$ the Chebyshev polynomials.
+ * The coefficients \f$ c_k\f$ are the Chebyshev interpolation coefficients of \f$ f\f$ on
+ * \f$ [\lambda_\min, \lambda_\max]\f$; the degree \c m is the smallest
+ * number for which the neglected coefficients sum to less than the
+ * requested accuracy relative to \f$\max|f|\f$.
+ * Applying the series needs \c m matrix-vector multiplications and no scalar
+ * products, which makes it appealing for highly parallelized systems.
+ * @note For an analytic \f$ f\f$ the coefficients decay geometrically;
+ * for \f$ f(\lambda) = \lambda^{-1}\f$ and \f$ f(\lambda) = \lambda^{-1/2}\f$
+ * the rate is \f$ (\sqrt\kappa-1)/(\sqrt\kappa+1)\f$ with \f$\kappa =
+ * \lambda_\max/\lambda_\min\f$, i.e. the degree grows with \f$\sqrt{\kappa}\f$
+ * @attention The approximation is only valid if the spectrum of \f$ M^{-1}A\f$
+ * lies within the given bounds
+ * @sa ChebyshevIteration
+ * @ingroup invert
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType>
+class ChebyshevMatrixFunction
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    ChebyshevMatrixFunction(){}
+    ///@copydoc construct()
+    ChebyshevMatrixFunction( const ContainerType& copyable):
+        m_ax(copyable), m_z( m_ax), m_tk(m_ax), m_tkm1(m_ax){}
+    ///@brief Return an object of same size as the object used for construction
+    ///@return A copyable object; what it contains is undefined, its size is important
+    const ContainerType& copyable()const{ return m_ax;}
+    /**
+     * @brief Allocate memory
+     *
+     * @param copyable A ContainerType must be copy-constructible from this
+     */
+    void construct( const ContainerType& copyable) {
+        m_tkm1 = m_tk = m_z = m_ax = copyable;
+    }
+    /**
+     * @brief Compute the Chebyshev coefficients and the degree of the series
+     *
+     * The coefficients are computed on the host from \c max_degree+1
+     * Chebyshev nodes, which costs \f$ O(\text{max\_degree}^2)\f$ function evaluations.
+     * Call this function only when the bounds or the function change.
+     * @param f the function to approximate (called as \c f(lambda))
+     * @param min_ev a lower bound for the minimum Eigenvalue
+     * @param max_ev an upper bound for the maximum Eigenvalue of \f$ M^{-1}A\f$ (must be larger than \c min_ev)
+     * Use \c EVE to get this value
+     * @param eps the relative accuracy of the approximation
+     * @param max_degree the degree is capped at this value if \c eps cannot be reached
+     * @return the degree \c m of the series
+     * @tparam UnaryOp models <tt>value_type f(value_type)</tt>
+     */
+    template<class UnaryOp>
+    unsigned set_function( UnaryOp f, value_type min_ev, value_type max_ev,
+            value_type eps, unsigned max_degree = 1000)
+    {
+        assert ( min_ev < max_ev);
+        m_theta = (min_ev+max_ev)/2., m_delta = (max_ev-min_ev)/2.;
+        unsigned N = max_degree+1;
+        std::vector<value_type> fx( N);
+        value_type fmax = 0.;
+        for( unsigned i=0; i<N; i++)
+        {
+            fx[i] = f( m_theta + m_delta*cos( M_PI*(i+0.5)/(value_type)N));
+            fmax = std::max( fmax, fabs( fx[i]));
+        }
+        m_c.assign( N, 0.);
+        for( unsigned k=0; k<N; k++)
+        {
+            for( unsigned i=0; i<N; i++)
+                m_c[k] += fx[i]*cos( M_PI*k*(i+0.5)/(value_type)N);
+            m_c[k] *= 2./(value_type)N;
+        }
+        value_type tail = 0.;
+        m_degree = max_degree;
+        for( unsigned k=max_degree; k>0; k--)
+        {
+            tail += fabs( m_c[k]);
+            if( tail > eps*fmax)
+                break;
+            m_degree = k-1;
+        }
+        m_c.resize( m_degree+1);
+        return m_degree;
+    }
+    ///@brief Degree of the series
+    ///@return the degree \c m determined in \c set_function
+    unsigned get_degree() const{ return m_degree;}
+    ///@brief The Chebyshev coefficients
+    ///@return the coefficients \f$ c_0, \dots, c_m\f$
+    const std::vector<value_type>& coefficients() const{ return m_c;}
+    /**
+     * @brief Compute \f$ x = f(M^{-1}A) b\f$
+     *
+     * @param A A symmetric, positive definit matrix
+     * @param P the Preconditioner (\f$ M^{-1}\f$ in the above notation)
+     * @param b The right hand side vector. x and b may be the same vector.
+     * @param x The result
+     * @copydoc hide_matrix
+     * @tparam ContainerTypes must be usable with \c MatrixType and \c ContainerType in \ref dispatch
+     */
+    template< class MatrixType, class Preconditioner, class ContainerType0, class ContainerType1>
+    void operator()( MatrixType& A, Preconditioner& P, const ContainerType0& b,
+        ContainerType1& x)
+    {
+        dg::blas1::copy( b, m_tkm1); //T_0 b
+        dg::blas1::axpby( m_c[0]/2., m_tkm1, 0., x);
+        if( m_degree == 0) return;
+        dg::blas2::symv( A, m_tkm1, m_ax);
+        dg::blas2::symv( P, m_ax, m_z);
+        dg::blas1::axpby( 1./m_delta, m_z, -m_theta/m_delta, m_tkm1, m_tk); //T_1 b
+        dg::blas1::axpby( m_c[1], m_tk, 1., x);
+        for( unsigned k=2; k<=m_degree; k++)
+        {
+            dg::blas2::symv( A, m_tk, m_ax);
+            dg::blas2::symv( P, m_ax, m_z);
+            dg::blas1::axpbypgz( 2./m_delta, m_z, -2.*m_theta/m_delta, m_tk,
+                -1., m_tkm1); //T_k b
+            dg::blas1::axpby( m_c[k], m_tkm1, 1., x);
+            using std::swap;
+            swap( m_tk, m_tkm1);
+        }
+    }
+  private:
+    ContainerType m_ax, m_z, m_tk, m_tkm1;
+    std::vector<value_type> m_c;
+    value_type m_theta = 1., m_delta = 1.;
+    unsigned m_degree = 0;
+};
+
+/**
+ * @brief Deterministic white noise in \f$ [0,1)\f$
+ *
+ * White noise contains all wavelengths a grid can represent and is thus a
+ * suitable right hand side for Eigenvalue estimates, e.g. in \c ChebyshevHelmholtz::set_bounds
+ * @code
+ChebyshevHelmholtz<dg::DVec> cheby( copyable, eps);
+cheby.set_bounds( helmholtz, dg::evaluate( dg::WhiteNoise(), grid));
+ * @endcode
+ * @note The values only depend on the coordinates, so the result is
+ * reproducible and independent of the number of MPI processes
+ * @ingroup invert
+ */
+struct WhiteNoise
+{
+    ///@return \f$ \{|\sin( 12.9898 x + 78.233 y)| 43758.5453\}\f$ (the fractional part)
+    DG_DEVICE
+    double operator()( double x, double y) const
+    {
+        return fmod( fabs( sin( 12.9898*x + 78.233*y))*43758.5453, 1.);
+    }
+    ///@return \f$ \{|\sin( 12.9898 x + 78.233 y + 37.719 z)| 43758.5453\}\f$ (the fractional part)
+    DG_DEVICE
+    double operator()( double x, double y, double z) const
+    {
+        return fmod( fabs( sin( 12.9898*x + 78.233*y + 37.719*z))*43758.5453, 1.);
+    }
+};
+
+/**
+ * @brief Reduction-free application of \f$ (1-\alpha\Delta)^{-1}\f$ and \f$ (1-\alpha\Delta)^{-1/2}\f$
+ *
+ * Drop-in for the CG based inversion of a Helmholtz-type operator \f$ A\f$
+ * (e.g. \c dg::Helmholtz or \c dg::Helmholtz3d with \f$\alpha < 0\f$)
+ * whose normed version \f$ W^{-1}A\f$ has its spectrum in
+ * \f$ [\lambda_\min, \lambda_\max]\f$.
+ * The inverse is computed with a fixed number of \c ChebyshevIteration steps,
+ * the inverse square root with a \c ChebyshevMatrixFunction. In both cases
+ * the number of matrix-vector multiplications is determined once from the
+ * requested accuracy and the spectral bounds, and no scalar products are
+ * computed when the operators are applied.
+ * @note For \f$ W^{-1}A = 1-\alpha\Delta\f$ with \f$\alpha<0\f$ we have
+ * \f$\lambda_\min \geq 1\f$, while \f$\lambda_\max\f$ is estimated with \c EVE in \c set_bounds.
+ * The number of iterations grows with \f$\sqrt{\lambda_\max/\lambda_\min}\f$,
+ * so this is most attractive when global reductions dominate the cost of a CG iteration
+ * @ingroup invert
+ * @copydoc hide_ContainerType
+ */
+template< class ContainerType>
+class ChebyshevHelmholtz
+{
+  public:
+    using container_type = ContainerType;
+    using value_type = get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c construct method before usage
+    ChebyshevHelmholtz(){}
+    ///@copydoc construct()
+    ChebyshevHelmholtz( const ContainerType& copyable, value_type eps,
+            unsigned max_degree = 1000){
+        construct( copyable, eps, max_degree);
+    }
+    /**
+     * @brief Allocate memory
+     *
+     * @param copyable A ContainerType must be copy-constructible from this
+     * @param eps the relative accuracy of the approximations
+     * @param max_degree maximum number of matrix-vector multiplications per application
+     */
+    void construct( const ContainerType& copyable, value_type eps,
+            unsigned max_degree = 1000)
+    {
+        m_b = copyable;
+        m_cheby.construct( copyable);
+        m_invsqrt.construct( copyable);
+        m_eps = eps;
+        m_max_degree = max_degree;
+    }
+    /**
+     * @brief Estimate the spectral bounds and set up both approximations
+     *
+     * Call this once and again whenever the operator changes.
+     * @param op the (not normed) operator, must provide \c weights() and \c inv_weights()
+     * @param rand a vector that should contain all wavelengths, e.g. \c dg::WhiteNoise;
+     * used as right hand side for \c EVE
+     * @param min_ev a lower bound for the minimum Eigenvalue of the normed operator
+     * @param safety the \c EVE estimate of the maximum Eigenvalue is multiplied by this factor
+     * since Chebyshev iterations may diverge if it is underestimated
+     * @return the number of \c EVE iterations
+     * @tparam SymmetricOp Symmetric operator with the \c SelfMadeMatrixTag
+     */
+    template<class SymmetricOp, class ContainerType0>
+    unsigned set_bounds( SymmetricOp& op, const ContainerType0& rand,
+            value_type min_ev = 1., value_type safety = 1.1)
+    {
+        dg::EVE<ContainerType> eve( m_b);
+        ContainerType x = m_b;
+        dg::blas1::copy( 0., x);
+        dg::blas2::symv( op.weights(), rand, m_b);
+        value_type ev_max = 0.;
+        unsigned number = eve( op, x, m_b, op.inv_weights(), ev_max, 1e-6);
+        m_ev_min = min_ev, m_ev_max = safety*ev_max;
+        if( m_ev_max <= m_ev_min)
+            m_ev_max = 1.1*m_ev_min; //e.g. for alpha = 0
+        m_num_iter = std::min( m_max_degree,
+            ChebyshevIteration<ContainerType>::num_iterations( m_ev_min, m_ev_max, m_eps));
+        m_invsqrt.set_function( [](value_type x){ return 1./sqrt(x);}, m_ev_min,
+            m_ev_max, m_eps, m_max_degree);
+        return number;
+    }
+    ///@brief Lower bound of the spectrum
+    value_type min_ev() const{ return m_ev_min;}
+    ///@brief Upper bound of the spectrum
+    value_type max_ev() const{ return m_ev_max;}
+    /**
+     * @brief Compute \f$ x = (W^{-1}A)^{-1} b\f$
+     *
+     * @param op the (not normed) operator used in \c set_bounds
+     * @param x initial guess on input (e.g. from \c dg::Extrapolation), result on output
+     * @param b the (normed) right hand side
+     * @return the number of Chebyshev iterations
+     */
+    template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    unsigned inverse( SymmetricOp& op, ContainerType0& x, const ContainerType1& b)
+    {
+        dg::blas2::symv( op.weights(), b, m_b);
+        m_cheby.solve( op, x, m_b, op.inv_weights(), m_ev_min, m_ev_max,
+            m_num_iter);
+        return m_num_iter;
+    }
+    /**
+     * @brief Compute \f$ x = (W^{-1}A)^{-1/2} b\f$
+     *
+     * @param op the (not normed) operator used in \c set_bounds
+     * @param x the result
+     * @param b the (normed) right hand side
+     * @return the degree of the Chebyshev series
+     */
+    template<class SymmetricOp, class ContainerType0, class ContainerType1>
+    unsigned inverse_sqrt( SymmetricOp& op, ContainerType0& x, const ContainerType1& b)
+    {
+        m_invsqrt( op, op.inv_weights(), b, x);
+        return m_invsqrt.get_degree();
+    }
+  private:
+    ContainerType m_b;
+    ChebyshevIteration<ContainerType> m_cheby;
+    ChebyshevMatrixFunction<ContainerType> m_invsqrt;
+    value_type m_eps = 1e-6, m_ev_min = 1., m_ev_max = 2.;
+    unsigned m_max_degree = 1000, m_num_iter = 0;
+};
+
 ///@cond
 template<class M, class V>
 struct TensorTraits<ChebyshevPreconditioner<M,V>>
@@ -10,6 +10,7 @@
 #include "topology/mpi_evaluation.h"
 #endif
 #include "topology/geometry.h"
+#include "topology/split_and_join.h"
 
 /*! @file
 
@@ -125,6 +126,7 @@ class Elliptic
         dg::assign( dg::create::inv_weights(g),   m_precond);
         m_temp = m_tempx = m_tempy = m_inv_weights;
         m_chi=g.metric();
+        m_pattern = dg::tensor::find_pattern( m_chi);
         m_sigma = m_vol = dg::tensor::volume(m_chi);
         dg::assign( dg::create::weights(g), m_weights_wo_vol);
     }
@@ -183,6 +185,7 @@ class Elliptic
     void set_chi( const SparseTensor<ContainerType0>& tau)
     {
         m_chi = SparseTensor<Container>(tau);
+        m_pattern = dg::tensor::find_pattern( m_chi);
     }
 
     /**
@@ -276,7 +279,7 @@ class Elliptic
         dg::blas2::gemv( m_righty, x, m_tempy); //R_y*f
 
         //multiply with tensor (note the alias)
-        dg::tensor::multiply2d(m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
+        dg::tensor::multiply2d(m_pattern, m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
 
         //now take divergence
         dg::blas2::symv( m_lefty, m_tempy, m_temp);
@@ -289,7 +292,7 @@ class Elliptic
             {
                 dg::blas2::symv( m_jfactor, m_jumpX, x, 0., m_tempx);
                 dg::blas2::symv( m_jfactor, m_jumpY, x, 0., m_tempy);
-                dg::tensor::multiply2d(m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
+                dg::tensor::multiply2d(m_pattern, m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
                 dg::blas1::axpbypgz(1.0,m_tempx,1.0,m_tempy,1.0,m_temp);
             }
             else
@@ -345,7 +348,7 @@ class Elliptic
     {
         dg::blas2::gemv( m_rightx, phi, m_tempx); //R_x*f
         dg::blas2::gemv( m_righty, phi, m_tempy); //R_y*f
-        dg::tensor::scalar_product2d(alpha, lambda, m_tempx, m_tempy, m_chi, lambda, m_tempx, m_tempy, beta, sigma);
+        dg::tensor::scalar_product2d(m_pattern, alpha, lambda, m_tempx, m_tempy, m_chi, lambda, m_tempx, m_tempy, beta, sigma);
     }
 
 
@@ -363,6 +366,7 @@ class Elliptic
     Container m_tempx, m_tempy, m_temp;
     norm m_no;
     SparseTensor<Container> m_chi, m_metric;
+    dg::tensor::pattern m_pattern = dg::tensor::pattern::dense;
     Container m_sigma, m_vol;
     value_type m_jfactor;
     bool m_chi_weight_jump;
@@ -374,6 +378,20 @@ template <class Geometry, class Matrix, class Container>
 using Elliptic2d = Elliptic<Geometry, Matrix, Container>;
 
 //Elliptic3d is tested in inc/geometries/elliptic3d_t.cu
+///@cond
+namespace detail
+{
+//The metric of product geometries does not depend on z
+template<class Geometry>
+using is_product_geometry3d = std::integral_constant<bool,
+    std::is_base_of<aRealProductGeometry3d<typename Geometry::value_type>, Geometry>::value
+#ifdef MPI_VERSION
+    || std::is_base_of<aRealProductMPIGeometry3d<typename Geometry::value_type>, Geometry>::value
+#endif //MPI_VERSION
+    >;
+}//namespace detail
+///@endcond
+
 /**
  * @brief A 3d negative elliptic differential operator \f$ -\nabla \cdot ( \mathbf{\chi}\cdot \nabla ) \f$
  *
@@ -413,6 +431,9 @@ using Elliptic2d = Elliptic<Geometry, Matrix, Container>;
  * and thus in a conjugate gradient solver.
  * @note The constructors initialize \f$ \chi=\sqrt{g}g^{-1}\f$ so that a
  * negative laplacian operator results
+ * @note For product geometries (\c dg::aProductGeometry3d) the metric does
+ * not depend on z and only one plane of it is stored (\c dg::PlaneBroadcast).
+ * The same holds if \c set_chi is called with a tensor of \c broadcast_type
  * @note The inverse of \f$ \sigma\f$ makes a good general purpose preconditioner
  * @note the jump term \f$ \alpha J\f$  adds artificial numerical diffusion as discussed above
  * @note Since the pattern arises quite often (because of the ExB velocity \f$ u_E^2\f$ in the ion gyro-centre potential)
@@ -427,6 +448,9 @@ class Elliptic3d
     using matrix_type = Matrix;
     using container_type = Container;
     using value_type = get_value_type<Container>;
+    ///@brief One plane of a \c Container broadcast to the full grid (cf. \c dg::broadcast_plane)
+    using broadcast_type = std::decay_t<decltype( dg::broadcast_plane(
+        std::declval<const Container&>(), std::declval<const Geometry&>()))>;
     ///@brief empty object ( no memory allocation)
     Elliptic3d(){}
     /**
@@ -480,8 +504,10 @@ class Elliptic3d
         dg::assign( dg::create::inv_weights(g),   m_precond);
         m_temp = m_tempx = m_tempy = m_tempz = m_inv_weights;
         m_chi=g.metric();
+        m_pattern = dg::tensor::find_pattern( m_chi);
         m_sigma = m_vol = dg::tensor::volume(m_chi);
         dg::assign( dg::create::weights(g), m_weights_wo_vol);
+        broadcast_metric( g, detail::is_product_geometry3d<Geometry>());
     }
     ///@copydoc Elliptic::construct()
     template<class ...Params>
@@ -508,6 +534,22 @@ class Elliptic3d
     void set_chi( const SparseTensor<ContainerType0>& tau)
     {
         m_chi = SparseTensor<Container>(tau);
+        m_pattern = dg::tensor::find_pattern( m_chi);
+        m_chi_plane = SparseTensor<broadcast_type>();
+        m_chi_is_plane = false;
+    }
+    /**
+     * @brief Set a tensor that does not depend on z
+     *
+     * Only one plane of the tensor is stored and used
+     * @param tau the new tensor \f$\tau\f$ (cf. \c dg::broadcast_plane)
+     */
+    void set_chi( const SparseTensor<broadcast_type>& tau)
+    {
+        m_chi_plane = tau;
+        m_pattern = dg::tensor::find_pattern( m_chi_plane);
+        m_chi = SparseTensor<Container>();
+        m_chi_is_plane = true;
     }
 
     ///@copydoc Elliptic::inv_weights()
@@ -559,14 +601,14 @@ class Elliptic3d
             dg::blas2::gemv( m_rightz, x, m_tempz); //R_z*f
 
             //multiply with tensor (note the alias)
-            dg::tensor::multiply3d(m_sigma, m_chi, m_tempx, m_tempy, m_tempz, 0., m_tempx, m_tempy, m_tempz);
+            multiply3d_chi( m_tempx, m_tempy, m_tempz, 0., m_tempx, m_tempy, m_tempz);
             //now take divergence
             dg::blas2::symv( -1., m_leftz, m_tempz, 0., m_temp);
             dg::blas2::symv( -1., m_lefty, m_tempy, 1., m_temp);
         }
         else
         {
-            dg::tensor::multiply2d(m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
+            multiply2d_chi( m_tempx, m_tempy, 0., m_tempx, m_tempy);
             dg::blas2::symv( -1.,m_lefty, m_tempy, 0., m_temp);
         }
         dg::blas2::symv( -1., m_leftx, m_tempx, 1., m_temp);
@@ -578,7 +620,7 @@ class Elliptic3d
             {
                 dg::blas2::symv( m_jfactor, m_jumpX, x, 0., m_tempx);
                 dg::blas2::symv( m_jfactor, m_jumpY, x, 0., m_tempy);
-                dg::tensor::multiply2d(m_sigma, m_chi, m_tempx, m_tempy, 0., m_tempx, m_tempy);
+                multiply2d_chi( m_tempx, m_tempy, 0., m_tempx, m_tempy);
                 dg::blas1::axpbypgz(1.0,m_tempx,1.0,m_tempy,1.0,m_temp);
             }
             else
@@ -613,7 +655,10 @@ class Elliptic3d
             dg::blas2::gemv( m_rightz, phi, m_tempz); //R_y*f
         else
             dg::blas1::scal( m_tempz, 0.);
-        dg::tensor::scalar_product3d(alpha, lambda,  m_tempx, m_tempy, m_tempz, m_chi, lambda, m_tempx, m_tempy, m_tempz, beta, sigma);
+        if( m_chi_is_plane)
+            dg::tensor::scalar_product3d(m_pattern, alpha, lambda,  m_tempx, m_tempy, m_tempz, m_chi_plane, lambda, m_tempx, m_tempy, m_tempz, beta, sigma);
+        else
+            dg::tensor::scalar_product3d(m_pattern, alpha, lambda,  m_tempx, m_tempy, m_tempz, m_chi, lambda, m_tempx, m_tempy, m_tempz, beta, sigma);
     }
 
     ///@copydoc Elliptic::set_norm(dg::norm)
@@ -621,11 +666,36 @@ class Elliptic3d
         m_no = new_norm;
     }
     private:
+    //the metric of a product geometry does not depend on z
+    void broadcast_metric( const Geometry& g, std::true_type)
+    {
+        set_chi( dg::broadcast_plane( m_chi, g));
+    }
+    void broadcast_metric( const Geometry& g, std::false_type){ }
+    template<class ...ContainerTypes>
+    void multiply2d_chi( ContainerTypes&& ...xs)
+    {
+        if( m_chi_is_plane)
+            dg::tensor::multiply2d(m_pattern, m_sigma, m_chi_plane, std::forward<ContainerTypes>(xs)...);
+        else
+            dg::tensor::multiply2d(m_pattern, m_sigma, m_chi, std::forward<ContainerTypes>(xs)...);
+    }
+    template<class ...ContainerTypes>
+    void multiply3d_chi( ContainerTypes&& ...xs)
+    {
+        if( m_chi_is_plane)
+            dg::tensor::multiply3d(m_pattern, m_sigma, m_chi_plane, std::forward<ContainerTypes>(xs)...);
+        else
+            dg::tensor::multiply3d(m_pattern, m_sigma, m_chi, std::forward<ContainerTypes>(xs)...);
+    }
     Matrix m_leftx, m_lefty, m_leftz, m_rightx, m_righty, m_rightz, m_jumpX, m_jumpY;
     Container m_weights, m_inv_weights, m_precond, m_weights_wo_vol;
     Container m_tempx, m_tempy, m_tempz, m_temp;
     norm m_no;
-    SparseTensor<Container> m_chi;
+    SparseTensor<Container> m_chi; //used if chi depends on z
+    SparseTensor<broadcast_type> m_chi_plane; //used if chi does not depend on z
+    bool m_chi_is_plane = false;
+    dg::tensor::pattern m_pattern = dg::tensor::pattern::dense;
     Container m_sigma, m_vol;
     value_type m_jfactor;
     bool m_multiplyZ = true;
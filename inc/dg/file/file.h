@@ -1,3 +1,6 @@
 #pragma once
 #include "nc_utilities.h"
+#include "probes.h"
+#include "downsampling.h"
+#include "writer.h"
 #include "json_utilities.h"
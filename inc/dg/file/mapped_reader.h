@@ -0,0 +1,3 @@
+#pragma once
+#define _FILE_INCLUDED_BY_DG_
+#include "../../file/mapped_reader.h"
@@ -1997,6 +1997,7 @@ struct Horner2d
 
 /**
  * @brief Compute a histogram on a 1D grid
+ * @sa dg::StreamingHistogram for large or distributed data
  * @tparam container
  */
 template <class container = thrust::host_vector<double> >
@@ -2056,6 +2057,7 @@ struct Histogram
 
 /**
  * @brief Compute a histogram on a 2D grid
+ * @sa dg::StreamingHistogram2d for large or distributed data
  * @tparam container
  */
 template <class container = thrust::host_vector<double> >
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include "blas1.h"
+
+/*!@file
+ *
+ * Classical Gram-Schmidt orthogonalization with reorthogonalization
+ */
+
+namespace dg{
+
+/**
+ * @brief \f$ v \leftarrow v - \sum_k h_k q_k\f$
+ *
+ * Two vectors are subtracted per memory sweep of \c v
+ * @param qs pointers to the vectors \f$ q_k\f$ (must not alias \c v)
+ * @param h coefficients \f$ h_k\f$ (at least as many as \c qs)
+ * @param v (inout) the vector to update
+ * @ingroup invert
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+void subtract_combination( const std::vector<const ContainerType*>& qs,
+    const std::vector<get_value_type<ContainerType>>& h, ContainerType& v)
+{
+    unsigned k=0;
+    for( ; k+1<qs.size(); k+=2)
+        dg::blas1::axpbypgz( -h[k], *qs[k], -h[k+1], *qs[k+1], 1., v);
+    if( k < qs.size())
+        dg::blas1::axpby( -h[k], *qs[k], 1., v);
+}
+
+/**
+ * @brief Orthogonalize a vector against a set of orthogonal vectors with
+ * classical Gram-Schmidt and one reorthogonalization (CGS2)
+ *
+ * Two passes of
+ * \f[ h_k = q_k^T v / \sigma_k,\quad v \leftarrow v - \sum_k h_k q_k \f]
+ * where \f$ \sigma_k = q_k^Tq_k\f$. Each pass computes all dot products with one
+ * \c dg::blas1::multi_dot, i.e. one global reduction, while modified
+ * Gram-Schmidt needs one reduction per vector. A single classical pass
+ * loses orthogonality if \c v is nearly in the span of the \f$ q_k\f$;
+ * the second pass restores it to the level of modified Gram-Schmidt.
+ * @param qs pointers to the mutually orthogonal vectors \f$ q_k\f$ (must not alias \c v)
+ * @param v (inout) the vector to orthogonalize
+ * @param sigma the squared norms \f$ \sigma_k\f$ of the \f$ q_k\f$;
+ * if empty the \f$ q_k\f$ are assumed to be normalized
+ * @return the sum of the coefficients \f$ h_k\f$ of both passes, i.e. the
+ * projections of the input \c v onto the \f$ q_k/\sigma_k\f$
+ * @ingroup invert
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+std::vector<get_value_type<ContainerType>> cgs2(
+    const std::vector<const ContainerType*>& qs, ContainerType& v,
+    const std::vector<get_value_type<ContainerType>>& sigma = {})
+{
+    using value_type = get_value_type<ContainerType>;
+    std::vector<value_type> h( qs.size(), 0.);
+    if( qs.empty())
+        return h;
+    for( unsigned pass=0; pass<2; pass++)
+    {
+        std::vector<value_type> hp = dg::blas1::multi_dot( v, qs);
+        if( !sigma.empty())
+            for( unsigned k=0; k<qs.size(); k++)
+                hp[k] /= sigma[k];
+        subtract_combination( qs, hp, v);
+        for( unsigned k=0; k<qs.size(); k++)
+            h[k] += hp[k];
+    }
+    return h;
+}
+
+}//namespace dg
@@ -46,22 +46,35 @@ int main()
     std::cout << "T matrix\n";
     cusp::print(T);
 
-    dg::InvTridiag<Container, DiaMatrix, CooMatrix> invtridiag(a);
+    dg::TridiagInvCompact<Container, DiaMatrix> invtridiag(size);
+    cusp::array2d<double, memory_type> Tinv_compact(size, size);
     t.tic();
-    Tinv = invtridiag(a,b,c);
+    invtridiag(a,b,c);
     t.toc();
+    for( unsigned i=0; i<size; i++)
+        for( unsigned j=0; j<size; j++)
+            Tinv_compact(i,j) = invtridiag.entry(i,j);
+    cusp::convert(Tinv_compact, Tinv);
     std::cout << "Difference between Tinv and solution\n";
     cusp::subtract(Tinv_sol, Tinv, Tinv_error);
     cusp::print(Tinv_error);
     std::cout <<  "time: "<< t.diff()<<"s \n";
-    
+
     t.tic();
-    Tinv = invtridiag(T);
+    invtridiag(T);
     t.toc();
-
-    std::cout << "Difference between Tinv and solution\n";
-    cusp::subtract(Tinv_sol, Tinv, Tinv_error);
-    cusp::print(Tinv_error);
+    Container v(size), y(size), y_sol(size), e1(size, 0.);
+    for( unsigned i=0; i<size; i++)
+        v[i] = i+1;
+    e1[0] = 1.;
+    dg::blas2::symv( invtridiag, v, y);
+    dg::blas2::symv( Tinv_sol, v, y_sol);
+    dg::blas1::axpby( 1., y_sol, -1., y);
+    std::cout << "Relative error of T^{-1} v    "<<sqrt( dg::blas1::dot( y, y)/dg::blas1::dot( y_sol, y_sol))<<" (should be ~1e-6)\n";
+    invtridiag.inv_e1( y);
+    dg::blas2::symv( Tinv_sol, e1, y_sol);
+    dg::blas1::axpby( 1., y_sol, -1., y);
+    std::cout << "Relative error of T^{-1} e_1  "<<sqrt( dg::blas1::dot( y, y)/dg::blas1::dot( y_sol, y_sol))<<" (should be ~1e-6)\n";
     std::cout <<  "time: "<< t.diff()<<"s \n";
     return 0;
 }
@@ -173,8 +173,8 @@ class Lanczos
             } 
             m_TH.values(i,2) = betaip;  // +1 diagonal
             m_tridiaginvH.resize(i+1);
-            m_TinvH = m_tridiaginvH(m_TH);
-            residual = r0norm*betaip*abs(m_TinvH.values[i]); //used symmetry of TinvH
+            m_tridiaginvH(m_TH);
+            residual = r0norm*betaip*abs(m_tridiaginvH.entry(0,i)); //used symmetry of T^{-1}
 #ifdef DG_DEBUG
             std::cout << "# ||r||_2 =  " << residual << " at i = " << i << "\n";
 #endif //DG_DEBUG
@@ -247,9 +247,9 @@ class Lanczos
             } 
             m_TH.values(i,2) =  betaip;  // +1 diagonal
             m_tridiaginvH.resize(i+1);
-            m_TinvH = m_tridiaginvH(m_TH); 
+            m_tridiaginvH(m_TH);
 
-            residual = r0norm*betaip*abs(m_TinvH.values[i]); //used symmetry of m_TinvH
+            residual = r0norm*betaip*abs(m_tridiaginvH.entry(0,i)); //used symmetry of T^{-1}
 #ifdef DG_DEBUG
             std::cout << "# res_fac*||r||_M =  " << res_fac*residual << "  at i = " << i << "\n";
 #endif //DG_DEBUG
@@ -277,9 +277,8 @@ class Lanczos
   private:
     ContainerType  m_v, m_vp, m_w, m_wp, m_wm;
     HDiaMatrix m_TH;
-    HCooMatrix m_TinvH;
     unsigned m_iter, m_max_iter;
-    dg::TridiagInvDF<HVec, HDiaMatrix, HCooMatrix> m_tridiaginvH;
+    dg::TridiagInvCompact<HVec, HDiaMatrix> m_tridiaginvH;
 };
 
 /*! 
@@ -461,12 +460,10 @@ class MCG
         //Compute inverse of tridiagonal matrix
         if (compute_x == true)
         {
-            HVec e1H(get_iter(), 0.);
             HVec yH(get_iter(), 0.);
-            e1H[0] = 1.;
-            dg::TridiagInvDF<HVec, HDiaMatrix, HCooMatrix> tridiaginv(yH);
-            HCooMatrix TinvH = tridiaginv(m_TH); //Compute on Host!            
-            dg::blas2::symv(TinvH, e1H, yH);  // m_y= T^(-1) e_1   
+            dg::TridiagInvCompact<HVec, HDiaMatrix> tridiaginv(yH);
+            tridiaginv(m_TH); //Compute on Host!
+            tridiaginv.inv_e1(yH);  // m_y= T^(-1) e_1
             Ry(A, m_TH, Minv, M, yH, x, b,  get_iter());  // x = 0 + R T^(-1) e_1  
         }
         return m_TH;
@@ -8,6 +8,7 @@
 
 #include "blas.h"
 #include "functors.h"
+#include "gram_schmidt.h"
 /*!@file
  * LGMRES class
  *
@@ -201,11 +202,12 @@ unsigned LGMRES< ContainerType>::solve( Matrix& A, ContainerType0& x, const Cont
             dg::blas2::symv(P,V[iteration+1],V[iteration+1]);
             unsigned row;
 
+            std::vector<const ContainerType*> basis( iteration+1);
             for(row=0;row<=iteration;++row)
-			{
-                H[row][iteration] = dg::blas1::dot(V[iteration+1],V[row]);
-                dg::blas1::axpby(-H[row][iteration],V[row],1.,V[iteration+1]);
-			}
+                basis[row] = &V[row];
+            std::vector<value_type> h = dg::cgs2( basis, V[iteration+1]);
+            for(row=0;row<=iteration;++row)
+                H[row][iteration] = h[row];
             H[iteration+1][iteration] = sqrt(dg::blas1::dot(V[iteration+1],V[iteration+1]));
             dg::blas1::scal(V[iteration+1],1.0/H[iteration+1][iteration]);
             dg::blas1::copy(z,W[iteration]);
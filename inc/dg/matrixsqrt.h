@@ -396,7 +396,7 @@ class KrylovSqrtODEinvert
         m_e1H.assign(max_iterations, 0.);
         m_e1H[0] = 1.;
         m_yH.assign(max_iterations, 1.);
-        m_TinvH.resize(copyable.size(), max_iterations, max_iterations*copyable.size());
+        m_TinvH.resize(max_iterations);
         m_sqrtodeH.construct(m_TinvH, m_e1H, epsCG, false, false);
         m_mcg.construct(copyable, max_iterations);
     }
@@ -427,8 +427,8 @@ class KrylovSqrtODEinvert
         //Compute x (with initODE with gemres replacing cg invert)
         m_TH = m_mcg(m_A, x, m_b, m_A.inv_weights(), m_A.weights(), m_eps, 1., false); 
         unsigned iter = m_mcg.get_iter();
-        m_TridiaginvH.resize(iter);
-        m_TinvH = m_TridiaginvH(m_TH);
+        m_TinvH.resize(iter);
+        m_TinvH(m_TH);
         
         m_e1H.resize(iter, 0.);
         m_e1H[0] = 1.;
@@ -449,10 +449,9 @@ class KrylovSqrtODEinvert
     value_type m_epsCG, m_epsTimerel, m_epsTimeabs, m_eps;
     Container m_b;
     HVec m_e1H, m_yH;
-    dg::SqrtODE<HDiaMatrix, HVec> m_sqrtodeH;  
-    dg::TridiagInvDF<HVec, HDiaMatrix, HCooMatrix> m_TridiaginvH;
+    dg::SqrtODE<dg::TridiagInvCompact<HVec, HDiaMatrix>, HVec> m_sqrtodeH;
     dg::MCG< Container> m_mcg;
-    HCooMatrix m_TinvH;
+    dg::TridiagInvCompact<HVec, HDiaMatrix> m_TinvH;
     HDiaMatrix m_TH;
 };
 
@@ -501,7 +500,7 @@ class KrylovSqrtCauchyinvert
         m_e1H.assign(max_iterations, 0.);
         m_e1H[0] = 1.;
         m_yH.assign(max_iterations, 1.);
-        m_TinvH.resize(copyable.size(), max_iterations, max_iterations*copyable.size());
+        m_TinvH.resize(max_iterations);
         m_cauchysqrtH.construct(m_TinvH, m_e1H, epsCG, false, false);
         m_mcg.construct(copyable, max_iterations);
         value_type hxhy = g.lx()*g.ly()/(g.n()*g.n()*g.Nx()*g.Ny());
@@ -537,8 +536,8 @@ class KrylovSqrtCauchyinvert
         //Compute x (with initODE with gemres replacing cg invert)
         m_TH = m_mcg(m_A, x, m_b, m_A.inv_weights(), m_A.weights(), m_eps, 1., false); 
         unsigned iter = m_mcg.get_iter();
-        m_TridiaginvH.resize(iter);
-        m_TinvH = m_TridiaginvH(m_TH); 
+        m_TinvH.resize(iter);
+        m_TinvH(m_TH);
 
         m_e1H.resize(iter, 0.);
         m_e1H[0] = 1.;
@@ -559,10 +558,9 @@ class KrylovSqrtCauchyinvert
     value_type m_epsCG,  m_eps, m_EVmin, m_EVmax;
     Container m_b;
     HVec m_e1H, m_yH;
-    dg::SqrtCauchyInt<HDiaMatrix, HVec> m_cauchysqrtH; 
-    dg::TridiagInvDF<HVec, HDiaMatrix, HCooMatrix> m_TridiaginvH;
+    dg::SqrtCauchyInt<dg::TridiagInvCompact<HVec, HDiaMatrix>, HVec> m_cauchysqrtH;
     dg::MCG< Container > m_mcg;
-    HCooMatrix  m_TinvH;     
+    dg::TridiagInvCompact<HVec, HDiaMatrix> m_TinvH;     
     HDiaMatrix m_TH;
 };
 
@@ -35,11 +35,11 @@ class PolCharge
      * @param jfactor (\f$ = \alpha \f$ ) scale jump terms (1 is a good value but in some cases 0.1 or 0.01 might be better)
      * @param chi_weight_jump If true, the Jump terms are multiplied with the Chi matrix, else it is ignored
      * @param mode arbitrary wavelength polarization charge mode ("df" / "ff" / "ffO4" are implemented)
-     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise
+     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise (true is not implemented for "ffO4" and throws a \c dg::Error)
      */
     PolCharge(value_type alpha, std::vector<value_type> eps_gamma, const Geometry& g, norm no = not_normed, direction dir = forward, value_type jfactor=1., bool chi_weight_jump = false, std::string mode = "df", bool commute = false)
     {
-        construct(alpha, eps_gamma, g,  g.bcx(), g.bcy(), no, dir, jfactor, chi_weight_jump, mode);
+        construct(alpha, eps_gamma, g,  g.bcx(), g.bcy(), no, dir, jfactor, chi_weight_jump, mode, commute);
     }
     /**
      * @brief Construct from boundary conditions
@@ -56,11 +56,11 @@ class PolCharge
      * @param jfactor (\f$ = \alpha \f$ ) scale jump terms (1 is a good value but in some cases 0.1 or 0.01 might be better)
      * @param chi_weight_jump If true, the Jump terms are multiplied with the Chi matrix, else it is ignored
      * @param mode arbitrary wavelength polarization charge mode ("df" / "ff" / "ffO4" are implemented)
-     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise
+     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise (true is not implemented for "ffO4" and throws a \c dg::Error)
     */
     PolCharge( value_type alpha, std::vector<value_type> eps_gamma, const Geometry& g, bc bcx, bc bcy, norm no = not_normed, direction dir = forward, value_type jfactor=1., bool chi_weight_jump = false, std::string mode = "df", bool commute = false)
     { 
-         construct(alpha, eps_gamma, g,  bcx, bcy, no, dir, jfactor, chi_weight_jump, mode);
+         construct(alpha, eps_gamma, g,  bcx, bcy, no, dir, jfactor, chi_weight_jump, mode, commute);
     }
     /**
      * @brief Construct from boundary conditions
@@ -77,7 +77,7 @@ class PolCharge
      * @param jfactor (\f$ = \alpha \f$ ) scale jump terms (1 is a good value but in some cases 0.1 or 0.01 might be better)
      * @param chi_weight_jump If true, the Jump terms are multiplied with the Chi matrix, else it is ignored
      * @param mode arbitrary wavelength polarization charge mode ("df" / "ff" / "ffO4" are implemented)
-     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise
+     * @param commute false if Helmholtz operators (or their square root) are outside the elliptic or tensorelliptic operator and true otherwise (true is not implemented for "ffO4" and throws a \c dg::Error)
     */
     void construct(value_type alpha, std::vector<value_type> eps_gamma, const Geometry& g, bc bcx, bc bcy, norm no = not_normed, direction dir = forward, value_type jfactor=1., bool chi_weight_jump = false, std::string mode = "df", bool commute = false)
     {
@@ -85,11 +85,13 @@ class PolCharge
         m_eps_gamma = eps_gamma;
         m_mode = mode;
         m_commute = commute;
-        m_no = no,
+        m_no = no;
         m_temp2 = dg::evaluate(dg::zero, g);
         m_temp =  m_temp2;        
         m_temp2_ex.set_max(1, m_temp2);
         m_temp_ex.set_max(1, m_temp);
+        if (m_mode == "ffO4" && m_commute)
+            throw dg::Error( dg::Message(_ping_)<<"PolCharge: mode \"ffO4\" with commute=true is not implemented!");
         if (m_mode == "df")
         {
             m_ell.construct(g, bcx, bcy, m_no, dir, jfactor, chi_weight_jump );
@@ -103,19 +105,22 @@ class PolCharge
         if (m_mode == "ff")
         {
             m_ell.construct(g, bcx, bcy, m_no, dir, jfactor, chi_weight_jump );
-            m_multi_gamma.resize(1);
-            m_multi_gamma.resize(1);
-            m_multi_gamma[0].construct( g, bcx, bcy, m_alpha, dir, jfactor);
-            m_sqrtG0inv.construct(m_multi_gamma[0], g,  m_temp,  1e-14, 2000, 40, eps_gamma[0]);
-                        
-//             m_sqrtG0inv.construct(m_temp, g.size());
-            
-            value_type hxhy = g.lx()*g.ly()/(g.n()*g.n()*g.Nx()*g.Ny());
-            value_type max_weights =   dg::blas1::reduce(m_multi_gamma[0].weights(), 0., dg::AbsMax<double>() );
-            value_type min_weights =  -dg::blas1::reduce(m_multi_gamma[0].weights(), max_weights, dg::AbsMin<double>() );
-            value_type kappa = sqrt(max_weights/min_weights); //condition number of weight matrix
-            value_type EVmin = 1./(1.-m_multi_gamma[0].alpha()*hxhy*(1.0 + 1.0)); //EVs of Helmholtz
-            m_res_fac = kappa*sqrt(EVmin);
+            if (m_commute == false)
+            {
+                //eigenvalue bounds and Krylov workspace are set up once here
+                dg::Helmholtz<Geometry, Matrix, Container> gamma( g, bcx, bcy, m_alpha, dir, jfactor);
+                m_sqrtG0inv.construct(gamma, g,  m_temp,  1e-14, m_max_iter_sqrt, 40, eps_gamma[0]);
+            }
+            else
+            {
+                //both square roots combine to one Helmholtz inversion
+                m_multi_gamma.resize(3);
+                m_multi_g.construct(g, 3);
+                for( unsigned u=0; u<3; u++)
+                {
+                    m_multi_gamma[u].construct( m_multi_g.grid(u), bcx, bcy, m_alpha, dir, jfactor);
+                }
+            }
         }
         if (m_mode == "ffO4")
         {
@@ -181,14 +186,44 @@ class PolCharge
     }
     /**
      * @brief Set the commute
+     *
+     * In mode "ff" the solvers depend on commute and are only constructed
+     * for the value given in \c construct
      * @param commute Either true or false.
+     * @attention throws a \c dg::Error if the solvers for the new value of
+     * commute are not constructed (mode "ff") or not implemented (mode "ffO4")
      */
-    void set_commute( bool commute) {m_commute = commute;}
+    void set_commute( bool commute)
+    {
+        if (m_mode == "ffO4" && commute)
+            throw dg::Error( dg::Message(_ping_)<<"PolCharge: mode \"ffO4\" with commute=true is not implemented!");
+        if (m_mode == "ff" && commute != m_commute)
+            throw dg::Error( dg::Message(_ping_)<<"PolCharge: in mode \"ff\" construct the object with commute="<<std::boolalpha<<commute<<" instead!");
+        m_commute = commute;
+    }
     /**
      * @brief Get the current state of commute
      * @return Either true or false.
      */
     bool get_commute() const {return m_commute;}
+    /**
+     * @brief Iteration counts of the inner solves of the last operator application
+     *
+     * The entries depend on mode and commute:
+     *  - "df": the iterations of \c dg::MultigridCG2d::direct_solve on each
+     *  stage (finest first) of the Helmholtz inversion
+     *  - "ffO4" (\c commute=false): the same for both Helmholtz inversions,
+     *  in the order they are applied
+     *  - "ff" (\c commute=false): the number of M-CG iterations and of Cauchy
+     *  quadrature points for each of the two square root inversions, i.e.
+     *  <tt>{mcg_inner, cauchy_inner, mcg_outer, cauchy_outer}</tt>
+     *  - "ff" (\c commute=true): the multigrid stage iterations of the
+     *  single Helmholtz inversion
+     *
+     * Empty if \c alpha is zero
+     * @return number of iterations per stage
+     */
+    const std::vector<unsigned>& get_iter() const {return m_iter;}
     /**
      * @brief Return the vector missing in the un-normed symmetric matrix
      *
@@ -273,6 +308,7 @@ class PolCharge
 
         if (m_alpha == 0)
         {
+            m_iter.clear();
             if (m_mode == "ffO4")
             {
                 m_tensorell.symv(alpha, x, beta, y); //is not normed by default
@@ -287,8 +323,8 @@ class PolCharge
                 if (m_commute == false)
                 {
                     m_temp2_ex.extrapolate(m_temp2);
-                    std::vector<unsigned> number = m_multi_g.direct_solve( m_multi_gamma, m_temp2, x, m_eps_gamma);
-                    if(  number[0] == m_multi_g.max_iter())
+                    m_iter = m_multi_g.direct_solve( m_multi_gamma, m_temp2, x, m_eps_gamma);
+                    if(  m_iter[0] == m_multi_g.max_iter())
                         throw dg::Fail( m_eps_gamma[0]);
                     m_temp2_ex.update(m_temp2);
                     
@@ -301,8 +337,8 @@ class PolCharge
                         dg::blas1::pointwiseDot(m_temp, m_ell.inv_weights(), m_temp);    //temp should be normed
                     
                     m_temp2_ex.extrapolate(m_temp2);
-                    std::vector<unsigned> number = m_multi_g.direct_solve( m_multi_gamma, m_temp2, m_temp, m_eps_gamma);
-                    if(  number[0] == m_multi_g.max_iter())
+                    m_iter = m_multi_g.direct_solve( m_multi_gamma, m_temp2, m_temp, m_eps_gamma);
+                    if(  m_iter[0] == m_multi_g.max_iter())
                         throw dg::Fail( m_eps_gamma[0]);
                     m_temp2_ex.update(m_temp2);
                    
@@ -319,11 +355,11 @@ class PolCharge
             {     
                 if (m_commute == false)
                 {
+                    //M-CG tridiagonalization needs a zero initial guess
                     dg::blas1::scal(m_temp2, 0.0);
-
-                    std::array<unsigned,2> number = m_sqrtG0inv( m_temp2, x);  //m_temp2 is normed
-                    std::cout << "#number of sqrt iterations: " << number[0] << std::endl;
-//                     m_sqrtG0inv( m_temp2, x, dg::SQRT<double>(), m_multi_gamma[0], m_multi_gamma[0].inv_weights(), m_multi_gamma[0].weights(),  m_eps_gamma[0], m_res_fac);  //m_temp2 is normed
+                    std::array<unsigned,2> inner = m_sqrtG0inv( m_temp2, x);  //m_temp2 is normed
+                    if( inner[0] == m_max_iter_sqrt)
+                        throw dg::Fail( m_eps_gamma[0]);
         
                     m_ell.symv(1.0, m_temp2, 0.0, m_temp); //m_temp is not normed or not normed
                     
@@ -332,9 +368,10 @@ class PolCharge
                         dg::blas1::pointwiseDot(m_temp, m_ell.inv_weights(), m_temp);
                     
                     dg::blas1::scal(m_temp2, 0.0);
-                    number =m_sqrtG0inv( m_temp2, m_temp);  //m_temp2 is normed
-                    std::cout << "#number of sqrt iterations: " << number[0] << std::endl;
-//                     m_sqrtG0inv( m_temp2, m_temp, dg::SQRT<double>(), m_multi_gamma[0], m_multi_gamma[0].inv_weights(), m_multi_gamma[0].weights(),  m_eps_gamma[0], m_res_fac);  //m_temp2 is normed
+                    std::array<unsigned,2> outer = m_sqrtG0inv( m_temp2, m_temp);  //m_temp2 is normed
+                    if( outer[0] == m_max_iter_sqrt)
+                        throw dg::Fail( m_eps_gamma[0]);
+                    m_iter = {inner[0], inner[1], outer[0], outer[1]};
                     
                     if( m_no == normed)
                         dg::blas1::axpby(alpha, m_temp2, beta, y);  
@@ -344,7 +381,22 @@ class PolCharge
                 }
                 else
                 {
-                    //TODO not implemented so far (relevant thermal models)
+                    //Gamma_0^{-1/2} commutes with the elliptic operator:
+                    //both square roots combine to one Helmholtz inversion
+                    m_ell.symv(1.0, x, 0.0, m_temp);
+                    if (m_no == not_normed) 
+                        dg::blas1::pointwiseDot(m_temp, m_ell.inv_weights(), m_temp);
+                    
+                    m_temp2_ex.extrapolate(m_temp2);
+                    m_iter = m_multi_g.direct_solve( m_multi_gamma, m_temp2, m_temp, m_eps_gamma[0]);
+                    if(  m_iter[0] == m_multi_g.max_iter())
+                        throw dg::Fail( m_eps_gamma[0]);
+                    m_temp2_ex.update(m_temp2);
+                    
+                    if( m_no == normed)
+                        dg::blas1::axpby(alpha, m_temp2, beta, y);  
+                    if( m_no == not_normed)
+                        dg::blas1::pointwiseDot( alpha, m_temp2, m_ell.weights(), beta, y);   
                 }
             }
             if (m_mode == "ffO4")
@@ -352,8 +404,8 @@ class PolCharge
                 if (m_commute == false)
                 {      
                     m_temp2_ex.extrapolate(m_temp2);
-                    std::vector<unsigned> number = m_multi_g.direct_solve( m_multi_gamma, m_temp2, x, m_eps_gamma);
-                    if(  number[0] == m_multi_g.max_iter())
+                    m_iter = m_multi_g.direct_solve( m_multi_gamma, m_temp2, x, m_eps_gamma);
+                    if(  m_iter[0] == m_multi_g.max_iter())
                         throw dg::Fail( m_eps_gamma[0]);
                     m_temp2_ex.update(m_temp2);
 
@@ -362,20 +414,19 @@ class PolCharge
                         dg::blas1::pointwiseDot(m_temp, m_tensorell.inv_weights(), m_temp);
                     
                     m_temp_ex.extrapolate(m_temp2);
-                    number = m_multi_g.direct_solve( m_multi_gamma, m_temp2, m_temp, m_eps_gamma);
+                    std::vector<unsigned> number = m_multi_g.direct_solve( m_multi_gamma, m_temp2, m_temp, m_eps_gamma);
                     if(  number[0] == m_multi_g.max_iter())
                         throw dg::Fail( m_eps_gamma[0]);
                     m_temp_ex.update(m_temp2);
+                    m_iter.insert( m_iter.end(), number.begin(), number.end());
                     
                     if( m_no == normed)
                         dg::blas1::axpby(alpha, m_temp2, beta, y);  
                     if( m_no == not_normed)
                         dg::blas1::pointwiseDot( alpha, m_temp2, m_tensorell.weights(), beta, y); 
                 }
-                if (m_commute == true)
-                {
-                    //TODO not implemented so far (relevant thermal models)
-                }
+                else
+                    throw dg::Error( dg::Message(_ping_)<<"PolCharge: mode \"ffO4\" with commute=true is not implemented!");
             }
         }
     }
@@ -390,7 +441,9 @@ class PolCharge
 //     dg::KrylovFuncEigenInvert< Container> m_sqrtG0inv;        
     Container m_temp, m_temp2;
     norm m_no;
-    value_type  m_alpha,  m_res_fac;
+    value_type  m_alpha;
+    unsigned m_max_iter_sqrt = 2000;
+    std::vector<unsigned> m_iter;
     std::vector<value_type> m_eps_gamma;
     std::string m_mode;
     dg::Extrapolation<Container> m_temp2_ex, m_temp_ex;
@@ -123,6 +123,7 @@ int main()
         res.d = sqrt( dg::blas2::dot( w2d, error));
         std::cout << "    time: "<<t.diff() << "s \n";
         std::cout << "    iter:  "<<number<<std::endl;
+        std::cout << "    iter_gamma_last: "<<pol_df.get_iter()[0]<<std::endl;
         std::cout << "    error_abs: " << res.d<<" \n";
         std::cout << "    error_rel: " << sqrt( dg::blas2::dot( w2d, error)/ dg::blas2::dot( w2d, sol))<<std::endl;
         
@@ -217,6 +218,8 @@ int main()
         res.d = sqrt( dg::blas2::dot( w2d, error));
         std::cout << "    time: "<<t.diff() << "s \n";
         std::cout << "    iter:  "<<number<<std::endl;
+        std::cout << "    iter_sqrt_inner_last: "<<pol_ff.get_iter()[0]<<std::endl;
+        std::cout << "    iter_sqrt_outer_last: "<<pol_ff.get_iter()[2]<<std::endl;
         std::cout << "    error_abs: " << res.d<<std::endl;
         std::cout << "    error_rel: " << sqrt( dg::blas2::dot( w2d, error)/ dg::blas2::dot( w2d, sol_FF))<<std::endl;
         
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <fftw3.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+#include "backend/exceptions.h"
+#include "backend/typedefs.h"
+#include "blas2.h"
+#include "topology/grid.h"
+#include "topology/xspacelib.h"
+
+/*! @file
+  @brief Batched Fourier spectra of DG fields (link -lfftw3 and with OpenMP also -lfftw3_omp)
+  */
+namespace dg
+{
+
+/**
+ * @brief Time averaged Fourier spectra, cross-spectra and coherence of DG fields on a 2d grid
+ *
+ * The DG nodal data is converted to equidistant samples with the
+ * backscatter matrix of the grid (assembled once in the constructor). The
+ * samples of \c batch time steps of all fields are collected and transformed
+ * with a single batched real-to-complex 2d FFT (\c fftw_plan_many_dft_r2c).
+ * The squared moduli and the cross products of the Fourier coefficients are
+ * accumulated such that the averages over all time steps are available at
+ * any time and no time step needs to be kept in memory.
+ *
+ * The data is assumed to be periodic in x and y. The spectra are one-sided
+ * in x (\f$ 0\le m \le N_x/2\f$ with \f$ N_x = nN_x\f$ the number of
+ * equidistant points) and in FFTW order in y (negative wave numbers in the
+ * upper half). The coefficients are normalized by the number of points.
+ * @code
+dg::FFTSpectra2d spectra( grid, 2, 50, "wisdom.fftw");
+for( unsigned i=0; i<frames; i++)
+{
+    // read frame i into ne and phi
+    spectra.add( {&ne, &phi});
+}
+spectra.flush();
+dg::HVec Se = spectra.power_ky( 0), C = spectra.coherence_ky( 0, 1);
+ * @endcode
+ * @note With OpenMP FFTW is planned with \c omp_get_max_threads() threads
+ * (link \c -lfftw3_omp). Define \c _WITHOUT_FFTW_THREADS to use the serial FFTW.
+ * @attention Only double precision and shared memory vectors are supported
+ * @ingroup utilities
+ */
+struct FFTSpectra2d
+{
+    ///@brief No transforms
+    FFTSpectra2d() = default;
+    /**
+     * @brief Plan the transforms and allocate the buffers
+     *
+     * @param g The grid of the fields
+     * @param fields The number of fields to add at each time step
+     * @param batch The number of time steps that are transformed in one batch
+     * @param wisdom If not empty, the name of a file from which FFTW wisdom
+     * is read before and to which it is written after planning. Reusing the
+     * wisdom saves the planning time of subsequent runs on the same grid
+     * @param flags The FFTW planner flags
+     */
+    FFTSpectra2d( const aRealTopology2d<double>& g, unsigned fields, unsigned batch = 1, std::string wisdom = "", unsigned flags = FFTW_MEASURE)
+    {
+        construct( g, fields, batch, wisdom, flags);
+    }
+    ///@copydoc FFTSpectra2d(const aRealTopology2d<double>&,unsigned,unsigned,std::string,unsigned)
+    void construct( const aRealTopology2d<double>& g, unsigned fields, unsigned batch = 1, std::string wisdom = "", unsigned flags = FFTW_MEASURE)
+    {
+        if( fields == 0 || batch == 0)
+            throw dg::Error( dg::Message(_ping_)<<"FFTSpectra2d needs at least one field and a batch size of at least one!");
+        destroy();
+        m_equi = dg::create::backscatter( g);
+        m_Nx = g.n()*g.Nx(), m_Ny = g.n()*g.Ny(), m_Nkx = m_Nx/2+1;
+        m_lx = g.lx(), m_ly = g.ly();
+        m_fields = fields, m_batch = batch;
+        m_equidistant.resize( g.size());
+        m_in = fftw_alloc_real( m_batch*m_fields*m_Ny*m_Nx);
+        m_out = fftw_alloc_complex( m_batch*m_fields*m_Ny*m_Nkx);
+#if defined(_OPENMP) && !defined(_WITHOUT_FFTW_THREADS)
+        static bool threads_initialized = false;
+        if( !threads_initialized)
+            threads_initialized = fftw_init_threads();
+        fftw_plan_with_nthreads( omp_get_max_threads());
+#endif //_OPENMP
+        if( !wisdom.empty())
+            fftw_import_wisdom_from_filename( wisdom.data());
+        int n[2] = {(int)m_Ny, (int)m_Nx};
+        m_plan = fftw_plan_many_dft_r2c( 2, n, m_batch*m_fields,
+            m_in, nullptr, 1, m_Ny*m_Nx, m_out, nullptr, 1, m_Ny*m_Nkx, flags);
+        if( m_plan == nullptr)
+            throw dg::Error( dg::Message(_ping_)<<"FFTW planning failed!");
+        if( !wisdom.empty())
+            fftw_export_wisdom_to_filename( wisdom.data());
+        m_power.assign( m_fields, std::vector<double>( m_Ny*m_Nkx, 0.));
+        m_cross.assign( m_fields*(m_fields-1)/2,
+            std::vector<std::complex<double>>( m_Ny*m_Nkx, 0.));
+        m_filled = m_samples = 0;
+    }
+    FFTSpectra2d( const FFTSpectra2d&) = delete;
+    FFTSpectra2d& operator=( const FFTSpectra2d&) = delete;
+    ~FFTSpectra2d(){ destroy();}
+
+    /**
+     * @brief Add the fields of one time step
+     *
+     * The fields are converted to equidistant samples and buffered. Once
+     * \c batch time steps are buffered they are transformed and added to
+     * the averages.
+     * @param fields the fields on the grid given in the constructor
+     */
+    void add( const std::vector<const dg::HVec*>& fields)
+    {
+        if( fields.size() != m_fields)
+            throw dg::Error( dg::Message(_ping_)<<"FFTSpectra2d: "<<fields.size()<<" fields given but "<<m_fields<<" expected!");
+        for( unsigned f=0; f<m_fields; f++)
+        {
+            dg::blas2::symv( m_equi, *fields[f], m_equidistant);
+            double* in = m_in + (m_filled*m_fields + f)*m_Ny*m_Nx;
+            for( unsigned i=0; i<m_Ny*m_Nx; i++)
+                in[i] = m_equidistant[i];
+        }
+        m_filled++;
+        if( m_filled == m_batch)
+            transform();
+    }
+    ///@brief Transform the buffered time steps (of an incomplete batch) and add them to the averages
+    void flush(){
+        if( m_filled > 0)
+            transform();
+    }
+    ///@brief Set all averages to zero
+    void clear(){
+        for( auto& p : m_power)
+            std::fill( p.begin(), p.end(), 0.);
+        for( auto& c : m_cross)
+            std::fill( c.begin(), c.end(), 0.);
+        m_filled = m_samples = 0;
+    }
+
+    ///@brief The number of time steps in the averages (excluding the ones not yet flushed)
+    unsigned samples() const{ return m_samples;}
+    ///@brief The number of points in x
+    unsigned Nx() const{ return m_Nx;}
+    ///@brief The number of points in y
+    unsigned Ny() const{ return m_Ny;}
+    ///@brief The wave numbers \f$ 2\pi m/l_x\f$ of the one-sided x-spectra
+    dg::HVec kx() const{
+        dg::HVec k( m_Nkx);
+        for( unsigned m=0; m<m_Nkx; m++)
+            k[m] = 2.*M_PI*m/m_lx;
+        return k;
+    }
+    ///@brief The wave numbers of the y-spectra in FFTW order
+    dg::HVec ky() const{
+        dg::HVec k( m_Ny);
+        for( unsigned n=0; n<m_Ny; n++)
+            k[n] = 2.*M_PI*( n <= m_Ny/2 ? (double)n : (double)n - (double)m_Ny)/m_ly;
+        return k;
+    }
+    /**
+     * @brief The averaged 2d power spectrum \f$ \langle |\hat f(k_x,k_y)|^2\rangle\f$
+     * @param f index of the field
+     * @return \c Ny()*(Nx()/2+1) values, \f$ k_y\f$ is the slowest index
+     */
+    dg::HVec power2d( unsigned f) const{
+        dg::HVec p( m_power[f].begin(), m_power[f].end());
+        dg::blas1::scal( p, norm());
+        return p;
+    }
+    /**
+     * @brief The averaged cross-spectrum \f$ \langle \hat f_i \hat f_j^*\rangle\f$
+     * @param i index of the first field
+     * @param j index of the second field
+     * @return \c Ny()*(Nx()/2+1) values, \f$ k_y\f$ is the slowest index
+     */
+    std::vector<std::complex<double>> cross2d( unsigned i, unsigned j) const{
+        std::vector<std::complex<double>> c( m_Ny*m_Nkx);
+        const std::vector<std::complex<double>>& cross = m_cross[pair(i,j)];
+        for( unsigned k=0; k<c.size(); k++)
+            c[k] = norm()*( i < j ? cross[k] : std::conj( cross[k]));
+        return c;
+    }
+    ///@brief The power spectrum in \f$ k_x\f$ (summed over \f$k_y\f$)
+    dg::HVec power_kx( unsigned f) const{
+        dg::HVec p( m_Nkx, 0.);
+        for( unsigned n=0; n<m_Ny; n++)
+            for( unsigned m=0; m<m_Nkx; m++)
+                p[m] += norm()*m_power[f][n*m_Nkx+m];
+        return p;
+    }
+    ///@brief The power spectrum in \f$ k_y\f$ (summed over positive and negative \f$k_x\f$)
+    dg::HVec power_ky( unsigned f) const{
+        dg::HVec p( m_Ny, 0.);
+        for( unsigned n=0; n<m_Ny; n++)
+            for( unsigned m=0; m<m_Nkx; m++)
+                p[n] += fold(m)*norm()*m_power[f][n*m_Nkx+m];
+        return p;
+    }
+    ///@brief The cross-spectrum in \f$ k_x\f$ (summed over \f$k_y\f$)
+    std::vector<std::complex<double>> cross_kx( unsigned i, unsigned j) const{
+        std::vector<std::complex<double>> c2d = cross2d( i, j), c( m_Nkx, 0.);
+        for( unsigned n=0; n<m_Ny; n++)
+            for( unsigned m=0; m<m_Nkx; m++)
+                c[m] += c2d[n*m_Nkx+m];
+        return c;
+    }
+    ///@brief The cross-spectrum in \f$ k_y\f$ (summed over \f$k_x\f$)
+    std::vector<std::complex<double>> cross_ky( unsigned i, unsigned j) const{
+        std::vector<std::complex<double>> c2d = cross2d( i, j), c( m_Ny, 0.);
+        for( unsigned n=0; n<m_Ny; n++)
+            for( unsigned m=0; m<m_Nkx; m++)
+                c[n] += fold(m)*c2d[n*m_Nkx+m];
+        return c;
+    }
+    ///@brief The squared coherence \f$ |\langle \hat f_i \hat f_j^*\rangle|^2/(\langle|\hat f_i|^2\rangle\langle|\hat f_j|^2\rangle)\f$ in \f$ k_x\f$
+    dg::HVec coherence_kx( unsigned i, unsigned j) const{
+        return coherence( cross_kx( i, j), power_kx( i), power_kx( j));
+    }
+    ///@brief The squared coherence in \f$ k_y\f$
+    dg::HVec coherence_ky( unsigned i, unsigned j) const{
+        return coherence( cross_ky( i, j), power_ky( i), power_ky( j));
+    }
+    private:
+    void transform()
+    {
+        //zero the unused part of an incomplete batch
+        for( unsigned i=m_filled*m_fields*m_Ny*m_Nx; i<m_batch*m_fields*m_Ny*m_Nx; i++)
+            m_in[i] = 0.;
+        fftw_execute( m_plan);
+        const unsigned size = m_Ny*m_Nkx;
+        const double scale = 1./(double)m_Nx/(double)m_Ny;
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif //_OPENMP
+        for( int k=0; k<(int)size; k++)
+        for( unsigned b=0; b<m_filled; b++)
+        {
+            for( unsigned f=0; f<m_fields; f++)
+            {
+                const fftw_complex& c = m_out[(b*m_fields+f)*size + k];
+                m_power[f][k] += scale*scale*(c[0]*c[0] + c[1]*c[1]);
+            }
+            for( unsigned i=0; i<m_fields; i++)
+            for( unsigned j=i+1; j<m_fields; j++)
+            {
+                const fftw_complex& ci = m_out[(b*m_fields+i)*size + k];
+                const fftw_complex& cj = m_out[(b*m_fields+j)*size + k];
+                m_cross[pair(i,j)][k] += scale*scale*std::complex<double>(
+                    ci[0]*cj[0] + ci[1]*cj[1], ci[1]*cj[0] - ci[0]*cj[1]);
+            }
+        }
+        m_samples += m_filled;
+        m_filled = 0;
+    }
+    //index of the pair i<j in the upper triangle
+    unsigned pair( unsigned i, unsigned j) const{
+        if( i > j)
+            std::swap( i, j);
+        if( i == j || j >= m_fields)
+            throw dg::Error( dg::Message(_ping_)<<"FFTSpectra2d: invalid field pair ("<<i<<", "<<j<<")!");
+        return i*m_fields - i*(i+1)/2 + j - i - 1;
+    }
+    //weight of the one-sided kx modes in sums over kx
+    double fold( unsigned m) const{
+        return ( m == 0 || 2*m == m_Nx) ? 1. : 2.;
+    }
+    double norm() const{ return m_samples > 0 ? 1./(double)m_samples : 0.;}
+    static dg::HVec coherence( const std::vector<std::complex<double>>& c, const dg::HVec& pi, const dg::HVec& pj){
+        dg::HVec coh( c.size(), 0.);
+        for( unsigned k=0; k<c.size(); k++)
+            if( pi[k]*pj[k] > 0)
+                coh[k] = std::norm( c[k])/pi[k]/pj[k];
+        return coh;
+    }
+    void destroy(){
+        if( m_plan != nullptr)
+            fftw_destroy_plan( m_plan);
+        fftw_free( m_in);
+        fftw_free( m_out);
+        m_plan = nullptr, m_in = nullptr, m_out = nullptr;
+    }
+    dg::IHMatrix m_equi;
+    dg::HVec m_equidistant;
+    unsigned m_Nx = 0, m_Ny = 0, m_Nkx = 0;
+    double m_lx = 1, m_ly = 1;
+    unsigned m_fields = 0, m_batch = 0, m_filled = 0, m_samples = 0;
+    double* m_in = nullptr;
+    fftw_complex* m_out = nullptr;
+    fftw_plan m_plan = nullptr;
+    std::vector<std::vector<double>> m_power;
+    std::vector<std::vector<std::complex<double>>> m_cross;
+};
+
+}//namespace dg
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <iomanip>
+
+#include "blas.h"
+#include "topology/evaluation.h"
+#include "spectra.h"
+
+const double lx = 2.*M_PI, ly = 4.*M_PI;
+double function( double x, double y){ return sin( 2.*2.*M_PI*x/lx)*cos( 3.*2.*M_PI*y/ly);}
+
+int main()
+{
+    std::cout << "This program tests the batched Fourier spectra\n";
+    dg::Grid2d g( 0, lx, 0, ly, 3, 32, 32, dg::PER, dg::PER);
+    unsigned NT = 7;
+    dg::FFTSpectra2d spectra( g, 2, 3, "", FFTW_ESTIMATE);
+    const dg::HVec f = dg::evaluate( function, g);
+    dg::HVec ft( f), gt( f);
+    for( unsigned i=0; i<NT; i++)
+    {
+        dg::blas1::axpby( cos( 0.3*i), f, 0., ft);
+        dg::blas1::axpby( 2.*cos( 0.3*i), f, 0., gt);
+        spectra.add( {&ft, &gt});
+    }
+    spectra.flush();
+    std::cout << "Number of samples "<<spectra.samples()<<" ("<<NT<<")\n";
+    double mean = 0;
+    for( unsigned i=0; i<NT; i++)
+        mean += cos( 0.3*i)*cos( 0.3*i)/(double)NT;
+    dg::HVec px = spectra.power_kx( 0), py = spectra.power_ky( 0);
+    dg::HVec kx = spectra.kx(), ky = spectra.ky();
+    double total_x = 0, total_y = 0;
+    for( unsigned i=0; i<px.size(); i++)
+        total_x += i == 0 ? px[i] : 2.*px[i];
+    for( unsigned i=0; i<py.size(); i++)
+        total_y += py[i];
+    std::cout << std::setprecision(6);
+    std::cout << "kx[2] "<<kx[2]<<" (2) ky[3] "<<ky[3]<<" (1.5)\n";
+    std::cout << "Power at kx[2] "<<px[2]/mean<<" (0.125)\n";
+    std::cout << "Power at ky[3] "<<py[3]/mean<<" (0.125)\n";
+    std::cout << "Total power in x "<<total_x/mean<<" (0.25)\n";
+    std::cout << "Total power in y "<<total_y/mean<<" (0.25)\n";
+    dg::HVec coh = spectra.coherence_kx( 0, 1);
+    std::cout << "Coherence at kx[2] "<<coh[2]<<" (1)\n";
+    std::vector<std::complex<double>> cross = spectra.cross_ky( 0, 1);
+    std::cout << "Cross-spectrum at ky[3] "<<cross[3]/mean<<" ((0.25,0))\n";
+    return 0;
+}
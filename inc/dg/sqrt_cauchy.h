@@ -4,6 +4,7 @@
 #include <boost/math/special_functions.hpp>
 
 #include "blas.h"
+#include "cg.h"
 #include "lgmres.h"
 
 //! M_PI is non-standard ... so MSVC complains
@@ -167,6 +168,11 @@ struct TensorTraits< SqrtCauchyIntOp< Matrix, Container> >
  * A is the matrix, x is the vector, w is a scalar m is the smallest eigenvalue of A, K' is the conjuated complete  elliptic integral and \f$c_j\f$ and \f$d_j\f$ are the jacobi functions 
  * 
  *This class is based on the approach (method 3) of the paper <a href="https://doi.org/10.1137/070700607" > Computing A alpha log(A), and Related Matrix Functions by Contour Integrals </a>  by N. Hale et al
+ *
+ * For symmetric A all shifted systems are solved at once with \c dg::MultiShiftCG,
+ * which needs one application of A per iteration independent of the number of
+ * quadrature nodes (and memory for one vector per node).
+ * Non-symmetric A are solved node by node with \c dg::LGMRES
  * 
  * @ingroup matrixfunctionapproximation
  *
@@ -211,7 +217,8 @@ struct SqrtCauchyInt
         m_size = m_helper.size();
         m_number = 0;
         m_op.construct(m_A, m_helper, m_multiply_weights);
-        if (m_symmetric == true) m_pcg.construct( m_helper, m_size*m_size+1);
+        m_ones = m_op.precond();
+        if (m_symmetric == true) m_mscg.construct( m_helper, m_size*m_size+1);
         else m_lgmres.construct( m_helper, 300, 100, 10*m_size*m_size);
         m_temp_ex.set_max(1, copyable);
     }
@@ -224,9 +231,10 @@ struct SqrtCauchyInt
         m_helper.resize(new_max);
         m_temp.resize(new_max);
         m_helper3.resize(new_max);
-        if (m_symmetric == true)  m_pcg.construct( m_helper, new_max*new_max+1);
+        if (m_symmetric == true)  m_mscg.construct( m_helper, new_max*new_max+1);
         else m_lgmres.construct( m_helper, 300, 100, 10*new_max*new_max);
         m_op.new_size(new_max);
+        m_ones = m_op.precond();
         m_temp_ex.set_max(1, m_temp);
         m_size = new_max;
     } 
@@ -287,6 +295,7 @@ struct SqrtCauchyInt
         const value_type sqrt1mk2 = sqrt(1.-k2);
         const value_type Ks=boost::math::ellint_1(sqrt1mk2 );
         const value_type fac = 2.* Ks*sqrtminEV/(M_PI*iter);
+        m_shifts.resize( iter), m_coeffs.resize( iter);
         for (unsigned j=1; j<iter+1; j++)
         {
             t  = (j-0.5)*Ks/iter; //imaginary part .. 1i missing
@@ -294,36 +303,51 @@ struct SqrtCauchyInt
             s = boost::math::jacobi_sn(sqrt1mk2, t)*c;
             d = boost::math::jacobi_dn(sqrt1mk2, t)*c;
             w = sqrtminEV*s;
-            if (m_multiply_weights == true) 
-                dg::blas2::symv(c*d, m_op.weights(), x, 0.0 , m_helper); //m_helper = c d x
-            else 
-                dg::blas1::axpby(c*d, x, 0.0 , m_helper); //m_helper = c d x
-            m_op.set_w(w);
-            m_temp_ex.extrapolate(t, m_temp);
-
-            if (m_symmetric == true) 
+            m_shifts[j-1] = w*w;
+            m_coeffs[j-1] = fac*c*d;
+        }
+        if (m_symmetric == true)
+        {
+            // m_helper3 = fac sum c d (w^2 +V A)^(-1) x from a single Krylov sequence
+            if (m_multiply_weights == true)
             {
-                m_number = m_pcg( m_op, m_temp, m_helper, m_op.inv_weights(), m_op.weights(), m_eps); // m_temp = (w^2 +V A)^(-1) c d x
-                if(  m_number == m_pcg.get_max()) throw dg::Fail( m_eps);
+                dg::blas1::pointwiseDot( m_op.weights(), x, m_helper); //m_helper = W x
+                m_number = m_mscg( m_A, m_helper3, m_helper, m_shifts, m_coeffs, m_op.inv_weights(), m_op.weights(), m_eps);
             }
-            else 
+            else
+                m_number = m_mscg( m_A, m_helper3, x, m_shifts, m_coeffs, m_ones, m_op.weights(), m_eps);
+            if(  m_number == m_mscg.get_max()) throw dg::Fail( m_eps);
+        }
+        else
+        {
+            for (unsigned j=0; j<iter; j++)
+            {
+                t  = (j+0.5)*Ks/iter;
+                if (m_multiply_weights == true) 
+                    dg::blas2::symv(m_coeffs[j]/fac, m_op.weights(), x, 0.0 , m_helper); //m_helper = c d x
+                else 
+                    dg::blas1::axpby(m_coeffs[j]/fac, x, 0.0 , m_helper); //m_helper = c d x
+                m_op.set_w(sqrt(m_shifts[j]));
+                m_temp_ex.extrapolate(t, m_temp);
                 m_lgmres.solve( m_op, m_temp, m_helper, m_op.inv_weights(), m_op.weights(), m_eps, 1); 
-            m_temp_ex.update(t, m_temp);
+                m_temp_ex.update(t, m_temp);
 
-            dg::blas1::axpby(fac, m_temp, 1.0, m_helper3); // m_helper3 += -fac  (w^2 +V A)^(-1) c d x
+                dg::blas1::axpby(fac, m_temp, 1.0, m_helper3); // m_helper3 += -fac  (w^2 +V A)^(-1) c d x
+            }
         }
         dg::blas2::symv(m_A, m_helper3, b); // - A fac sum (w^2 +V A)^(-1) c d x
         if (m_multiply_weights == true) dg::blas1::pointwiseDot(m_op.inv_weights(),  b, b);  // fac V A (-w^2 I -V A)^(-1) c d x
 
     }
   private:
-    Container m_helper, m_temp, m_helper3;
+    Container m_helper, m_temp, m_helper3, m_ones;
     Matrix m_A;
     SqrtCauchyIntOp< Matrix, Container> m_op;
     unsigned m_size, m_number;
     bool m_multiply_weights, m_symmetric;
     value_type m_eps;
-    dg::CG<Container> m_pcg;
+    dg::MultiShiftCG<Container> m_mscg;
+    std::vector<value_type> m_shifts, m_coeffs;
     dg::LGMRES<Container> m_lgmres;
     dg::Extrapolation<Container> m_temp_ex;
 };
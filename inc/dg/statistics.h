@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <thrust/host_vector.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+#include "backend/exceptions.h"
+#ifdef MPI_VERSION
+#include "backend/mpi_vector.h"
+#endif //MPI_VERSION
+
+/*! @file
+  @brief Streaming histograms, probability density functions and moments
+  */
+namespace dg
+{
+///@cond
+namespace detail
+{
+//bin 0 is the underflow and bin N+1 the overflow bin
+template<class real_type>
+inline unsigned stat_bin( real_type x, real_type x0, real_type x1, real_type inv_h, unsigned N)
+{
+    if( !(x >= x0)) //also catches NaN
+        return 0;
+    if( x >= x1)
+        return N+1;
+    return 1 + std::min( (unsigned)((x-x0)*inv_h), N-1);
+}
+#ifdef MPI_VERSION
+template<class real_type>
+void stat_allreduce( std::vector<real_type>& v, MPI_Comm comm)
+{
+    std::vector<real_type> receive( v.size());
+    MPI_Allreduce( v.data(), receive.data(), v.size(),
+        getMPIDataType<real_type>(), MPI_SUM, comm);
+    v.swap( receive);
+}
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
+///@addtogroup utilities
+///@{
+
+/**
+ * @brief A streaming, thread-parallel histogram and probability density function
+ *
+ * In contrast to \c dg::Histogram the data is not copied and not needed
+ * all at once: every call to \c add bins a new sample (e.g. one output frame
+ * read from a file) and adds its counts to the ones of all previous calls.
+ * With OpenMP every thread bins into private counts, which are merged at the
+ * end of each call. In MPI the counts of all processes are summed up such
+ * that all processes hold the global histogram.
+ *
+ * Values below \c x0 and above (or equal) \c x1 are counted in separate
+ * under- and overflow counters.
+ * @code
+dg::StreamingHistogram<double> hist( -4., 4., 100);
+for( unsigned i=0; i<frames; i++)
+{
+    // read frame i into field
+    hist.add( field, weights); // weights, e.g. dg::create::weights(grid)
+}
+thrust::host_vector<double> pdf = hist.pdf(), x = hist.abscissas();
+ * @endcode
+ * @tparam real_type The value type of the samples and the counts
+ */
+template<class real_type>
+struct StreamingHistogram
+{
+    using value_type = real_type;
+    ///@brief Empty histogram
+    StreamingHistogram() = default;
+    /**
+     * @brief Construct equidistant bins
+     *
+     * @param x0 Left boundary of the first bin
+     * @param x1 Right boundary of the last bin
+     * @param bins Number of bins
+     */
+    StreamingHistogram( real_type x0, real_type x1, unsigned bins)
+    {
+        construct( x0, x1, bins);
+    }
+    ///@copydoc StreamingHistogram(real_type,real_type,unsigned)
+    void construct( real_type x0, real_type x1, unsigned bins)
+    {
+        if( bins == 0 || !(x1 > x0))
+            throw dg::Error( dg::Message(_ping_)<<"StreamingHistogram needs x1 > x0 and at least one bin! ("<<x0<<", "<<x1<<", "<<bins<<")");
+        m_x0 = x0, m_x1 = x1, m_bins = bins;
+        m_h = (x1-x0)/(real_type)bins;
+        m_counts.assign( bins+2, 0);
+    }
+    ///@brief Set all counts to zero
+    void clear() { m_counts.assign( m_bins+2, 0);}
+
+    /**
+     * @brief Bin all values of a sample
+     *
+     * @param x the sample
+     */
+    void add( const thrust::host_vector<real_type>& x)
+    {
+        count( x.data(), (const real_type*)nullptr, x.size());
+    }
+    /**
+     * @brief Bin all values of a sample with weights
+     *
+     * Each value adds its weight to its bin instead of one. Use the volume
+     * form of the grid to weight the values of a DG field.
+     * @param x the sample
+     * @param w the weights (same size as \c x)
+     */
+    void add( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& w)
+    {
+        count( x.data(), w.data(), x.size());
+    }
+#ifdef MPI_VERSION
+    ///@copydoc add(const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x)
+    {
+        std::vector<real_type> sample = count( x.data().data(), (const real_type*)nullptr, x.size(), false);
+        merge( sample, x.communicator());
+    }
+    ///@copydoc add(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x, const MPI_Vector<thrust::host_vector<real_type>>& w)
+    {
+        std::vector<real_type> sample = count( x.data().data(), w.data().data(), x.size(), false);
+        merge( sample, x.communicator());
+    }
+#endif //MPI_VERSION
+
+    ///@brief Number of bins
+    unsigned bins() const { return m_bins;}
+    ///@brief The bin width
+    real_type binwidth() const { return m_h;}
+    ///@brief The sum of all counts (including under- and overflow)
+    real_type total() const {
+        real_type sum = 0;
+        for( auto c : m_counts)
+            sum += c;
+        return sum;
+    }
+    ///@brief The counts of values smaller than \c x0
+    real_type underflow() const { return m_counts[0];}
+    ///@brief The counts of values larger than or equal to \c x1
+    real_type overflow() const { return m_counts[m_bins+1];}
+    ///@brief The midpoints of the bins
+    thrust::host_vector<real_type> abscissas() const {
+        thrust::host_vector<real_type> x( m_bins);
+        for( unsigned i=0; i<m_bins; i++)
+            x[i] = m_x0 + ((real_type)i+0.5)*m_h;
+        return x;
+    }
+    ///@brief The (weighted) number of values in each bin
+    thrust::host_vector<real_type> counts() const {
+        return thrust::host_vector<real_type>( m_counts.begin()+1, m_counts.end()-1);
+    }
+    /**
+     * @brief The probability density function
+     *
+     * The counts are divided by the total counts and the bin width, such
+     * that the pdf integrates to the fraction of values in \c [x0,x1)
+     * @return pdf in each bin
+     */
+    thrust::host_vector<real_type> pdf() const {
+        thrust::host_vector<real_type> p = counts();
+        real_type norm = total()*m_h;
+        if( norm > 0)
+            for( unsigned i=0; i<m_bins; i++)
+                p[i] /= norm;
+        return p;
+    }
+    private:
+    std::vector<real_type> count( const real_type* x, const real_type* w, unsigned size, bool add_to_counts = true)
+    {
+        std::vector<real_type> result( m_bins+2, 0);
+        const real_type inv_h = 1./m_h;
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif //_OPENMP
+        {
+            std::vector<real_type> local( m_bins+2, 0);
+#ifdef _OPENMP
+            #pragma omp for nowait
+#endif //_OPENMP
+            for( int i=0; i<(int)size; i++)
+                local[detail::stat_bin( x[i], m_x0, m_x1, inv_h, m_bins)] += w ? w[i] : 1;
+#ifdef _OPENMP
+            #pragma omp critical
+#endif //_OPENMP
+            for( unsigned b=0; b<m_bins+2; b++)
+                result[b] += local[b];
+        }
+        if( add_to_counts)
+            for( unsigned b=0; b<m_bins+2; b++)
+                m_counts[b] += result[b];
+        return result;
+    }
+#ifdef MPI_VERSION
+    void merge( std::vector<real_type>& sample, MPI_Comm comm)
+    {
+        detail::stat_allreduce( sample, comm);
+        for( unsigned b=0; b<m_bins+2; b++)
+            m_counts[b] += sample[b];
+    }
+#endif //MPI_VERSION
+    real_type m_x0 = 0, m_x1 = 1, m_h = 1;
+    unsigned m_bins = 0;
+    std::vector<real_type> m_counts;
+};
+
+/**
+ * @brief A streaming, thread-parallel joint histogram and probability density function of two samples
+ *
+ * Works like \c dg::StreamingHistogram for pairs of values \f$ (x_i, y_i)\f$.
+ * Pairs where one value lies outside its range are counted in \c outliers().
+ * @tparam real_type The value type of the samples and the counts
+ */
+template<class real_type>
+struct StreamingHistogram2d
+{
+    using value_type = real_type;
+    ///@brief Empty histogram
+    StreamingHistogram2d() = default;
+    /**
+     * @brief Construct equidistant bins
+     *
+     * @param x0 Left boundary of the first bin in x
+     * @param x1 Right boundary of the last bin in x
+     * @param Nx Number of bins in x
+     * @param y0 Left boundary of the first bin in y
+     * @param y1 Right boundary of the last bin in y
+     * @param Ny Number of bins in y
+     */
+    StreamingHistogram2d( real_type x0, real_type x1, unsigned Nx, real_type y0, real_type y1, unsigned Ny)
+    {
+        construct( x0, x1, Nx, y0, y1, Ny);
+    }
+    ///@copydoc StreamingHistogram2d(real_type,real_type,unsigned,real_type,real_type,unsigned)
+    void construct( real_type x0, real_type x1, unsigned Nx, real_type y0, real_type y1, unsigned Ny)
+    {
+        if( Nx == 0 || Ny == 0 || !(x1 > x0) || !(y1 > y0))
+            throw dg::Error( dg::Message(_ping_)<<"StreamingHistogram2d needs x1 > x0, y1 > y0 and at least one bin in each direction!");
+        m_x0 = x0, m_x1 = x1, m_y0 = y0, m_y1 = y1, m_Nx = Nx, m_Ny = Ny;
+        m_hx = (x1-x0)/(real_type)Nx, m_hy = (y1-y0)/(real_type)Ny;
+        clear();
+    }
+    ///@brief Set all counts to zero
+    void clear() { m_counts.assign( m_Nx*m_Ny+1, 0);}
+
+    /**
+     * @brief Bin all pairs of a sample
+     *
+     * @param x the x-values of the sample
+     * @param y the y-values of the sample (same size as \c x)
+     */
+    void add( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& y)
+    {
+        count( x.data(), y.data(), (const real_type*)nullptr, x.size());
+    }
+    /**
+     * @brief Bin all pairs of a sample with weights
+     *
+     * @param x the x-values of the sample
+     * @param y the y-values of the sample (same size as \c x)
+     * @param w the weights (same size as \c x)
+     */
+    void add( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& y, const thrust::host_vector<real_type>& w)
+    {
+        count( x.data(), y.data(), w.data(), x.size());
+    }
+#ifdef MPI_VERSION
+    ///@copydoc add(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x, const MPI_Vector<thrust::host_vector<real_type>>& y)
+    {
+        std::vector<real_type> sample = count( x.data().data(), y.data().data(), (const real_type*)nullptr, x.size(), false);
+        merge( sample, x.communicator());
+    }
+    ///@copydoc add(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x, const MPI_Vector<thrust::host_vector<real_type>>& y, const MPI_Vector<thrust::host_vector<real_type>>& w)
+    {
+        std::vector<real_type> sample = count( x.data().data(), y.data().data(), w.data().data(), x.size(), false);
+        merge( sample, x.communicator());
+    }
+#endif //MPI_VERSION
+
+    ///@brief Number of bins in x
+    unsigned binsX() const { return m_Nx;}
+    ///@brief Number of bins in y
+    unsigned binsY() const { return m_Ny;}
+    ///@brief The bin width in x
+    real_type binwidthX() const { return m_hx;}
+    ///@brief The bin width in y
+    real_type binwidthY() const { return m_hy;}
+    ///@brief The sum of all counts (including outliers)
+    real_type total() const {
+        real_type sum = 0;
+        for( auto c : m_counts)
+            sum += c;
+        return sum;
+    }
+    ///@brief The counts of pairs with at least one value outside its range
+    real_type outliers() const { return m_counts[m_Nx*m_Ny];}
+    ///@brief The (weighted) number of pairs in each bin (y is the slowest index)
+    thrust::host_vector<real_type> counts() const {
+        return thrust::host_vector<real_type>( m_counts.begin(), m_counts.end()-1);
+    }
+    /**
+     * @brief The joint probability density function
+     *
+     * The counts are divided by the total counts and the bin area
+     * @return pdf in each bin (y is the slowest index)
+     */
+    thrust::host_vector<real_type> pdf() const {
+        thrust::host_vector<real_type> p = counts();
+        real_type norm = total()*m_hx*m_hy;
+        if( norm > 0)
+            for( unsigned i=0; i<m_Nx*m_Ny; i++)
+                p[i] /= norm;
+        return p;
+    }
+    private:
+    std::vector<real_type> count( const real_type* x, const real_type* y, const real_type* w, unsigned size, bool add_to_counts = true)
+    {
+        const unsigned num = m_Nx*m_Ny;
+        std::vector<real_type> result( num+1, 0);
+        const real_type inv_hx = 1./m_hx, inv_hy = 1./m_hy;
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif //_OPENMP
+        {
+            std::vector<real_type> local( num+1, 0);
+#ifdef _OPENMP
+            #pragma omp for nowait
+#endif //_OPENMP
+            for( int i=0; i<(int)size; i++)
+            {
+                unsigned bx = detail::stat_bin( x[i], m_x0, m_x1, inv_hx, m_Nx);
+                unsigned by = detail::stat_bin( y[i], m_y0, m_y1, inv_hy, m_Ny);
+                unsigned bin = num;
+                if( bx != 0 && bx != m_Nx+1 && by != 0 && by != m_Ny+1)
+                    bin = (by-1)*m_Nx + bx-1;
+                local[bin] += w ? w[i] : 1;
+            }
+#ifdef _OPENMP
+            #pragma omp critical
+#endif //_OPENMP
+            for( unsigned b=0; b<num+1; b++)
+                result[b] += local[b];
+        }
+        if( add_to_counts)
+            for( unsigned b=0; b<num+1; b++)
+                m_counts[b] += result[b];
+        return result;
+    }
+#ifdef MPI_VERSION
+    void merge( std::vector<real_type>& sample, MPI_Comm comm)
+    {
+        detail::stat_allreduce( sample, comm);
+        for( unsigned b=0; b<sample.size(); b++)
+            m_counts[b] += sample[b];
+    }
+#endif //MPI_VERSION
+    real_type m_x0 = 0, m_x1 = 1, m_y0 = 0, m_y1 = 1, m_hx = 1, m_hy = 1;
+    unsigned m_Nx = 0, m_Ny = 0;
+    std::vector<real_type> m_counts;
+};
+
+/**
+ * @brief Streaming mean, variance, skewness and kurtosis
+ *
+ * Every call to \c add computes the (weighted) mean and the central moments
+ * of a new sample in two thread-parallel passes and merges them with the
+ * moments of all previous samples with the pairwise update formulas of
+ * Chan et al. and Pébay (2008). This avoids the cancellation of the naive
+ * summation of powers and needs no storage of previous samples.
+ * In MPI the moments of a sample are reduced over all processes.
+ * @code
+dg::StreamingMoments<double> moments;
+for( unsigned i=0; i<frames; i++)
+{
+    // read frame i into field
+    moments.add( field);
+}
+std::cout << moments.mean() << " "<<moments.stddev()<<"\n";
+ * @endcode
+ * @tparam real_type The value type of the samples and the moments
+ */
+template<class real_type>
+struct StreamingMoments
+{
+    using value_type = real_type;
+    ///@brief No values
+    StreamingMoments() = default;
+    ///@brief Forget all values
+    void clear() { m_w = m_mean = m_M2 = m_M3 = m_M4 = 0;}
+    /**
+     * @brief Add all values of a sample
+     * @param x the sample
+     */
+    void add( const thrust::host_vector<real_type>& x)
+    {
+        sample( x.data(), (const real_type*)nullptr, x.size());
+    }
+    /**
+     * @brief Add all values of a sample with weights
+     * @param x the sample
+     * @param w the weights (same size as \c x)
+     */
+    void add( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& w)
+    {
+        sample( x.data(), w.data(), x.size());
+    }
+#ifdef MPI_VERSION
+    ///@copydoc add(const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x)
+    {
+        sample( x.data().data(), (const real_type*)nullptr, x.size(), x.communicator());
+    }
+    ///@copydoc add(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&)
+    ///@note collective call
+    void add( const MPI_Vector<thrust::host_vector<real_type>>& x, const MPI_Vector<thrust::host_vector<real_type>>& w)
+    {
+        sample( x.data().data(), w.data().data(), x.size(), x.communicator());
+    }
+#endif //MPI_VERSION
+    ///@brief The sum of all weights (the number of values without weights)
+    real_type weight() const { return m_w;}
+    ///@brief The mean
+    real_type mean() const { return m_mean;}
+    ///@brief The (biased) variance \f$ \langle (x-\bar x)^2\rangle\f$
+    real_type variance() const { return m_w > 0 ? m_M2/m_w : 0;}
+    ///@brief The standard deviation
+    real_type stddev() const { return sqrt( variance());}
+    ///@brief The skewness \f$ \langle (x-\bar x)^3\rangle / \sigma^3\f$
+    real_type skewness() const { return m_M2 > 0 ? sqrt( m_w)*m_M3/pow( m_M2, 1.5) : 0;}
+    ///@brief The kurtosis \f$ \langle (x-\bar x)^4\rangle / \sigma^4\f$ (3 for a normal distribution)
+    real_type kurtosis() const { return m_M2 > 0 ? m_w*m_M4/m_M2/m_M2 : 0;}
+    private:
+    //returns (sum w, sum wx) or (sum w d^2, sum w d^3, sum w d^4) with d = x-mean
+    template<unsigned N>
+    std::vector<real_type> sums( const real_type* x, const real_type* w, unsigned size, real_type mean) const
+    {
+        std::vector<real_type> result( N, 0);
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif //_OPENMP
+        {
+            std::vector<real_type> local( N, 0);
+#ifdef _OPENMP
+            #pragma omp for nowait
+#endif //_OPENMP
+            for( int i=0; i<(int)size; i++)
+            {
+                real_type weight = w ? w[i] : 1;
+                if( N == 2)
+                {
+                    local[0] += weight;
+                    local[1] += weight*x[i];
+                }
+                else
+                {
+                    real_type d = x[i]-mean, d2 = d*d;
+                    local[0] += weight*d2;
+                    local[1] += weight*d2*d;
+                    local[2] += weight*d2*d2;
+                }
+            }
+#ifdef _OPENMP
+            #pragma omp critical
+#endif //_OPENMP
+            for( unsigned k=0; k<N; k++)
+                result[k] += local[k];
+        }
+        return result;
+    }
+    void sample( const real_type* x, const real_type* w, unsigned size)
+    {
+        std::vector<real_type> s = sums<2>( x, w, size, 0);
+        if( s[0] == 0)
+            return;
+        real_type mean = s[1]/s[0];
+        std::vector<real_type> m = sums<3>( x, w, size, mean);
+        merge( s[0], mean, m[0], m[1], m[2]);
+    }
+#ifdef MPI_VERSION
+    void sample( const real_type* x, const real_type* w, unsigned size, MPI_Comm comm)
+    {
+        std::vector<real_type> s = sums<2>( x, w, size, 0);
+        detail::stat_allreduce( s, comm);
+        if( s[0] == 0)
+            return;
+        real_type mean = s[1]/s[0];
+        std::vector<real_type> m = sums<3>( x, w, size, mean);
+        detail::stat_allreduce( m, comm);
+        merge( s[0], mean, m[0], m[1], m[2]);
+    }
+#endif //MPI_VERSION
+    void merge( real_type wb, real_type meanb, real_type M2b, real_type M3b, real_type M4b)
+    {
+        const real_type wa = m_w, w = wa + wb;
+        const real_type d = meanb - m_mean, d2 = d*d;
+        m_M4 = m_M4 + M4b + d2*d2*wa*wb*(wa*wa - wa*wb + wb*wb)/(w*w*w)
+            + 6.*d2*(wa*wa*M2b + wb*wb*m_M2)/(w*w) + 4.*d*(wa*M3b - wb*m_M3)/w;
+        m_M3 = m_M3 + M3b + d2*d*wa*wb*(wa - wb)/(w*w)
+            + 3.*d*(wa*M2b - wb*m_M2)/w;
+        m_M2 = m_M2 + M2b + d2*wa*wb/w;
+        m_mean = m_mean + d*wb/w;
+        m_w = w;
+    }
+    real_type m_w = 0, m_mean = 0, m_M2 = 0, m_M3 = 0, m_M4 = 0;
+};
+///@}
+
+}//namespace dg
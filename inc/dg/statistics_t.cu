@@ -0,0 +1,59 @@
+#include <iostream>
+#include <iomanip>
+
+#include <thrust/random.h>
+#include "statistics.h"
+
+int main()
+{
+    std::cout << "This program tests the streaming histograms and moments\n";
+    unsigned frames = 10, size = 10000;
+    thrust::random::minstd_rand generator;
+    thrust::random::normal_distribution<double> normal;
+    thrust::host_vector<double> all( frames*size);
+    for( unsigned i=0; i<frames*size; i++)
+        all[i] = 2.*normal( generator) + 1.;
+
+    dg::StreamingHistogram<double> hist( -4., 4., 40), hist_all( -4., 4., 40);
+    dg::StreamingHistogram2d<double> joint( -4., 4., 20, -4., 4., 20);
+    dg::StreamingMoments<double> moments;
+    thrust::host_vector<double> frame( size), shifted( size);
+    for( unsigned k=0; k<frames; k++)
+    {
+        for( unsigned i=0; i<size; i++)
+            frame[i] = all[k*size+i], shifted[i] = -frame[i];
+        hist.add( frame);
+        joint.add( frame, shifted);
+        moments.add( frame);
+    }
+    hist_all.add( all);
+
+    double diff = 0;
+    thrust::host_vector<double> c = hist.counts(), c_all = hist_all.counts();
+    for( unsigned i=0; i<hist.bins(); i++)
+        diff += fabs( c[i] - c_all[i]);
+    std::cout << "Difference streamed to at once    "<<diff<<" (0)\n";
+    thrust::host_vector<double> pdf = hist.pdf();
+    double integral = 0;
+    for( unsigned i=0; i<hist.bins(); i++)
+        integral += pdf[i]*hist.binwidth();
+    std::cout << "Integral of pdf plus outliers     "<<integral + (hist.underflow()+hist.overflow())/hist.total()<<" (1)\n";
+    std::cout << "Total count of joint pdf          "<<joint.total()<<" ("<<frames*size<<")\n";
+
+    double mean = 0, var = 0, m3 = 0, m4 = 0;
+    for( unsigned i=0; i<all.size(); i++)
+        mean += all[i];
+    mean /= (double)all.size();
+    for( unsigned i=0; i<all.size(); i++)
+    {
+        double d = all[i]-mean;
+        var += d*d, m3 += d*d*d, m4 += d*d*d*d;
+    }
+    var /= (double)all.size(), m3 /= (double)all.size(), m4 /= (double)all.size();
+    std::cout << std::setprecision(12);
+    std::cout << "Mean     "<<moments.mean()<<" ("<<mean<<")\n";
+    std::cout << "Variance "<<moments.variance()<<" ("<<var<<")\n";
+    std::cout << "Skewness "<<moments.skewness()<<" ("<<m3/pow(var,1.5)<<")\n";
+    std::cout << "Kurtosis "<<moments.kurtosis()<<" ("<<m4/var/var<<")\n";
+    return 0;
+}
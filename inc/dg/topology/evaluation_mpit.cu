@@ -81,6 +81,14 @@ int main(int argc, char** argv)
     double solution3d = (exp(4.)-exp(2))/2.*(exp(8.)-exp(6.))/2.*(exp(12.)-exp(10))/2.;
     if(rank==0)std::cout << "Correct square norm is    "<<std::setw(6)<<solution3d<<std::endl;
     if(rank==0)std::cout << "Relative 3d error is      "<<(norm3d-solution3d)/solution3d<<"\n";
+
+    std::vector<double> dots = dg::blas1::multi_dot( w3d,
+        std::vector<const dg::MDVec*>{ &func3d, &w3d}); //one reduction
+    dg::exblas::udouble ref;
+    res.d = dots[0];
+    if(rank==0)std::cout << "\nmulti_dot 3D integral     "<<std::setw(6)<<dots[0]<<"\t" << res.i - 4675882723962622631<< "\n";
+    res.d = dots[1], ref.d = dg::blas1::dot( w3d, w3d);
+    if(rank==0)std::cout << "multi_dot squared weights "<<std::setw(6)<<dots[1]<<"\t" << res.i - ref.i<< "\n";
     if(rank==0)std::cout << "\nFINISHED! Continue with topology/derivatives_mpit.cu !\n\n";
 
     MPI_Finalize();
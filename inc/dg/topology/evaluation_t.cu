@@ -105,6 +105,17 @@ int main()
     std::cout << "Correct square norm is    "<<std::setw(6)<<solution3d<<std::endl;
     std::cout << "Relative 3d error is      "<<(norm3d-solution3d)/solution3d<<"\n\n";
 
+    std::vector<double> dots = dg::blas1::multi_dot( w3d,
+        std::vector<const dg::DVec*>{ &func3d, &w3d, &func3d});
+    std::cout << "TEST multi_dot against dot (all must be EXACTLY 0):\n";
+    res.d = dots[0];
+    std::cout << "3D integral               "<<std::setw(6)<<dots[0]<<"\t" << res.i - 4675882723962622631<< "\n";
+    dg::exblas::udouble ref;
+    res.d = dots[1], ref.d = dg::blas1::dot( w3d, w3d);
+    std::cout << "Sum of squared weights    "<<std::setw(6)<<dots[1]<<"\t" << res.i - ref.i<< "\n";
+    res.d = dots[2];
+    std::cout << "3D integral (repeated)    "<<std::setw(6)<<dots[2]<<"\t" << res.i - 4675882723962622631<< "\n\n";
+
     std::cout << "TEST result of a sin and exp function to compare compiler specific math libraries:\n";
     dg::DVec x(1, 6.12610567450009658);
     dg::blas1::transform( x, x, sin_function() );
@@ -176,7 +176,7 @@ dg::MIHMatrix_t<real_type> interpolation( const thrust::host_vector<real_type>&
  * @copydetails interpolation(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&,const aRealTopology3d<real_type>&,dg::bc,dg::bc,dg::bc)
  */
 template<class real_type>
-dg::MIHMatrix_t<real_type> interpolation( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& y, const thrust::host_vector<real_type>& z, const aRealMPITopology2d<real_type>& g, dg::bc bcx = dg::NEU, dg::bc bcy = dg::NEU, dg::bc bcz = dg::PER)
+dg::MIHMatrix_t<real_type> interpolation( const thrust::host_vector<real_type>& x, const thrust::host_vector<real_type>& y, const thrust::host_vector<real_type>& z, const aRealMPITopology3d<real_type>& g, dg::bc bcx = dg::NEU, dg::bc bcy = dg::NEU, dg::bc bcz = dg::PER)
 {
     dg::IHMatrix_t<real_type> mat = dg::create::interpolation( x,y,z, g.global(), bcx, bcy, bcz);
     return convert(  mat, g);
@@ -112,6 +112,63 @@ struct InverseTensorMultiply3d{
               +t02*DG_FMA(t10, t21, (-t20*t11));
     }
 };
+/// \f$ y_i \leftarrow \lambda T_{ii} x_i + \mu y_i\f$ (diagonal \f$ T\f$)
+template<class value_type>
+struct DiagonalTensorMultiply2d{
+    DG_DEVICE
+    void operator() (
+              value_type lambda,
+              value_type t00, value_type t11,
+              value_type in0, value_type in1,
+              value_type mu,
+              value_type& out0, value_type& out1) const
+    {
+        value_type temp = out1*mu;
+        out1 = DG_FMA( lambda, t11*in1, temp);
+        temp = out0*mu;
+        out0 = DG_FMA( lambda, t00*in0, temp);
+    }
+};
+/// \f$ y_i \leftarrow \lambda T_{ii} x_i + \mu y_i\f$ (diagonal \f$ T\f$)
+template<class value_type>
+struct DiagonalTensorMultiply3d{
+    DG_DEVICE
+    void operator() ( value_type lambda,
+                      value_type t00, value_type t11, value_type t22,
+                      value_type in0, value_type in1, value_type in2,
+                      value_type mu,
+                      value_type& out0, value_type& out1, value_type& out2) const
+    {
+        value_type temp = out2*mu;
+        out2 = DG_FMA( lambda, t22*in2, temp);
+        temp = out1*mu;
+        out1 = DG_FMA( lambda, t11*in1, temp);
+        temp = out0*mu;
+        out0 = DG_FMA( lambda, t00*in0, temp);
+    }
+};
+/// \f$ y_i \leftarrow \lambda T_{ij} x_i + \mu y_i\f$ (\f$ T_{02}=T_{12}=T_{20}=T_{21}=0\f$)
+template<class value_type>
+struct PerpTensorMultiply3d{
+    DG_DEVICE
+    void operator() ( value_type lambda,
+                      value_type t00, value_type t01,
+                      value_type t10, value_type t11,
+                      value_type t22,
+                      value_type in0, value_type in1, value_type in2,
+                      value_type mu,
+                      value_type& out0, value_type& out1, value_type& out2) const
+    {
+        value_type tmp0 = DG_FMA(t00,in0 , t01*in1);
+        value_type tmp1 = DG_FMA(t10,in0 , t11*in1);
+        value_type temp = out2*mu;
+        out2 = DG_FMA( lambda, t22*in2, temp);
+        temp = out1*mu;
+        out1 = DG_FMA( lambda, tmp1, temp);
+        temp = out0*mu;
+        out0 = DG_FMA( lambda, tmp0, temp);
+    }
+};
 ///@}
 
 ///@addtogroup variadic_evaluates
@@ -155,6 +212,54 @@ struct TensorDot3d{
     }
 };
 
+/// \f$ y = \lambda\mu v_i T_{ii} w_i \f$ (diagonal \f$ T\f$)
+template<class value_type>
+struct DiagonalTensorDot2d{
+    DG_DEVICE
+    value_type operator() (
+              value_type lambda,
+              value_type v0,  value_type v1,
+              value_type t00, value_type t11,
+              value_type mu,
+              value_type w0, value_type w1
+              ) const
+    {
+        return lambda*mu*DG_FMA(v0,t00*w0 , v1*t11*w1);
+    }
+};
+/// \f$ y = \lambda\mu v_i T_{ii} w_i \f$ (diagonal \f$ T\f$)
+template<class value_type>
+struct DiagonalTensorDot3d{
+    DG_DEVICE
+    value_type operator() (
+              value_type lambda,
+              value_type v0,  value_type v1,  value_type v2,
+              value_type t00, value_type t11, value_type t22,
+              value_type mu,
+              value_type w0, value_type w1, value_type w2) const
+    {
+        return lambda*mu*DG_FMA(v0,t00*w0 , DG_FMA(v1,t11*w1 , v2*t22*w2));
+    }
+};
+/// \f$ y = \lambda\mu v_i T_{ij} w_j \f$ (\f$ T_{02}=T_{12}=T_{20}=T_{21}=0\f$)
+template<class value_type>
+struct PerpTensorDot3d{
+    DG_DEVICE
+    value_type operator() (
+              value_type lambda,
+              value_type v0,  value_type v1,  value_type v2,
+              value_type t00, value_type t01,
+              value_type t10, value_type t11,
+              value_type t22,
+              value_type mu,
+              value_type w0, value_type w1, value_type w2) const
+    {
+        value_type tmp0 = DG_FMA( t00,w0 , t01*w1);
+        value_type tmp1 = DG_FMA( t10,w0 , t11*w1);
+        return lambda*mu*DG_FMA(v0,tmp0 , DG_FMA(v1,tmp1 , v2*t22*w2));
+    }
+};
+
 ///\f$ y = t_{00} t_{11} - t_{10}t_{01} \f$
 template<class value_type>
 struct TensorDeterminant2d
@@ -195,6 +300,49 @@ namespace tensor
 ///@addtogroup tensor
 ///@{
 
+/**
+ * @brief Sparsity pattern of a tensor
+ *
+ * Used to select a specialized kernel in the tensor functions that need to
+ * read fewer containers than the dense one
+ * @sa dg::tensor::find_pattern
+ */
+enum class pattern
+{
+    dense, //!< all elements may be non-zero
+    perp, //!< \f$ t_{02} = t_{12} = t_{20} = t_{21} = 0\f$, i.e. the third dimension decouples (typical for product geometries)
+    diagonal //!< all off-diagonal elements are zero
+};
+
+/**
+ * @brief Find the sparsity pattern of a tensor
+ *
+ * Every value container that an off-diagonal element refers to is checked
+ * once for being identically zero.
+ * @param t input tensor
+ * @return the sparsest pattern that \c t has
+ * @note This function reduces over some values of \c t and should be called
+ * once when the tensor is set and not on every multiplication
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerType>
+pattern find_pattern( const SparseTensor<ContainerType>& t)
+{
+    std::vector<int> zero( t.values().size(), -1); //-1 is not yet checked
+    auto is_zero = [&]( unsigned i, unsigned j) {
+        int k = t.idx(i,j);
+        if( zero[k] == -1)
+            zero[k] = 0 == dg::blas1::reduce( t.values()[k], 0.,
+                dg::AbsMax<get_value_type<ContainerType>>());
+        return zero[k] == 1;
+    };
+    if( !( is_zero(0,2) && is_zero(1,2) && is_zero(2,0) && is_zero(2,1)))
+        return pattern::dense;
+    if( is_zero(0,1) && is_zero(1,0))
+        return pattern::diagonal;
+    return pattern::perp;
+}
+
 /**
  * @brief \f$ t^{ij} = \mu t^{ij} \ \forall i,j \f$
  *
@@ -574,6 +722,138 @@ void scalar_product3d(
             mu,
             w0, w1, w2);
 }
+
+/**
+ * @brief \f$ w^i = \sum_{i=0}^1 \lambda t^{ij}v_j + \mu w^i \text{ for } i\in \{0,1\}\f$ with a given sparsity pattern
+ *
+ * Same as the corresponding function without the pattern parameter but
+ * if \c p is \c dg::tensor::pattern::diagonal only the diagonal elements of
+ * \c t are read
+ * @param p the pattern of \c t (usually from \c dg::tensor::find_pattern)
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerTypeM, class ContainerType3, class ContainerType4>
+void multiply2d( pattern p, const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerTypeM& mu, ContainerType3& out0, ContainerType4& out1)
+{
+    if( p == pattern::diagonal)
+        dg::blas1::subroutine( dg::DiagonalTensorMultiply2d<get_value_type<ContainerType0>>(),
+            lambda,      t.value(0,0), t.value(1,1),
+                         in0,  in1,
+            mu,          out0, out1);
+    else
+        multiply2d( lambda, t, in0, in1, mu, out0, out1);
+}
+
+/**
+ * @brief \f$ w^i = \sum_{i=0}^2\lambda t^{ij}v_j + \mu w^i \text{ for } i\in \{0,1,2\}\f$ with a given sparsity pattern
+ *
+ * Same as the corresponding function without the pattern parameter but
+ * only the elements of \c t that are non-zero in the pattern \c p are read
+ * @param p the pattern of \c t (usually from \c dg::tensor::find_pattern)
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class ContainerType6>
+void multiply3d( pattern p, const ContainerTypeL& lambda, const SparseTensor<ContainerType0>& t, const ContainerType1& in0, const ContainerType2& in1, const ContainerType3& in2, const ContainerTypeM& mu, ContainerType4& out0, ContainerType5& out1, ContainerType6& out2)
+{
+    if( p == pattern::diagonal)
+        dg::blas1::subroutine( dg::DiagonalTensorMultiply3d<get_value_type<ContainerType0>>(),
+            lambda,      t.value(0,0), t.value(1,1), t.value(2,2),
+                         in0, in1, in2,
+            mu,          out0, out1, out2);
+    else if( p == pattern::perp)
+        dg::blas1::subroutine( dg::PerpTensorMultiply3d<get_value_type<ContainerType0>>(),
+            lambda,      t.value(0,0), t.value(0,1),
+                         t.value(1,0), t.value(1,1),
+                         t.value(2,2),
+                         in0, in1, in2,
+            mu,          out0, out1, out2);
+    else
+        multiply3d( lambda, t, in0, in1, in2, mu, out0, out1, out2);
+}
+
+/**
+ * @brief \f$ y = \alpha \lambda\mu \sum_{i=0}^1 v_it^{ij}w_j + \beta y \text{ for } i\in \{0,1\}\f$ with a given sparsity pattern
+ *
+ * Same as the corresponding function without the pattern parameter but
+ * if \c p is \c dg::tensor::pattern::diagonal only the diagonal elements of
+ * \c t are read
+ * @param p the pattern of \c t (usually from \c dg::tensor::find_pattern)
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5>
+void scalar_product2d(
+        pattern p,
+        get_value_type<ContainerType0> alpha,
+        const ContainerTypeL& lambda,
+        const ContainerType0& v0,
+        const ContainerType1& v1,
+        const SparseTensor<ContainerType2>& t,
+        const ContainerTypeM& mu,
+        const ContainerType3& w0,
+        const ContainerType4& w1,
+        get_value_type<ContainerType0> beta,
+        ContainerType5& y)
+{
+    if( p == pattern::diagonal)
+        dg::blas1::evaluate( y,
+             dg::Axpby<get_value_type<ContainerType0>>( alpha, beta),
+             dg::DiagonalTensorDot2d<get_value_type<ContainerType0>>(),
+             lambda,
+             v0, v1,
+             t.value(0,0), t.value(1,1),
+             mu,
+             w0, w1);
+    else
+        scalar_product2d( alpha, lambda, v0, v1, t, mu, w0, w1, beta, y);
+}
+
+/**
+ * @brief \f$ y = \alpha \lambda\mu \sum_{i=0}^2 v_it^{ij}w_j + \beta y \text{ for } i\in \{0,1,2\}\f$ with a given sparsity pattern
+ *
+ * Same as the corresponding function without the pattern parameter but
+ * only the elements of \c t that are non-zero in the pattern \c p are read
+ * @param p the pattern of \c t (usually from \c dg::tensor::find_pattern)
+ * @copydoc hide_ContainerType
+ */
+template<class ContainerTypeL, class ContainerType0, class ContainerType1, class ContainerType2, class ContainerType3, class ContainerTypeM, class ContainerType4, class ContainerType5, class ContainerType6, class ContainerType7>
+void scalar_product3d(
+        pattern p,
+        get_value_type<ContainerType0> alpha,
+        const ContainerTypeL& lambda,
+        const ContainerType0& v0,
+        const ContainerType1& v1,
+        const ContainerType2& v2,
+        const SparseTensor<ContainerType3>& t,
+        const ContainerTypeM& mu,
+        const ContainerType4& w0,
+        const ContainerType5& w1,
+        const ContainerType6& w2,
+        get_value_type<ContainerType0> beta,
+        ContainerType7& y)
+{
+    if( p == pattern::diagonal)
+        dg::blas1::evaluate( y,
+            dg::Axpby<get_value_type<ContainerType0>>( alpha, beta),
+            dg::DiagonalTensorDot3d<get_value_type<ContainerType0>>(),
+            lambda,
+            v0, v1, v2,
+            t.value(0,0), t.value(1,1), t.value(2,2),
+            mu,
+            w0, w1, w2);
+    else if( p == pattern::perp)
+        dg::blas1::evaluate( y,
+            dg::Axpby<get_value_type<ContainerType0>>( alpha, beta),
+            dg::PerpTensorDot3d<get_value_type<ContainerType0>>(),
+            lambda,
+            v0, v1, v2,
+            t.value(0,0), t.value(0,1),
+            t.value(1,0), t.value(1,1),
+            t.value(2,2),
+            mu,
+            w0, w1, w2);
+    else
+        scalar_product3d( alpha, lambda, v0, v1, v2, t, mu, w0, w1, w2, beta, y);
+}
 ///@}
 
 }//namespace tensor
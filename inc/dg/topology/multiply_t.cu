@@ -46,6 +46,17 @@ int main()
     std::cout << "Multiply T with [8,9]\n";
     dg::tensor::multiply2d( t, eight, nine, work0, work1);
     std::cout << "Result         is ["<<work0[0]<<" "<<work1[0]<<"] ([86 120])\n";
+    std::cout << "Pattern of T is "<<(int)dg::tensor::find_pattern(t)<<" (1 = perp)\n";
+    dg::tensor::multiply3d( dg::tensor::pattern::perp, 1., t, eight, nine, two, 0., work0, work1, work2);
+    std::cout << "Result perp    is ["<<work0[0]<<" "<<work1[0]<<" "<<work2[0]<<"] ([86 120 4])\n";
+    dg::SparseTensor<thrust::host_vector<double> > d = t;
+    d.idx(0,1) = d.idx(1,0) = 0;
+    std::cout << "Pattern of diagonal T is "<<(int)dg::tensor::find_pattern(d)<<" (2 = diagonal)\n";
+    dg::tensor::multiply3d( dg::tensor::find_pattern(d), 1., d, eight, nine, two, 0., work0, work1, work2);
+    std::cout << "Result diagonal is ["<<work0[0]<<" "<<work1[0]<<" "<<work2[0]<<"] ([32 72 4])\n";
+    inout0 = eight;
+    dg::tensor::scalar_product2d( dg::tensor::pattern::diagonal, 1., 2., one, two, d, 2., eight, nine, 1., inout0);
+    std::cout << "Result diagonal scalar product is "<<inout0[0]<<" (712)\n";
     std::cout << "Scalar product 2d\n";
     inout0 = eight;
     dg::tensor::scalar_product2d( 1., 2., one, two, t, 2., eight, nine, 1., inout0);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include "cusp/transpose.h"
 #include "dg/backend/memory.h"
 #include "dg/blas.h"
@@ -284,14 +285,139 @@ struct RealExponentialRefinement : public aRealRefinement1d<real_type>
     }
 };
 
+/**
+ * @brief Cellwise refinement divides every cell of the grid into a given number of equidistant cells
+ *
+ * In contrast to the other refinements the refined patches are given as data
+ * and not by a node. This makes it suitable for dynamic refinement where the
+ * multiples are recomputed from an error indicator (cf. \c dg::modal_decay
+ * and \c dg::refinement_multiples) during a simulation and the solution is
+ * transferred to the new grid with \c dg::create::interpolation
+ */
+template<class real_type>
+struct RealCellwiseRefinement : public aRealRefinement1d<real_type>
+{
+    /**
+     * @brief Refine cell \c i by \c multiples[i]
+     * @param multiples the number of new cells in each old cell (must be >= 1)
+     * The size must equal the number of cells of the grid to refine
+     */
+    RealCellwiseRefinement( const std::vector<unsigned>& multiples): m_multiples(multiples){
+        for( unsigned i=0; i<multiples.size(); i++)
+            assert( multiples[i] >= 1);
+    }
+    virtual RealCellwiseRefinement* clone()const{return new RealCellwiseRefinement(*this);}
+    ///read access to the cell multiples
+    const std::vector<unsigned>& multiples() const{ return m_multiples;}
+    private:
+    std::vector<unsigned> m_multiples;
+    virtual void do_generate( const RealGrid1d<real_type>& g, thrust::host_vector<real_type>& weights, thrust::host_vector<real_type>& abscissas) const override final
+    {
+        thrust::host_vector< real_type> w_( g.n()*do_N_new( g.N(), g.bcx()));
+        unsigned k=0;
+        for( unsigned i=0; i<g.N(); i++)
+            for( unsigned j=0; j<m_multiples[i]*g.n(); j++)
+                w_[k++] = (real_type)m_multiples[i];
+        weights = w_;
+        abscissas = detail::normalize_weights_and_compute_abscissas( g, weights);
+    }
+    virtual unsigned do_N_new( unsigned N_old, bc bcx) const override final
+    {
+        if( N_old != m_multiples.size())
+            throw Error( Message(_ping_)<<"CellwiseRefinement has "<<m_multiples.size()<<" multiples but the grid has "<<N_old<<" cells!");
+        unsigned N = 0;
+        for( unsigned i=0; i<N_old; i++)
+            N += m_multiples[i];
+        return N;
+    }
+};
+
 using aRefinement1d         = dg::aRealRefinement1d<double>;
 using IdentityRefinement    = dg::RealIdentityRefinement<double>;
 using LinearRefinement      = dg::RealLinearRefinement<double>;
 using EquidistRefinement    = dg::RealEquidistRefinement<double>;
 using ExponentialRefinement = dg::RealExponentialRefinement<double>;
+using CellwiseRefinement    = dg::RealCellwiseRefinement<double>;
 
 ///@}
 
+/**
+ * @brief Cellwise modal decay error indicator
+ *
+ * In every cell the Legendre coefficients \f$ c_k\f$ of \c in along x and
+ * along y are computed. The indicator is the fraction of the highest mode
+ * \f$ \sqrt{c_{n-1}^2/\sum_k c_k^2}\f$, which is small where the solution
+ * is resolved and approaches 1 where it is not.
+ * The maximum over each column (row) of cells is taken since the refinements
+ * are tensor products of 1d refinements.
+ * @param g the (unrefined) topology of \c in
+ * @param in a vector on \c g
+ * @param decayX (output) the indicator for each of the \c g.Nx() cells in x
+ * @param decayY (output) the indicator for each of the \c g.Ny() cells in y
+ * @ingroup generators
+ */
+template<class real_type>
+void modal_decay( const aRealTopology2d<real_type>& g, const thrust::host_vector<real_type>& in, std::vector<real_type>& decayX, std::vector<real_type>& decayY)
+{
+    const unsigned n = g.n(), Nx = g.Nx(), Ny = g.Ny();
+    const std::vector<real_type>& forward = g.dlt().forward();
+    decayX.assign( Nx, 0), decayY.assign( Ny, 0);
+    for( unsigned i=0; i<Ny; i++)
+    for( unsigned j=0; j<Nx; j++)
+    for( unsigned l=0; l<n; l++)
+    {
+        //the l-th line of points in x and in y of cell (i,j)
+        real_type normX = 0, normY = 0, highX = 0, highY = 0;
+        for( unsigned k=0; k<n; k++)
+        {
+            real_type cX = 0, cY = 0;
+            for( unsigned m=0; m<n; m++)
+            {
+                cX += forward[k*n+m]*in[((i*n+l)*Nx+j)*n+m];
+                cY += forward[k*n+m]*in[((i*n+m)*Nx+j)*n+l];
+            }
+            normX += cX*cX, normY += cY*cY;
+            if( k == n-1)
+                highX = cX*cX, highY = cY*cY;
+        }
+        if( normX > 0)
+            decayX[j] = std::max( decayX[j], sqrt( highX/normX));
+        if( normY > 0)
+            decayY[i] = std::max( decayY[i], sqrt( highY/normY));
+    }
+}
+
+/**
+ * @brief Translate a cellwise error indicator into refinement multiples
+ *
+ * Cells where the indicator exceeds \c tolerance and \c buffer cells on either
+ * side of them are divided into \c multiple cells, all other cells are left
+ * as they are. The result is suitable for \c dg::CellwiseRefinement.
+ * @param indicator the error indicator in each cell (e.g. from \c dg::modal_decay)
+ * @param tolerance refine where the indicator is larger than this value
+ * @param multiple the number of cells a refined cell is divided into
+ * @param buffer number of neighbouring cells that are refined as well
+ * @param bcx if \c dg::PER the buffer wraps around the boundary
+ * @return the number of new cells in each cell
+ * @ingroup generators
+ */
+template<class real_type>
+std::vector<unsigned> refinement_multiples( const std::vector<real_type>& indicator, real_type tolerance, unsigned multiple, unsigned buffer = 1, bc bcx = dg::PER)
+{
+    const int N = indicator.size();
+    std::vector<unsigned> multiples( N, 1);
+    for( int i=0; i<N; i++)
+        if( indicator[i] > tolerance)
+            for( int k=i-(int)buffer; k<=i+(int)buffer; k++)
+            {
+                if( bcx == dg::PER)
+                    multiples[(k+N)%N] = multiple;
+                else if( k >= 0 && k < N)
+                    multiples[k] = multiple;
+            }
+    return multiples;
+}
+
 /**
  * @brief Refined RealCartesian grid
  * @ingroup geometry
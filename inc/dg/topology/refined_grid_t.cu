@@ -10,6 +10,7 @@
 
 double function( double x, double y){return sin(x)*cos(y);}
 double derivative( double x, double y){return cos(x)*cos(y);}
+double blob( double x, double y){return exp( -((x-M_PI)*(x-M_PI)+(y-M_PI)*(y-M_PI))/0.1);}
 
 
 int main ()
@@ -94,6 +95,21 @@ int main ()
     double error = dg::blas2::dot( vec_c, w2d_c, vec_c);
     std::cout << "error of derivative is "<<error<<std::endl;
 
+    std::cout << "TEST OF ADAPTIVE CELLWISE REFINEMENT\n";
+    dg::CartesianGrid2d g2d_b( 0., 2*M_PI, 0., 2*M_PI, 3, 20, 20);
+    dg::HVec blob_c = dg::evaluate( blob, g2d_b);
+    std::vector<double> decayX, decayY;
+    dg::modal_decay( g2d_b, blob_c, decayX, decayY);
+    dg::CellwiseRefinement cellX( dg::refinement_multiples( decayX, 1e-2, 4, 1, g2d_b.bcx()));
+    dg::CellwiseRefinement cellY( dg::refinement_multiples( decayY, 1e-2, 4, 1, g2d_b.bcy()));
+    dg::CartesianRefinedGrid2d g2d_a( cellX, cellY, 0., 2*M_PI, 0., 2*M_PI, 3, 20, 20);
+    std::cout << "Refined cells "<<g2d_a.Nx()<<" x "<<g2d_a.Ny()<<" instead of "<<4*g2d_b.Nx()<<" x "<<4*g2d_b.Ny()<<"\n";
+    dg::HVec blob_a = dg::pullback( blob, g2d_a);
+    integral = dg::blas1::dot( blob_a, dg::create::volume( g2d_a));
+    std::cout << "error of adaptive integral is "<<integral-M_PI*0.1<<std::endl;
+    integral = dg::blas1::dot( blob_c, dg::create::weights( g2d_b));
+    std::cout << "error of coarse   integral is "<<integral-M_PI*0.1<<std::endl;
+
     dg::CartesianRefinedGrid3d g3d_f( lin,lin,lin, 0., 2*M_PI, 0., 2*M_PI, 0., 2*M_PI, 5, 20, 20, 20);
     g3d_f.display();
 
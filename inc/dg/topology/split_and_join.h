@@ -3,7 +3,9 @@
 #include <thrust/device_vector.h>
 #include "dg/backend/blas1_dispatch_shared.h"
 #include "dg/backend/view.h"
+#include "dg/backend/broadcast.h"
 #include "grid.h"
+#include "tensor.h"
 #ifdef MPI_VERSION
 #include "dg/backend/mpi_vector.h"
 #include "mpi_grid.h"
@@ -52,6 +54,59 @@ std::vector<View<SharedContainer>> split( SharedContainer& in, const aRealTopolo
     return out;
 }
 
+/** @brief Broadcast the first plane of a vector along the last dimension
+*
+* Use for 3d quantities that do not vary along the last dimension (e.g. the
+* magnetic field in a cylindrical grid) to store only one plane
+* @param in contiguous 3d vector (must be of size \c grid.size())
+* @param grid provide dimensions in 3rd and first two dimensions
+* @return the first plane of \c in broadcast to \c grid.Nz() planes
+* @tparam SharedContainer \c TensorTraits exists for this class and the
+*   \c tensor_category derives from \c SharedVectorTag
+*/
+template<class SharedContainer, class real_type>
+PlaneBroadcast<SharedContainer> broadcast_plane( const SharedContainer& in, const aRealTopology3d<real_type>& grid)
+{
+    unsigned size2d=grid.n()*grid.n()*grid.Nx()*grid.Ny();
+    SharedContainer plane( in.begin(), in.begin() + size2d);
+    return PlaneBroadcast<SharedContainer>( plane, grid.Nz());
+}
+
+///@cond
+namespace detail
+{
+template<class Container, class BroadcastContainer, class Topology>
+void broadcast_tensor_plane( const SparseTensor<Container>& in,
+    const Topology& grid, SparseTensor<BroadcastContainer>& out)
+{
+    for( unsigned i=0; i<3; i++)
+        for( unsigned j=0; j<3; j++)
+            out.idx(i,j) = in.idx(i,j);
+    out.values().resize( in.values().size());
+    for( unsigned k=0; k<in.values().size(); k++)
+        out.values()[k] = broadcast_plane( in.values()[k], grid);
+}
+}//namespace detail
+///@endcond
+
+/** @brief Broadcast the first plane of every value of a tensor along the last dimension
+*
+* Use for tensors that do not vary along the last dimension (e.g. the metric
+* of a product geometry or a perpendicular projection tensor)
+* @param in tensor with contiguous 3d values (of size \c grid.size())
+* @param grid provide dimensions in 3rd and first two dimensions
+* @return tensor with the same index pattern and broadcast values
+* @tparam SharedContainer \c TensorTraits exists for this class and the
+*   \c tensor_category derives from \c SharedVectorTag
+*/
+template<class SharedContainer, class real_type>
+SparseTensor<PlaneBroadcast<SharedContainer>> broadcast_plane( const SparseTensor<SharedContainer>& in, const aRealTopology3d<real_type>& grid)
+{
+    SparseTensor<PlaneBroadcast<SharedContainer>> out;
+    detail::broadcast_tensor_plane( in, grid, out);
+    return out;
+}
+
 #ifdef MPI_VERSION
 
 template<class MPIContainer>
@@ -116,6 +171,41 @@ std::vector<get_mpi_view_type<MPIContainer> > split(
     }
     return out;
 }
+/** @brief MPI Version of broadcast_plane
+*
+* @param in contiguous 3d vector (must be of size \c grid.size())
+* @param grid provide dimensions in 3rd and first two dimensions
+* @return the first local plane of \c in broadcast to \c grid.local().Nz()
+* planes with the communicators of \c in
+* @tparam LocalContainer \c TensorTraits exists for this class and the
+*   \c tensor_category derives from \c SharedVectorTag
+*/
+template<class LocalContainer, class real_type>
+MPI_Vector<PlaneBroadcast<LocalContainer>> broadcast_plane(
+    const MPI_Vector<LocalContainer>& in, const aRealMPITopology3d<real_type>& grid)
+{
+    MPI_Vector<PlaneBroadcast<LocalContainer>> out;
+    out.data() = broadcast_plane( in.data(), grid.local());
+    out.set_communicator( in.communicator(), in.communicator_mod(),
+        in.communicator_mod_reduce());
+    return out;
+}
+/** @brief MPI Version of broadcast_plane for tensors
+*
+* @param in tensor with contiguous 3d values (of size \c grid.size())
+* @param grid provide dimensions in 3rd and first two dimensions
+* @return tensor with the same index pattern and broadcast values
+* @tparam LocalContainer \c TensorTraits exists for this class and the
+*   \c tensor_category derives from \c SharedVectorTag
+*/
+template<class LocalContainer, class real_type>
+SparseTensor<MPI_Vector<PlaneBroadcast<LocalContainer>>> broadcast_plane(
+    const SparseTensor<MPI_Vector<LocalContainer>>& in, const aRealMPITopology3d<real_type>& grid)
+{
+    SparseTensor<MPI_Vector<PlaneBroadcast<LocalContainer>>> out;
+    detail::broadcast_tensor_plane( in, grid, out);
+    return out;
+}
 #endif //MPI_VERSION
 
 ///@}
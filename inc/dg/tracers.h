@@ -0,0 +1,503 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include <thrust/host_vector.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+#include "backend/exceptions.h"
+#include "topology/grid.h"
+#include "runge_kutta.h"
+#ifdef MPI_VERSION
+#include "backend/mpi_vector.h"
+#include "topology/mpi_grid.h"
+#endif //MPI_VERSION
+
+/*! @file
+  @brief Lagrangian tracer particles advected by DG velocity fields
+  */
+namespace dg
+{
+///@cond
+namespace detail
+{
+//Legendre polynomials p_k(xn) and their derivatives for k<n
+template<class real_type>
+inline void legendre_and_derivative( real_type xn, unsigned n, real_type* p, real_type* dp)
+{
+    p[0] = 1., dp[0] = 0.;
+    if( n > 1)
+        p[1] = xn, dp[1] = 1.;
+    for( unsigned k=1; k+1<n; k++)
+    {
+        p[k+1] = ((real_type)(2*k+1)*xn*p[k] - (real_type)k*p[k-1])/(real_type)(k+1);
+        dp[k+1] = dp[k-1] + (real_type)(2*k+1)*p[k];
+    }
+}
+
+//Separable transformation of a 2d vector from xspace to lspace (cf. dg::forward_transform)
+template<class real_type>
+void modal_transform_2d( const RealGrid2d<real_type>& g,
+    const thrust::host_vector<real_type>& in, thrust::host_vector<real_type>& tmp,
+    thrust::host_vector<real_type>& out)
+{
+    const unsigned n = g.n(), Nx = g.Nx(), rows = g.Ny()*n;
+    const std::vector<real_type>& forward = g.dlt().forward();
+    tmp.resize( in.size()), out.resize( in.size());
+    //transform in x
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for( int r=0; r<(int)rows; r++)
+    for( unsigned i=0; i<Nx; i++)
+    for( unsigned l=0; l<n; l++)
+    {
+        real_type temp = 0;
+        for( unsigned m=0; m<n; m++)
+            temp += forward[l*n+m]*in[(r*Nx+i)*n+m];
+        tmp[(r*Nx+i)*n+l] = temp;
+    }
+    //transform in y
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for( int j=0; j<(int)g.Ny(); j++)
+    for( unsigned k=0; k<n; k++)
+    for( unsigned i=0; i<Nx*n; i++)
+    {
+        real_type temp = 0;
+        for( unsigned o=0; o<n; o++)
+            temp += forward[k*n+o]*tmp[(j*n+o)*Nx*n+i];
+        out[(j*n+k)*Nx*n+i] = temp;
+    }
+}
+
+//cell index and normalized coordinate of x on a 1d grid
+//points outside the grid are attributed to the first or last cell such that
+//the polynomial of that cell is extrapolated
+template<class real_type>
+inline int cell_and_coordinate( real_type x, real_type x0, real_type h, int N, real_type& xn)
+{
+    real_type xnn = (x-x0)/h;
+    int i = (int)floor( xnn);
+    i = i < 0 ? 0 : ( i >= N ? N-1 : i);
+    xn = 2.*xnn - (real_type)(2*i+1);
+    return i;
+}
+
+//Evaluate a field given by its modal coefficients c on g at the points (x,y)
+//dx and dy may be nullptr in which case the gradient is not computed
+template<class real_type>
+void evaluate_modal_2d_kernel( const RealGrid2d<real_type>& g, const real_type* RESTRICT c,
+    unsigned size, const real_type* RESTRICT x, const real_type* RESTRICT y,
+    real_type* RESTRICT value, real_type* RESTRICT dx, real_type* RESTRICT dy)
+{
+    const int n = g.n(), Nx = g.Nx(), Ny = g.Ny();
+    const real_type hx = g.hx(), hy = g.hy(), x0 = g.x0(), y0 = g.y0();
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for( int p=0; p<(int)size; p++)
+    {
+        real_type px[20], dpx[20], py[20], dpy[20], xn, yn;
+        const int i = cell_and_coordinate( x[p], x0, hx, Nx, xn);
+        const int j = cell_and_coordinate( y[p], y0, hy, Ny, yn);
+        legendre_and_derivative( xn, n, px, dpx);
+        legendre_and_derivative( yn, n, py, dpy);
+        const real_type* cc = c + (j*n*Nx + i)*n;
+        real_type v = 0, vx = 0, vy = 0;
+        for( int ky=0; ky<n; ky++)
+        {
+            real_type row = 0, rowx = 0;
+            for( int kx=0; kx<n; kx++)
+            {
+                row  += cc[ky*Nx*n+kx]*px[kx];
+                rowx += cc[ky*Nx*n+kx]*dpx[kx];
+            }
+            v  += py[ky]*row;
+            vx += py[ky]*rowx;
+            vy += dpy[ky]*row;
+        }
+        value[p] = v;
+        if( dx != nullptr)
+        {
+            dx[p] = 2.*vx/hx;
+            dy[p] = 2.*vy/hy;
+        }
+    }
+}
+template<class real_type>
+void evaluate_modal_2d( const RealGrid2d<real_type>& g,
+    const thrust::host_vector<real_type>& c, const thrust::host_vector<real_type>& x,
+    const thrust::host_vector<real_type>& y, thrust::host_vector<real_type>& value)
+{
+    evaluate_modal_2d_kernel( g, thrust::raw_pointer_cast( c.data()), x.size(),
+        thrust::raw_pointer_cast( x.data()), thrust::raw_pointer_cast( y.data()),
+        thrust::raw_pointer_cast( value.data()), (real_type*)nullptr, (real_type*)nullptr);
+}
+template<class real_type>
+void evaluate_modal_2d( const RealGrid2d<real_type>& g,
+    const thrust::host_vector<real_type>& c, const thrust::host_vector<real_type>& x,
+    const thrust::host_vector<real_type>& y, thrust::host_vector<real_type>& value,
+    thrust::host_vector<real_type>& dx, thrust::host_vector<real_type>& dy)
+{
+    evaluate_modal_2d_kernel( g, thrust::raw_pointer_cast( c.data()), x.size(),
+        thrust::raw_pointer_cast( x.data()), thrust::raw_pointer_cast( y.data()),
+        thrust::raw_pointer_cast( value.data()), thrust::raw_pointer_cast( dx.data()),
+        thrust::raw_pointer_cast( dy.data()));
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Lagrangian tracer particles in a 2d domain
+ *
+ * The particle positions are stored as a structure of arrays and advanced
+ * with any explicit Runge-Kutta tableau through a velocity field given on
+ * a DG grid, either directly or as the \f$ E\times B\f$ velocity
+ * \f$ \vec v = \hat z\times\nabla\phi\f$ of a potential.
+ * Fields are transformed to modal coefficients once per call and then
+ * evaluated at all particles (together with their gradients) in a single
+ * batched kernel, so no interpolation matrix is ever built. Particles are
+ * binned (sorted) by grid cell after each step so that consecutive
+ * particles read the same coefficients.
+ * @code
+dg::Tracers2d<double> tracers( grid, x, y, "Runge-Kutta-4-4");
+for( unsigned i=0; i<steps; i++)
+{
+    // ... advance phi
+    tracers.step_ExB( phi, t, dt);
+    tracers.evaluate( density, values); // e.g. for transport statistics
+}
+ * @endcode
+ * Under MPI every process holds the particles located in its part of the
+ * domain. After each step particles that left the process' domain are sent
+ * to their new owner (determined like \c dg::aRealMPITopology2d::pidOf).
+ * During the Runge-Kutta stages the DG polynomial of the nearest local cell
+ * is extrapolated, so no halo exchange of the fields is needed as long as
+ * particles do not move farther than about a cell per step.
+ *
+ * Particles that leave the domain through a non-periodic boundary are
+ * removed and counted in \c lost(); through a periodic boundary they re-enter
+ * on the opposite side.
+ * @note The \f$ E\times B\f$ velocity is computed in Cartesian coordinates
+ * with a unit magnetic field in z; the fields are frozen during a step
+ * @note Evaluation and advection run on the host (with OpenMP if available)
+ * @attention The polynomial coefficient \c n of the grid must not exceed 20
+ * @ingroup misc
+ */
+template<class real_type>
+struct Tracers2d
+{
+    using value_type = real_type;
+    ///The type of the particle positions
+    using container_type = std::array<thrust::host_vector<real_type>,2>;
+    ///@brief Empty
+    Tracers2d() = default;
+    /**
+     * @brief Place particles in a shared memory domain
+     *
+     * @param g particles live in this grid and the fields are given on it
+     * @param x x-coordinates of the initial particle positions
+     * @param y y-coordinates of the initial particle positions
+     * @param tableau Explicit Runge-Kutta tableau used to advance the particles
+     * @note particles get the ids 0,1,2,... in the order given
+     */
+    Tracers2d( const aRealTopology2d<real_type>& g,
+        const thrust::host_vector<real_type>& x,
+        const thrust::host_vector<real_type>& y,
+        ConvertsToButcherTableau<real_type> tableau = "Runge-Kutta-4-4"):
+        m_local( g), m_global( g), m_tableau( tableau)
+    {
+        init( x, y, 0);
+    }
+#ifdef MPI_VERSION
+    /**
+     * @brief Place particles in a distributed domain
+     *
+     * @param g particles live in this grid and the fields are given on it
+     * @param x x-coordinates of initial particle positions anywhere in the global domain
+     * @param y y-coordinates of initial particle positions anywhere in the global domain
+     * @param tableau Explicit Runge-Kutta tableau used to advance the particles
+     * @note Every process may pass any number of particles; they are
+     * immediately sent to their owner. Ids are numbered consecutively
+     * in the order of ranks and then in the order given.
+     */
+    Tracers2d( const aRealMPITopology2d<real_type>& g,
+        const thrust::host_vector<real_type>& x,
+        const thrust::host_vector<real_type>& y,
+        ConvertsToButcherTableau<real_type> tableau = "Runge-Kutta-4-4"):
+        m_local( g.local()), m_global( g.global()), m_tableau( tableau),
+        m_comm( g.communicator())
+    {
+        unsigned offset = 0, local_size = x.size();
+        MPI_Exscan( &local_size, &offset, 1, MPI_UNSIGNED, MPI_SUM, m_comm);
+        int rank;
+        MPI_Comm_rank( m_comm, &rank);
+        if( rank == 0)
+            offset = 0; //the result of Exscan is undefined on rank 0
+        init( x, y, offset);
+    }
+#endif //MPI_VERSION
+
+    ///@brief Number of particles on this process
+    unsigned size() const{ return m_pos[0].size();}
+    ///@brief x-coordinates of the particles on this process
+    const thrust::host_vector<real_type>& x() const{ return m_pos[0];}
+    ///@brief y-coordinates of the particles on this process
+    const thrust::host_vector<real_type>& y() const{ return m_pos[1];}
+    ///@brief The positions \c {x(),y()}
+    const container_type& positions() const{ return m_pos;}
+    ///@brief Unique ids of the particles on this process (in the same order as the positions)
+    const thrust::host_vector<unsigned>& ids() const{ return m_id;}
+    ///@brief Number of particles that left this process' domain through a non-periodic boundary
+    unsigned lost() const{ return m_lost;}
+
+    /**
+     * @brief Evaluate a field at all particle positions
+     *
+     * @param field a vector on the grid given in the constructor
+     * @param values contains the field values in the order of \c ids() on output (resized if necessary)
+     */
+    void evaluate( const thrust::host_vector<real_type>& field,
+        thrust::host_vector<real_type>& values)
+    {
+        detail::modal_transform_2d( m_local, field, m_tmp, m_modal0);
+        values.resize( size());
+        detail::evaluate_modal_2d( m_local, m_modal0, m_pos[0], m_pos[1], values);
+    }
+    /**
+     * @brief Evaluate a field and its gradient at all particle positions
+     *
+     * @param field a vector on the grid given in the constructor
+     * @param values contains the field values on output (resized if necessary)
+     * @param dx contains the x-derivative on output (resized if necessary)
+     * @param dy contains the y-derivative on output (resized if necessary)
+     */
+    void evaluate( const thrust::host_vector<real_type>& field,
+        thrust::host_vector<real_type>& values,
+        thrust::host_vector<real_type>& dx, thrust::host_vector<real_type>& dy)
+    {
+        detail::modal_transform_2d( m_local, field, m_tmp, m_modal0);
+        values.resize( size()), dx.resize( size()), dy.resize( size());
+        detail::evaluate_modal_2d( m_local, m_modal0, m_pos[0], m_pos[1], values, dx, dy);
+    }
+    /**
+     * @brief Advance the particles by one step in a given velocity field
+     *
+     * @param vx x-component of the velocity on the grid
+     * @param vy y-component of the velocity on the grid
+     * @param t time (updated on output)
+     * @param dt time step
+     */
+    void step( const thrust::host_vector<real_type>& vx,
+        const thrust::host_vector<real_type>& vy, real_type& t, real_type dt)
+    {
+        detail::modal_transform_2d( m_local, vx, m_tmp, m_modal0);
+        detail::modal_transform_2d( m_local, vy, m_tmp, m_modal1);
+        auto rhs = [&]( real_type, const container_type& pos, container_type& vel)
+        {
+            detail::evaluate_modal_2d( m_local, m_modal0, pos[0], pos[1], vel[0]);
+            detail::evaluate_modal_2d( m_local, m_modal1, pos[0], pos[1], vel[1]);
+        };
+        do_step( rhs, t, dt);
+    }
+    /**
+     * @brief Advance the particles by one step in the \f$ E\times B\f$ velocity \f$ \vec v = \hat z\times\nabla\phi = (-\partial_y\phi, \partial_x\phi)\f$
+     *
+     * @param phi the potential on the grid
+     * @param t time (updated on output)
+     * @param dt time step
+     */
+    void step_ExB( const thrust::host_vector<real_type>& phi, real_type& t, real_type dt)
+    {
+        detail::modal_transform_2d( m_local, phi, m_tmp, m_modal0);
+        auto rhs = [&]( real_type, const container_type& pos, container_type& vel)
+        {
+            m_value.resize( pos[0].size());
+            // dx phi -> vel[1], dy phi -> vel[0]
+            detail::evaluate_modal_2d( m_local, m_modal0, pos[0], pos[1], m_value,
+                vel[1], vel[0]);
+            for( unsigned p=0; p<vel[0].size(); p++)
+                vel[0][p] = -vel[0][p];
+        };
+        do_step( rhs, t, dt);
+    }
+#ifdef MPI_VERSION
+    ///@copydoc evaluate(const thrust::host_vector<real_type>&,thrust::host_vector<real_type>&)
+    void evaluate( const MPI_Vector<thrust::host_vector<real_type>>& field,
+        thrust::host_vector<real_type>& values){
+        evaluate( field.data(), values);
+    }
+    ///@copydoc evaluate(const thrust::host_vector<real_type>&,thrust::host_vector<real_type>&,thrust::host_vector<real_type>&,thrust::host_vector<real_type>&)
+    void evaluate( const MPI_Vector<thrust::host_vector<real_type>>& field,
+        thrust::host_vector<real_type>& values,
+        thrust::host_vector<real_type>& dx, thrust::host_vector<real_type>& dy){
+        evaluate( field.data(), values, dx, dy);
+    }
+    ///@copydoc step(const thrust::host_vector<real_type>&,const thrust::host_vector<real_type>&,real_type&,real_type)
+    void step( const MPI_Vector<thrust::host_vector<real_type>>& vx,
+        const MPI_Vector<thrust::host_vector<real_type>>& vy, real_type& t, real_type dt){
+        step( vx.data(), vy.data(), t, dt);
+    }
+    ///@copydoc step_ExB(const thrust::host_vector<real_type>&,real_type&,real_type)
+    void step_ExB( const MPI_Vector<thrust::host_vector<real_type>>& phi, real_type& t, real_type dt){
+        step_ExB( phi.data(), t, dt);
+    }
+#endif //MPI_VERSION
+
+    /**
+     * @brief Sort the particles by grid cell
+     *
+     * Called automatically after each step; particles in the same cell are
+     * then contiguous in memory and the evaluation reads each cell's
+     * coefficients only once from main memory.
+     */
+    void sort()
+    {
+        const unsigned num = size(), Nx = m_local.Nx(), cells = Nx*m_local.Ny();
+        std::vector<unsigned> count( cells+1, 0), cell( num);
+        for( unsigned p=0; p<num; p++)
+        {
+            real_type xn, yn;
+            int i = detail::cell_and_coordinate( m_pos[0][p], m_local.x0(), m_local.hx(), Nx, xn);
+            int j = detail::cell_and_coordinate( m_pos[1][p], m_local.y0(), m_local.hy(), m_local.Ny(), yn);
+            cell[p] = j*Nx+i;
+            count[cell[p]+1]++;
+        }
+        for( unsigned c=0; c<cells; c++)
+            count[c+1] += count[c];
+        container_type pos( m_pos);
+        thrust::host_vector<unsigned> id( m_id);
+        for( unsigned p=0; p<num; p++)
+        {
+            unsigned q = count[cell[p]]++;
+            pos[0][q] = m_pos[0][p], pos[1][q] = m_pos[1][p], id[q] = m_id[p];
+        }
+        m_pos.swap( pos);
+        m_id.swap( id);
+    }
+    private:
+    void init( const thrust::host_vector<real_type>& x,
+        const thrust::host_vector<real_type>& y, unsigned offset)
+    {
+        if( m_local.n() > 20)
+            throw dg::Error(dg::Message(_ping_)<<"Tracers2d supports at most n=20 but the grid has n="<<m_local.n());
+        if( x.size() != y.size())
+            throw dg::Error(dg::Message(_ping_)<<"Tracers2d: x and y have different sizes "<<x.size()<<" and "<<y.size());
+        m_pos[0] = x, m_pos[1] = y;
+        m_id.resize( x.size());
+        for( unsigned p=0; p<x.size(); p++)
+            m_id[p] = offset + p;
+        boundaries();
+        migrate();
+        sort();
+    }
+    template<class RHS>
+    void do_step( RHS& rhs, real_type& t, real_type dt)
+    {
+        if( m_rk_size != (int)size())
+        {
+            m_rk.construct( m_tableau, m_pos);
+            //particles are reordered and the fields advance between steps,
+            //so a first-same-as-last stage would belong to other particles
+            m_rk.ignore_fsal();
+            m_rk_size = size();
+        }
+        m_rk.step( rhs, t, m_pos, t, m_pos, dt);
+        boundaries();
+        migrate();
+        sort();
+    }
+    //wrap periodic and remove particles outside non-periodic boundaries
+    void boundaries()
+    {
+        const real_type x0[2] = { m_global.x0(), m_global.y0()};
+        const real_type x1[2] = { m_global.x1(), m_global.y1()};
+        const dg::bc bcs[2] = { m_global.bcx(), m_global.bcy()};
+        unsigned q = 0;
+        for( unsigned p=0; p<size(); p++)
+        {
+            bool inside = true;
+            for( unsigned u=0; u<2; u++)
+            {
+                real_type& x = m_pos[u][p];
+                if( bcs[u] == dg::PER)
+                    x = x - floor( (x-x0[u])/(x1[u]-x0[u]))*(x1[u]-x0[u]);
+                else if( x < x0[u] || x > x1[u])
+                    inside = false;
+            }
+            if( !inside)
+            {
+                m_lost++;
+                continue;
+            }
+            m_pos[0][q] = m_pos[0][p], m_pos[1][q] = m_pos[1][p], m_id[q] = m_id[p];
+            q++;
+        }
+        m_pos[0].resize( q), m_pos[1].resize( q), m_id.resize( q);
+    }
+    //send particles to the process that owns them
+    void migrate()
+    {
+#ifdef MPI_VERSION
+        if( m_comm == MPI_COMM_NULL)
+            return;
+        int size, dims[2], periods[2], coords[2];
+        MPI_Comm_size( m_comm, &size);
+        MPI_Cart_get( m_comm, 2, dims, periods, coords);
+        std::vector<int> dest( this->size()), sendTo( size, 0), recvFrom( size, 0);
+        for( unsigned p=0; p<this->size(); p++)
+        {
+            int c[2];
+            c[0] = (int)floor( (m_pos[0][p]-m_global.x0())/m_global.lx()*(real_type)dims[0]);
+            c[1] = (int)floor( (m_pos[1][p]-m_global.y0())/m_global.ly()*(real_type)dims[1]);
+            for( unsigned u=0; u<2; u++)
+                c[u] = c[u] < 0 ? 0 : ( c[u] >= dims[u] ? dims[u]-1 : c[u]);
+            MPI_Cart_rank( m_comm, c, &dest[p]);
+            sendTo[dest[p]] += 3;
+        }
+        MPI_Alltoall( sendTo.data(), 1, MPI_INT, recvFrom.data(), 1, MPI_INT, m_comm);
+        std::vector<int> sendOffset( size, 0), recvOffset( size, 0);
+        for( int r=1; r<size; r++)
+        {
+            sendOffset[r] = sendOffset[r-1] + sendTo[r-1];
+            recvOffset[r] = recvOffset[r-1] + recvFrom[r-1];
+        }
+        //pack x, y and id (exact in double) of every particle
+        std::vector<double> sendbuf( 3*this->size()), recvbuf(
+            recvOffset[size-1] + recvFrom[size-1]);
+        std::vector<int> position( sendOffset);
+        for( unsigned p=0; p<this->size(); p++)
+        {
+            int q = position[dest[p]];
+            sendbuf[q] = m_pos[0][p], sendbuf[q+1] = m_pos[1][p], sendbuf[q+2] = m_id[p];
+            position[dest[p]] += 3;
+        }
+        MPI_Alltoallv( sendbuf.data(), sendTo.data(), sendOffset.data(), MPI_DOUBLE,
+            recvbuf.data(), recvFrom.data(), recvOffset.data(), MPI_DOUBLE, m_comm);
+        const unsigned num = recvbuf.size()/3;
+        m_pos[0].resize( num), m_pos[1].resize( num), m_id.resize( num);
+        for( unsigned p=0; p<num; p++)
+        {
+            m_pos[0][p] = recvbuf[3*p], m_pos[1][p] = recvbuf[3*p+1];
+            m_id[p] = (unsigned)recvbuf[3*p+2];
+        }
+#endif //MPI_VERSION
+    }
+    RealGrid2d<real_type> m_local, m_global;
+    container_type m_pos;
+    thrust::host_vector<unsigned> m_id;
+    thrust::host_vector<real_type> m_modal0, m_modal1, m_tmp, m_value;
+    ButcherTableau<real_type> m_tableau;
+    RungeKutta<container_type> m_rk;
+    int m_rk_size = -1; //number of particles m_rk is constructed for
+    unsigned m_lost = 0;
+#ifdef MPI_VERSION
+    MPI_Comm m_comm = MPI_COMM_NULL;
+#endif //MPI_VERSION
+};
+
+}//namespace dg
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <iomanip>
+
+#include "topology/evaluation.h"
+#include "topology/interpolation.h"
+#include "tracers.h"
+
+double function( double x, double y) { return sin(x)*cos(2.*y);}
+double dxfunction( double x, double y) { return cos(x)*cos(2.*y);}
+// phi = (x^2+y^2)/2 gives a solid body rotation v = (-y, x)
+double potential( double x, double y) { return (x*x+y*y)/2.;}
+
+int main()
+{
+    std::cout << "This program tests the tracer particles\n";
+    unsigned n = 3, Nx = 20, Ny = 20;
+    const dg::Grid2d grid( -2., 2., -2., 2., n, Nx, Ny, dg::DIR, dg::DIR);
+    std::cout << "Computing on the Grid " <<n<<" x "<<Nx<<" x "<<Ny <<std::endl;
+    unsigned num = 1000;
+    thrust::host_vector<double> x( num), y( num);
+    for( unsigned p=0; p<num; p++)
+    {
+        double r = 0.2 + 1.5*(double)p/(double)num, theta = 0.37*p;
+        x[p] = r*cos( theta), y[p] = r*sin( theta);
+    }
+    dg::Tracers2d<double> tracers( grid, x, y);
+
+    const dg::HVec field = dg::evaluate( function, grid);
+    dg::HVec values, dx, dy;
+    tracers.evaluate( field, values, dx, dy);
+    double err_value = 0, err_dx = 0;
+    for( unsigned p=0; p<tracers.size(); p++)
+    {
+        double xp = tracers.x()[p], yp = tracers.y()[p];
+        double ref = dg::interpolate( dg::xspace, field, xp, yp, grid);
+        err_value = std::max( err_value, fabs( values[p] - ref));
+        err_dx = std::max( err_dx, fabs( dx[p] - dxfunction( xp, yp)));
+    }
+    std::cout << "Max difference to dg::interpolate  "<<err_value<<" (0)\n";
+    std::cout << "Max error in x-derivative          "<<err_dx<<" (small)\n";
+
+    // a quarter rotation
+    const dg::HVec phi = dg::evaluate( potential, grid);
+    double t = 0., dt = M_PI/2./100.;
+    for( unsigned i=0; i<100; i++)
+        tracers.step_ExB( phi, t, dt);
+    double err_pos = 0;
+    for( unsigned p=0; p<tracers.size(); p++)
+    {
+        unsigned id = tracers.ids()[p];
+        // rotated by 90 degrees: (x,y) -> (-y, x)
+        err_pos = std::max( err_pos, fabs( tracers.x()[p] + y[id]));
+        err_pos = std::max( err_pos, fabs( tracers.y()[p] - x[id]));
+    }
+    std::cout << "Time                               "<<t<<" ("<<M_PI/2.<<")\n";
+    std::cout << "Particles kept                     "<<tracers.size()<<" ("<<num<<")\n";
+    std::cout << "Max error in position             "<<err_pos<<" (small)\n";
+
+    // the same rotation with a first-same-as-last tableau
+    dg::Tracers2d<double> tracers_fsal( grid, x, y, "Dormand-Prince-7-4-5");
+    t = 0.;
+    for( unsigned i=0; i<100; i++)
+        tracers_fsal.step_ExB( phi, t, dt);
+    err_pos = 0;
+    for( unsigned p=0; p<tracers_fsal.size(); p++)
+    {
+        unsigned id = tracers_fsal.ids()[p];
+        err_pos = std::max( err_pos, fabs( tracers_fsal.x()[p] + y[id]));
+        err_pos = std::max( err_pos, fabs( tracers_fsal.y()[p] - x[id]));
+    }
+    std::cout << "Max error in position (FSAL)      "<<err_pos<<" (small)\n";
+    return 0;
+}
@@ -469,4 +469,197 @@ class TridiagInvD
     CooMatrix m_Tinv;
     unsigned m_size;
 };
+/**
+* @brief Compact representation of the inverse of a general tridiagonal matrix
+*        with \f$ \mathcal O(m)\f$ storage and application
+*
+* The inverse of an irreducible tridiagonal matrix is semiseparable, i.e. it is generated by three vectors:
+* \f[ (T^{-1})_{ij} = d_j \prod_{k=j+1}^{i} l_k \quad (i \geq j),\qquad (T^{-1})_{ij} = d_j \prod_{k=i}^{j-1} u_k \quad (i<j) \f]
+* with \f$ u_i = -b_i/r_i\f$, \f$ l_i = -c_{i-1}/s_i\f$ and \f$ d_i = 1/(r_i + s_i - a_i)\f$, where
+* \f$ r_0 = a_0,\ r_i = a_i - b_{i-1}c_{i-1}/r_{i-1}\f$ and \f$ s_{m-1} = a_{m-1},\ s_i = a_i - b_ic_i/s_{i+1}\f$
+* are the pivots of the forward and backward elimination.
+* These are the ratios of consecutive leading and trailing principal minors in the formula of
+* "Inversion of a Tridiagonal Jacobi Matrix" by Riaz A. Usmani (\c TridiagInvD); using the ratios instead of the minors avoids
+* their overflow for large \f$ m\f$ (cf. Y. Hu and S. O'Connell, "Analytical inversion of symmetric tridiagonal matrices").
+*
+* Computing the generators, applying \f$ T^{-1}\f$ to a vector and computing \f$ T^{-1} e_1\f$ all cost \f$ \mathcal O(m)\f$,
+* a single entry costs \f$ \mathcal O(|i-j|)\f$. The dense inverse is never formed.
+* The class can be used as a matrix in \c dg::blas2::symv, e.g. as the matrix of the square root solvers in matrixsqrt.h.
+* @code
+dg::TridiagInvCompact<dg::HVec, HDiaMatrix> Tinv( max_iter);
+Tinv.resize( iter);
+Tinv( T); //compute generators
+Tinv.inv_e1( y); // y = T^{-1} e_1
+dg::blas2::symv( Tinv, v, y); // y = T^{-1} v
+@endcode
+* @attention throws a \c dg::Error if a pivot vanishes (which cannot happen for symmetric positive definite T)
+* @ingroup invert
+*/
+template< class ContainerType, class DiaMatrix>
+class TridiagInvCompact
+{
+  public:
+    using value_type = dg::get_value_type<ContainerType>; //!< value type of the ContainerType class
+    ///@brief Allocate nothing, Call \c resize method before usage
+    TridiagInvCompact(){}
+    /**
+     * @brief Construct from vector
+     *
+     * @param copyable vector
+     */
+    TridiagInvCompact(const ContainerType& copyable)
+    {
+        resize( copyable.size());
+    }
+    /**
+     * @brief Construct from size of vector
+     *
+     * @param size size of vector
+     */
+    TridiagInvCompact(unsigned size)
+    {
+        resize( size);
+    }
+    /**
+     * @brief Resize the generators
+     *
+     * @param new_size new size of square matrix
+    */
+    void resize(unsigned new_size) {
+        m_size = new_size;
+        m_r.resize(m_size,0.);
+        m_s.resize(m_size,0.);
+        m_d.resize(m_size,0.);
+        m_l.resize(m_size,0.);
+        m_u.resize(m_size,0.);
+    }
+    ///@brief The current size of the matrix
+    ///@return size
+    unsigned size() const {return m_size;}
+    /**
+     * @brief Compute the generators of the inverse of a tridiagonal matrix T
+     *
+     * @param T tridiagonal matrix (only the upper left \c size() x \c size() block is used)
+     **/
+    void operator()(const DiaMatrix& T)
+    {
+        ContainerType alpha(m_size, 0.);
+        ContainerType beta(m_size, 0.);
+        ContainerType gamma(m_size, 0.);
+        for(unsigned i = 0; i<m_size; i++)
+        {
+            alpha[i] = T.values(i,1);    // 0 diagonal
+            beta[i]  = T.values(i,2);    // +1 diagonal
+            if( i+1 < (unsigned)T.num_rows)
+                gamma[i] = T.values(i+1,0);  // -1 diagonal
+        }
+        this->operator()(alpha, beta, gamma);
+    }
+     /**
+     * @brief Compute the generators of the inverse of a tridiagonal matrix with diagonal vectors a,b,c
+     *
+     * @param a  "0" diagonal vector ( 0...(size-1) )
+     * @param b "+1" diagonal vector ( 0...(size-2) )
+     * @param c "-1" diagonal vector ( 0...(size-2) )
+     */
+    template<class ContainerType0>
+    void operator()(const ContainerType0& a, const ContainerType0& b,  const ContainerType0& c)
+    {
+        if( m_size == 0)
+            return;
+        m_r[0] = a[0];
+        for( unsigned i=1; i<m_size; i++)
+        {
+            check( m_r[i-1], i-1);
+            m_r[i] = a[i] - b[i-1]*c[i-1]/m_r[i-1];
+        }
+        m_s[m_size-1] = a[m_size-1];
+        for( int i=(int)m_size-2; i>=0; i--)
+        {
+            check( m_s[i+1], i+1);
+            m_s[i] = a[i] - b[i]*c[i]/m_s[i+1];
+        }
+        for( unsigned i=0; i<m_size; i++)
+        {
+            value_type denom = m_r[i] + m_s[i] - a[i];
+            check( denom, i);
+            m_d[i] = 1./denom;
+            m_l[i] = i > 0 ? -c[i-1]/m_s[i] : 0.;
+            m_u[i] = i+1 < m_size ? -b[i]/m_r[i] : 0.;
+        }
+    }
+    /**
+     * @brief One element of the inverse
+     *
+     * @param i row index
+     * @param j column index
+     * @return \f$ (T^{-1})_{ij}\f$
+     */
+    value_type entry( unsigned i, unsigned j) const
+    {
+        value_type e = m_d[j];
+        if( i >= j)
+            for( unsigned k=j+1; k<=i; k++)
+                e *= m_l[k];
+        else
+            for( unsigned k=i; k<j; k++)
+                e *= m_u[k];
+        return e;
+    }
+    /**
+     * @brief \f$ y = T^{-1} e_1\f$
+     *
+     * @param y (write only) the first column of the inverse (is resized to \c size())
+     */
+    void inv_e1( ContainerType& y) const
+    {
+        y.resize( m_size);
+        if( m_size == 0)
+            return;
+        y[0] = m_d[0];
+        for( unsigned i=1; i<m_size; i++)
+            y[i] = m_l[i]*y[i-1];
+    }
+    /**
+     * @brief \f$ y = T^{-1} v\f$
+     *
+     * Sums the lower and the upper triangle of the inverse with one forward and one backward recursion
+     * @param v input vector of size \c size()
+     * @param y (write only) result of size \c size() (may not alias \c v)
+     */
+    template<class ContainerType0, class ContainerType1>
+    void symv( const ContainerType0& v, ContainerType1& y) const
+    {
+        if( m_size == 0)
+            return;
+        //lower triangle including diagonal
+        y[0] = m_d[0]*v[0];
+        for( unsigned i=1; i<m_size; i++)
+            y[i] = m_l[i]*y[i-1] + m_d[i]*v[i];
+        //upper triangle
+        value_type upper = 0.;
+        for( int i=(int)m_size-2; i>=0; i--)
+        {
+            upper = m_u[i]*(m_d[i+1]*v[i+1] + upper);
+            y[i] += upper;
+        }
+    }
+  private:
+    void check( value_type pivot, unsigned i) const
+    {
+        if( pivot == 0)
+            throw dg::Error( dg::Message(_ping_)<<"Vanishing pivot at index "<<i<<" in tridiagonal inversion!");
+    }
+    ContainerType m_r, m_s, m_d, m_l, m_u;
+    unsigned m_size = 0;
+};
+
+///@cond
+template< class ContainerType, class DiaMatrix>
+struct TensorTraits< TridiagInvCompact<ContainerType, DiaMatrix> >
+{
+    using value_type  = dg::get_value_type<ContainerType>;
+    using tensor_category = SelfMadeMatrixTag;
+};
+///@endcond
 }
@@ -83,6 +83,10 @@ int main()
     dg::TridiagInvD<Container, DiaMatrix, CooMatrix> tridiaginvD(a);
     t.toc();
     std::cout << "#Construction of Tridiagonal inversion D routine took "<< t.diff()<<"s \n";
+    t.tic();
+    dg::TridiagInvCompact<Container, DiaMatrix> tridiaginvC(a);
+    t.toc();
+    std::cout << "#Construction of Tridiagonal inversion Compact routine took "<< t.diff()<<"s \n";
     
     //Create Tridiagonal and fill matrix
     DiaMatrix T, Tsym; 
@@ -191,7 +195,16 @@ int main()
     std::cout <<  "    time: "<< t.diff()<<"s \n";
     std::cout <<  "    error_rel: " << sqrt(dg::blas1::dot(err,err)/dg::blas1::dot(x_symsol,x_symsol)) << "\n";
     std::cout <<  "    #error_rel in T_{m,1}: " << abs(Tsyminv.values[size-1] - Tsyminv_sol.values[size-1])/abs(Tsyminv_sol.values[size-1]) << "\n";
-    
+    std::cout << "InvtridiagCompact(Tsym):" << std::endl;
+    t.tic();
+    tridiaginvC(Tsym);
+    dg::blas2::symv(tridiaginvC, d, x);
+    t.toc();
+    dg::blas1::axpby(1.0, x, -1.0, x_symsol, err );
+    std::cout <<  "    time: "<< t.diff()<<"s \n";
+    std::cout <<  "    error_rel: " << sqrt(dg::blas1::dot(err,err)/dg::blas1::dot(x_symsol,x_symsol)) << "\n";
+    std::cout <<  "    #error_rel in T_{m,1}: " << abs(tridiaginvC.entry(0,size-1) - Tsyminv_sol.values[size-1])/abs(Tsyminv_sol.values[size-1]) << "\n";
+
 
     std::cout << "\n####Compute inverse of non-symmetric tridiagonal matrix\n";
     std::cout << "lGMRES:" << std::endl;
@@ -243,6 +256,14 @@ int main()
     dg::blas1::axpby(1.0, x, -1.0, x_sol, err );
     std::cout <<  "    time: "<< t.diff()<<"s \n";
     std::cout <<  "    error_rel: " << sqrt(dg::blas1::dot(err,err)/dg::blas1::dot(x_sol,x_sol)) << "\n";     
+    std::cout << "InvtridiagCompact(T):" << std::endl;
+    t.tic();
+    tridiaginvC(T);
+    dg::blas2::symv(tridiaginvC, d, x);
+    t.toc();
+    dg::blas1::axpby(1.0, x, -1.0, x_sol, err );
+    std::cout <<  "    time: "<< t.diff()<<"s \n";
+    std::cout <<  "    error_rel: " << sqrt(dg::blas1::dot(err,err)/dg::blas1::dot(x_sol,x_sol)) << "\n";
 
     return 0;
 }
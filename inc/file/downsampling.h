@@ -0,0 +1,362 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <netcdf.h>
+#include "thrust/host_vector.h"
+#include "thrust/copy.h"
+#include "thrust/gather.h"
+#include "thrust/device_vector.h"
+
+#include "dg/backend/exceptions.h"
+#include "dg/blas2.h"
+#include "dg/topology/evaluation.h"
+#include "dg/topology/fast_interpolation.h"
+#ifdef MPI_VERSION
+#include "dg/backend/mpi_vector.h"
+#include "dg/topology/mpi_grid.h"
+#endif //MPI_VERSION
+
+#include "nc_utilities.h"
+
+/*!@file
+ *
+ * Reduction of 3d output fields before they are written to file
+ */
+
+namespace dg
+{
+namespace file
+{
+
+/**
+ * @brief How a 3d field is reduced before it is written
+ *
+ * The stages are applied in the order in which the members are listed
+ * @ingroup netcdf
+ */
+struct DownsamplingParameters
+{
+    unsigned divide_n = 1; //!< the output has \c n/divide_n polynomial coefficients per cell
+    unsigned divide_Nx = 1; //!< \c divide_Nx cells in x are projected onto one output cell
+    unsigned divide_Ny = 1; //!< \c divide_Ny cells in y are projected onto one output cell
+    unsigned stride_Nz = 1; //!< only every \c stride_Nz th plane (starting with the first) is written
+    /// The region \f$ [x_0,x_1]\times[y_0,y_1]\f$ that is written; cells that overlap the region are kept
+    std::array<double,4> region = {
+        -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+};
+
+///@cond
+namespace detail
+{
+template<class real_type>
+RealGrid3d<real_type> local_grid( const aRealTopology3d<real_type>& g){ return RealGrid3d<real_type>(g);}
+template<class real_type>
+RealGrid3d<real_type> global_grid( const aRealTopology3d<real_type>& g){ return RealGrid3d<real_type>(g);}
+template<class Topology>
+get_host_vector<Topology> downsampling_vector( unsigned size, const Topology&, SharedVectorTag)
+{
+    return get_host_vector<Topology>( size);
+}
+#ifdef MPI_VERSION
+template<class real_type>
+RealGrid3d<real_type> local_grid( const aRealMPITopology3d<real_type>& g){ return g.local();}
+template<class real_type>
+RealGrid3d<real_type> global_grid( const aRealMPITopology3d<real_type>& g){ return g.global();}
+template<class Topology>
+get_host_vector<Topology> downsampling_vector( unsigned size, const Topology& g, MPIVectorTag)
+{
+    using container_type = typename get_host_vector<Topology>::container_type;
+    return get_host_vector<Topology>( container_type( size), g.communicator());
+}
+#endif //MPI_VERSION
+
+template<class Container>
+const auto& local_vector( const Container& v, SharedVectorTag){ return v;}
+template<class Container>
+const auto& local_vector( const Container& v, MPIVectorTag){ return v.data();}
+template<class Container>
+using get_local_vector = std::decay_t<decltype( local_vector( std::declval<Container>(), get_tensor_category<Container>()))>;
+//index vector in the same memory space as Vector
+template<class Vector>
+struct index_vector;
+template<class T>
+struct index_vector<thrust::host_vector<T>>{ using type = thrust::host_vector<int>;};
+template<class T>
+struct index_vector<thrust::device_vector<T>>{ using type = thrust::device_vector<int>;};
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Reduce 3d fields and write them to a netcdf file
+ *
+ * Any combination of
+ *  - polynomial order reduction and cell coarsening in x and y (with \c dg::create::fast_projection),
+ *  - writing only every \c stride_Nz th plane in z and
+ *  - cropping to a region of interest in x and y
+ *
+ * is applied before a field is written. Fields are projected on the device
+ * and only the selected points are copied to the host and written.
+ * @code
+dg::file::DownsamplingParameters params;
+params.divide_Nx = params.divide_Ny = 2, params.stride_Nz = 4;
+params.region = { 1.2, 1.6, -0.4, 0.4};
+dg::file::Downsampler<dg::x::DMatrix, dg::x::DVec> reduce( grid, params);
+DG_RANK0 err = reduce.define( ncid, &dim_ids[1], {"z_ne", "y_ne", "x_ne"});
+DG_RANK0 err = nc_def_var( ncid, "electrons", NC_DOUBLE, 4, dim_ids, &varID);
+...
+reduce.write( ncid, varID, slice, ne);
+ * @endcode
+ * @note In MPI each rank selects its part of the output and rank 0 in the
+ * communicator of the grid writes all parts, which means that only rank 0 needs
+ * to own the file. All members are to be called by all ranks, except \c define,
+ * which only rank 0 needs to call.
+ * @tparam Matrix The matrix type of the projection (e.g. \c dg::x::DMatrix)
+ * @tparam Container The vector type of the fields (e.g. \c dg::x::DVec)
+ * @ingroup netcdf
+ */
+template<class Matrix, class Container>
+struct Downsampler
+{
+    using container_type = Container;
+    using value_type = get_value_type<Container>;
+    using host_vector = thrust::host_vector<value_type>;
+    ///@brief No reduction
+    Downsampler() = default;
+    /**
+     * @brief Construct the projection and the selection
+     *
+     * @param g The grid on which the fields live (shared or MPI)
+     * @param params How to reduce the fields
+     * @attention \c g.n(), \c g.Nx() and \c g.Ny() must be divisible by
+     * \c divide_n, \c divide_Nx and \c divide_Ny and in MPI so must be the
+     * local number of cells
+     */
+    template<class Topology>
+    Downsampler( const Topology& g, DownsamplingParameters params)
+    {
+        if( params.stride_Nz == 0)
+            throw dg::Error( dg::Message(_ping_)<<"Downsampler: stride_Nz must not be zero!");
+        m_project = dg::create::fast_projection( g, params.divide_n,
+            params.divide_Nx, params.divide_Ny, dg::normed);
+        RealGrid3d<value_type> local = detail::local_grid( g);
+        RealGrid3d<value_type> global = detail::global_grid( g);
+        m_n = g.n()/params.divide_n;
+        m_gx = RealGrid1d<value_type>( global.x0(), global.x1(), m_n, global.Nx()/params.divide_Nx);
+        m_gy = RealGrid1d<value_type>( global.y0(), global.y1(), m_n, global.Ny()/params.divide_Ny);
+        m_gz = RealGrid1d<value_type>( global.z0(), global.z1(), 1, global.Nz());
+        m_sz = params.stride_Nz;
+        //region of interest in output cells
+        m_sel[0] = cell( params.region[0], m_gx, false), m_sel[1] = cell( params.region[1], m_gx, true);
+        m_sel[2] = cell( params.region[2], m_gy, false), m_sel[3] = cell( params.region[3], m_gy, true);
+        if( m_sel[0] >= m_sel[1] || m_sel[2] >= m_sel[3])
+            throw dg::Error( dg::Message(_ping_)<<"Downsampler: The region does not overlap the grid!");
+        //local part of the coarse grid
+        m_lNx = local.Nx()/params.divide_Nx, m_lNy = local.Ny()/params.divide_Ny, m_lNz = local.Nz();
+        m_ox = (unsigned)round( (local.x0()-global.x0())/m_gx.h());
+        m_oy = (unsigned)round( (local.y0()-global.y0())/m_gy.h());
+        m_oz = (unsigned)round( (local.z0()-global.z0())/m_gz.h());
+        // own part of the output (start z,y,x and count z,y,x)
+        unsigned xa = std::max( m_ox, m_sel[0]), xb = std::min( m_ox+m_lNx, m_sel[1]);
+        unsigned ya = std::max( m_oy, m_sel[2]), yb = std::min( m_oy+m_lNy, m_sel[3]);
+        unsigned za = (m_oz + m_sz - 1)/m_sz, zb = (m_oz + m_lNz + m_sz - 1)/m_sz;
+        if( xa >= xb || ya >= yb || za >= zb)
+            m_box = {0,0,0,0,0,0};
+        else
+            m_box = { za, m_n*(ya-m_sel[2]), m_n*(xa-m_sel[0]),
+                      zb-za, m_n*(yb-ya), m_n*(xb-xa)};
+        m_projected = dg::construct<Container>( detail::downsampling_vector(
+            m_n*m_n*m_lNx*m_lNy*m_lNz, g, get_tensor_category<get_host_vector<Topology>>()));
+        m_buffer.resize( m_box[3]*m_box[4]*m_box[5]);
+        //local indices of the selected points in the projected field
+        thrust::host_vector<int> idx( m_buffer.size());
+        const unsigned rows = m_n*m_lNy, cols = m_n*m_lNx;
+        const unsigned j0 = m_box[1] + m_n*m_sel[2] - m_n*m_oy;
+        const unsigned i0 = m_box[2] + m_n*m_sel[0] - m_n*m_ox;
+        unsigned pos = 0;
+        for( unsigned k=0; k<m_box[3]; k++)
+        {
+            unsigned plane = (m_box[0]+k)*m_sz - m_oz;
+            for( unsigned j=0; j<m_box[4]; j++)
+                for( unsigned i=0; i<m_box[5]; i++)
+                    idx[pos++] = (plane*rows + j0 + j)*cols + i0 + i;
+        }
+        m_idx = idx;
+        m_selected.resize( m_buffer.size());
+        m_boxes.assign( 1, m_box);
+#ifdef MPI_VERSION
+        init_mpi( g, get_tensor_category<Container>());
+#endif //MPI_VERSION
+    }
+
+    ///@brief The number of output points in z, y and x
+    std::array<size_t, 3> shape() const{
+        return {(m_gz.N()+m_sz-1)/m_sz, m_n*(m_sel[3]-m_sel[2]), m_n*(m_sel[1]-m_sel[0])};
+    }
+    ///@brief The number of values a field is reduced to
+    size_t size() const{
+        std::array<size_t, 3> s = shape();
+        return s[0]*s[1]*s[2];
+    }
+
+    /**
+     * @brief Define the dimensions of the reduced fields and their coordinate variables
+     *
+     * @param ncid file ID (the file must be in define mode)
+     * @param dim_ids (write-only) the three dimension IDs in the order z, y, x
+     * @param names The names of the dimensions and coordinate variables
+     * @return netcdf error code if any
+     * @note File stays in define mode
+     */
+    int define( int ncid, int* dim_ids, std::array<std::string,3> names = {"z", "y", "x"}) const
+    {
+        int retval, varIDs[3];
+        std::array<size_t,3> s = shape();
+        std::array<host_vector,3> coords;
+        host_vector absz = dg::create::abscissas( m_gz), absy = dg::create::abscissas( m_gy), absx = dg::create::abscissas( m_gx);
+        for( unsigned k=0; k<s[0]; k++)
+            coords[0].push_back( absz[k*m_sz]);
+        coords[1].assign( absy.begin() + m_n*m_sel[2], absy.begin() + m_n*m_sel[3]);
+        coords[2].assign( absx.begin() + m_n*m_sel[0], absx.begin() + m_n*m_sel[1]);
+        for( unsigned i=0; i<3; i++)
+        {
+            if( (retval = nc_def_dim( ncid, names[i].data(), s[i], &dim_ids[i]))){ return retval;}
+            if( (retval = nc_def_var( ncid, names[i].data(), getNCDataType<value_type>(), 1, &dim_ids[i], &varIDs[i]))){ return retval;}
+        }
+        if( (retval = nc_enddef(ncid)) ) {return retval;} //not necessary for NetCDF4 files
+        for( unsigned i=0; i<3; i++)
+            if( (retval = nc_put_var( ncid, varIDs[i], coords[i].data()))){ return retval;}
+        retval = nc_redef(ncid); //not necessary for NetCDF4 files
+        return retval;
+    }
+
+    /**
+     * @brief Reduce a time-dependent field and write one time slice
+     *
+     * @param ncid file ID (only accessed on rank 0)
+     * @param varid variable ID with the dimensions (time, z, y, x) as defined by \c define
+     * @param slice The time slice to write
+     * @param field The field on the grid given in the constructor
+     * @note throws a \c dg::file::NC_Error if an error occurs
+     */
+    void write( int ncid, int varid, unsigned slice, const Container& field)
+    {
+        select( field);
+        put( ncid, varid, {slice});
+    }
+    /**
+     * @brief Reduce a time-independent field and write it
+     *
+     * @param ncid file ID (only accessed on rank 0)
+     * @param varid variable ID with the dimensions (z, y, x) as defined by \c define
+     * @param field The field on the grid given in the constructor
+     * @note throws a \c dg::file::NC_Error if an error occurs
+     */
+    void write( int ncid, int varid, const Container& field)
+    {
+        select( field);
+        put( ncid, varid, {});
+    }
+    private:
+    //first cell that contains x (or one past the last cell that contains x if upper)
+    static unsigned cell( double x, const RealGrid1d<value_type>& g, bool upper)
+    {
+        double c = (x - g.x0())/g.h();
+        c = upper ? ceil( c) : floor( c);
+        return (unsigned)std::max( 0., std::min( c, (double)g.N()));
+    }
+    //project and gather the own part of the output on the device, then
+    //copy only the selected points into the host buffer
+    void select( const Container& field)
+    {
+        dg::blas2::symv( m_project, field, m_projected);
+        if( m_buffer.empty())
+            return;
+        const auto& local = detail::local_vector( m_projected, get_tensor_category<Container>());
+        thrust::gather( m_idx.begin(), m_idx.end(), local.begin(), m_selected.begin());
+        thrust::copy( m_selected.begin(), m_selected.end(), m_buffer.begin());
+    }
+    void put( int ncid, int varid, std::vector<size_t> time)
+    {
+        file::NC_Error_Handle err;
+        int rank = 0, size = 1;
+#ifdef MPI_VERSION
+        if( m_mpi)
+        {
+            MPI_Comm_rank( m_comm, &rank);
+            MPI_Comm_size( m_comm, &size);
+        }
+#endif //MPI_VERSION
+        if( rank == 0)
+        {
+            host_vector receive( m_buffer);
+            for( int r=0; r<size; r++)
+            {
+                const std::array<unsigned,6>& box = m_boxes[r];
+                size_t volume = box[3]*box[4]*box[5];
+                if( volume == 0)
+                    continue;
+#ifdef MPI_VERSION
+                if( r != 0)
+                {
+                    receive.resize( volume);
+                    MPI_Status status;
+                    MPI_Recv( receive.data(), volume, getMPIDataType<value_type>(),
+                        r, r, m_comm, &status);
+                }
+#endif //MPI_VERSION
+                std::vector<size_t> start( time), count( time.size(), 1);
+                for( unsigned i=0; i<3; i++)
+                {
+                    start.push_back( box[i]);
+                    count.push_back( box[3+i]);
+                }
+                err = nc_put_vara( ncid, varid, start.data(), count.data(), receive.data());
+            }
+        }
+#ifdef MPI_VERSION
+        else if( !m_buffer.empty())
+            MPI_Send( m_buffer.data(), m_buffer.size(), getMPIDataType<value_type>(),
+                0, rank, m_comm);
+        if( m_mpi)
+            MPI_Barrier( m_comm);
+#endif //MPI_VERSION
+    }
+#ifdef MPI_VERSION
+    template<class Topology>
+    void init_mpi( const Topology&, SharedVectorTag){}
+    template<class Topology>
+    void init_mpi( const Topology& g, MPIVectorTag)
+    {
+        m_mpi = true;
+        m_comm = g.communicator();
+        int size;
+        MPI_Comm_size( m_comm, &size);
+        m_boxes.resize( size);
+        MPI_Allgather( m_box.data(), 6, MPI_UNSIGNED, m_boxes[0].data(), 6,
+            MPI_UNSIGNED, m_comm);
+    }
+    bool m_mpi = false;
+    MPI_Comm m_comm;
+#endif //MPI_VERSION
+    dg::MultiMatrix<Matrix, Container> m_project;
+    Container m_projected;
+    detail::get_local_vector<Container> m_selected;
+    typename detail::index_vector<detail::get_local_vector<Container>>::type m_idx;
+    host_vector m_buffer;
+    RealGrid1d<value_type> m_gx, m_gy, m_gz;
+    unsigned m_n = 1, m_sz = 1;
+    unsigned m_lNx = 0, m_lNy = 0, m_lNz = 0, m_ox = 0, m_oy = 0, m_oz = 0;
+    std::array<unsigned,4> m_sel = {0,0,0,0}; //x0, x1, y0, y1 in output cells
+    std::array<unsigned,6> m_box = {0,0,0,0,0,0};
+    std::vector<std::array<unsigned,6>> m_boxes;
+};
+
+}//namespace file
+}//namespace dg
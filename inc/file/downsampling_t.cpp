@@ -0,0 +1,65 @@
+#include <iostream>
+#include <string>
+#include <netcdf.h>
+#include <cmath>
+
+#include "dg/algorithm.h"
+#define _FILE_INCLUDED_BY_DG_
+#include "downsampling.h"
+
+double function( double x, double y, double z){return x + 2.*y - z;}
+
+int main()
+{
+    std::cout << "WRITE REDUCED 3D FIELDS TO A NETCDF4 FILE AND READ THEM BACK\n";
+    dg::Grid3d g( 0, 4, 0, 8, 0, 2.*M_PI, 3, 20, 40, 8, dg::DIR, dg::DIR, dg::PER);
+    dg::file::DownsamplingParameters params;
+    params.divide_Nx = 2, params.divide_Ny = 4, params.stride_Nz = 3;
+    params.region = { 1.1, 2.9, -1., 5.};
+    dg::file::Downsampler<dg::DMatrix, dg::DVec> reduce( g, params);
+    std::array<size_t,3> shape = reduce.shape();
+    std::cout << "Shape "<<shape[0]<<" "<<shape[1]<<" "<<shape[2]<<" (3 21 18)\n";
+
+    int ncid, dim_ids[4], varID;
+    dg::file::NC_Error_Handle err;
+    err = nc_create( "downsampling.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+    err = nc_def_dim( ncid, "time", NC_UNLIMITED, &dim_ids[0]);
+    err = reduce.define( ncid, &dim_ids[1], {"z_f", "y_f", "x_f"});
+    err = nc_def_var( ncid, "f", NC_DOUBLE, 4, dim_ids, &varID);
+    err = nc_enddef( ncid);
+    dg::DVec f = dg::construct<dg::DVec>( dg::evaluate( function, g)), ft(f);
+    unsigned NT = 3;
+    for( unsigned i=0; i<NT; i++)
+    {
+        dg::blas1::axpby( (double)(i+1), f, 0., ft);
+        reduce.write( ncid, varID, i, ft);
+    }
+    err = nc_close( ncid);
+
+    err = nc_open( "downsampling.nc", NC_NOWRITE, &ncid);
+    std::array<dg::HVec,3> coords;
+    std::string names[3] = {"z_f", "y_f", "x_f"};
+    for( unsigned i=0; i<3; i++)
+    {
+        coords[i].resize( shape[i]);
+        err = nc_inq_varid( ncid, names[i].data(), &varID);
+        err = nc_get_var_double( ncid, varID, coords[i].data());
+    }
+    dg::HVec data( NT*reduce.size());
+    err = nc_inq_varid( ncid, "f", &varID);
+    err = nc_get_var_double( ncid, varID, data.data());
+    err = nc_close( ncid);
+    std::cout << "First and last x "<<coords[2][0]<<" "<<coords[2][shape[2]-1]<<" (within [0.8,3.2])\n";
+    double error = 0;
+    unsigned pos = 0;
+    for( unsigned t=0; t<NT; t++)
+    for( unsigned k=0; k<shape[0]; k++)
+    for( unsigned j=0; j<shape[1]; j++)
+    for( unsigned i=0; i<shape[2]; i++)
+    {
+        double ref = (t+1)*function( coords[2][i], coords[1][j], coords[0][k]);
+        error = std::max( error, fabs( data[pos++]-ref));
+    }
+    std::cout << "Max error in reduced values "<<error<<" (small)\n";
+    return 0;
+}
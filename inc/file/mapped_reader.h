@@ -0,0 +1,269 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <hdf5.h>
+#include "thrust/host_vector.h"
+
+#include "dg/backend/exceptions.h"
+#include "dg/backend/view.h"
+
+/*!@file
+ *
+ * Zero-copy read access to netcdf-4 files (link -lhdf5)
+ */
+
+namespace dg
+{
+namespace file
+{
+
+/**
+ * @brief Read-only access to the time slices of netcdf-4 variables without copies
+ *
+ * A netcdf-4 file is an hdf5 file in which each variable is a dataset.
+ * If the dataset is uncompressed and stored either contiguously or in chunks
+ * that contain whole time slices (the netcdf default for variables with
+ * an unlimited time dimension is one slice per chunk) then the file offset of
+ * each slice is resolved from the hdf5 index and the returned \c dg::View
+ * aliases the memory mapped file directly.
+ * Repeated reads of the same file then only touch the page cache.
+ * All other datasets are read with \c H5Dread into an internal buffer of the
+ * variable, such that the interface is the same in both cases.
+ * @code
+dg::file::MappedReader reader( "output.nc", true);
+for( unsigned i=0; i<reader.frames( "electrons"); i++)
+{
+    reader.prefetch( "electrons", i+1);
+    dg::View<const dg::HVec> ne = reader.frame( "electrons", i);
+    double mass = dg::blas1::dot( w2d, ne);
+}
+ * @endcode
+ * @note A slice is the hyperslab that contains all elements of one index in
+ * the first (slowest varying) dimension
+ * @attention Only \c double variables are supported. The file must not be
+ * modified while it is read.
+ * @ingroup netcdf
+ */
+struct MappedReader
+{
+    ///@brief No file
+    MappedReader() = default;
+    /**
+     * @brief Map a netcdf-4 file into memory
+     *
+     * @param filename name of the file
+     * @param sequential if \c true advise the kernel that the file is read
+     * sequentially, which enables aggressive read-ahead
+     */
+    MappedReader( std::string filename, bool sequential = false)
+    {
+        m_fd = ::open( filename.data(), O_RDONLY);
+        if( m_fd < 0)
+            throw dg::Error( dg::Message(_ping_)<<"Cannot open file "<<filename<<"!");
+        struct stat st;
+        if( fstat( m_fd, &st) != 0)
+        {
+            release();
+            throw dg::Error( dg::Message(_ping_)<<"Cannot stat file "<<filename<<"!");
+        }
+        m_size = st.st_size;
+        void* map = mmap( nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+        if( map == MAP_FAILED)
+        {
+            release();
+            throw dg::Error( dg::Message(_ping_)<<"Cannot map file "<<filename<<"!");
+        }
+        m_map = static_cast<const char*>( map);
+        if( sequential)
+            madvise( map, m_size, MADV_SEQUENTIAL);
+        m_file = H5Fopen( filename.data(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if( m_file < 0)
+        {
+            release();
+            throw dg::Error( dg::Message(_ping_)<<"File "<<filename<<" is no netcdf-4/hdf5 file!");
+        }
+    }
+    MappedReader( const MappedReader&) = delete;
+    MappedReader& operator=( const MappedReader&) = delete;
+    ~MappedReader(){
+        release();
+    }
+
+    /**
+     * @brief Number of slices of a variable
+     * @param name name of the variable
+     * @return size of the first dimension
+     */
+    size_t frames( std::string name){
+        return variable( name).frames;
+    }
+    /**
+     * @brief Number of elements in one slice of a variable
+     * @param name name of the variable
+     * @return product of the sizes of all but the first dimension
+     */
+    size_t slice_size( std::string name){
+        return variable( name).slice;
+    }
+    /**
+     * @brief If slices of a variable alias the mapped file
+     * @param name name of the variable
+     * @return \c false if slices are copied into a buffer
+     */
+    bool is_mapped( std::string name){
+        return variable( name).mapped;
+    }
+    /**
+     * @brief Read one slice of a variable
+     *
+     * @param name name of the variable
+     * @param idx index in the first dimension
+     * @return A view of the data. If the variable is mapped it is valid during
+     * the lifetime of \c *this, else until the next call with the same \c name
+     */
+    dg::View<const thrust::host_vector<double>> frame( std::string name, size_t idx)
+    {
+        Variable& var = variable( name);
+        if( idx >= var.frames)
+            throw dg::Error( dg::Message(_ping_)<<"Index "<<idx<<" out of range for variable "<<name<<" with "<<var.frames<<" frames!");
+        haddr_t address = var.mapped ? offset( var, idx) : HADDR_UNDEF;
+        if( address != HADDR_UNDEF && address % alignof(double) == 0
+            && address + var.slice*sizeof(double) <= m_size)
+            return { reinterpret_cast<const double*>( m_map + address), (unsigned)var.slice};
+        //read the slice into the buffer
+        var.buffer.resize( var.slice);
+        hid_t space = H5Dget_space( var.dset);
+        std::vector<hsize_t> start( var.dims.size(), 0), count( var.dims);
+        start[0] = idx, count[0] = 1;
+        H5Sselect_hyperslab( space, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+        hsize_t size = var.slice;
+        hid_t memspace = H5Screate_simple( 1, &size, nullptr);
+        herr_t status = H5Dread( var.dset, H5T_NATIVE_DOUBLE, memspace, space, H5P_DEFAULT, var.buffer.data());
+        H5Sclose( memspace);
+        H5Sclose( space);
+        if( status < 0)
+            throw dg::Error( dg::Message(_ping_)<<"Cannot read slice "<<idx<<" of variable "<<name<<"!");
+        return { var.buffer.data(), (unsigned)var.slice};
+    }
+    /**
+     * @brief Advise the kernel to read a slice into the page cache ahead of time
+     *
+     * Does nothing if the variable is not mapped or \c idx is out of range
+     * @param name name of the variable
+     * @param idx index in the first dimension
+     */
+    void prefetch( std::string name, size_t idx)
+    {
+        Variable& var = variable( name);
+        if( !var.mapped || idx >= var.frames)
+            return;
+        haddr_t address = offset( var, idx);
+        if( address == HADDR_UNDEF || address + var.slice*sizeof(double) > m_size)
+            return;
+        const size_t page = sysconf( _SC_PAGESIZE);
+        const size_t begin = address/page*page;
+        madvise( const_cast<char*>(m_map) + begin, address + var.slice*sizeof(double) - begin, MADV_WILLNEED);
+    }
+    private:
+    //close everything that is open, also on a partially constructed object
+    void release()
+    {
+        for( auto& pair : m_vars)
+            H5Dclose( pair.second.dset);
+        m_vars.clear();
+        if( m_file >= 0)
+            H5Fclose( m_file);
+        m_file = -1;
+        if( m_map != nullptr)
+            munmap( const_cast<char*>(m_map), m_size);
+        m_map = nullptr;
+        if( m_fd >= 0)
+            ::close( m_fd);
+        m_fd = -1;
+    }
+    struct Variable
+    {
+        hid_t dset;
+        std::vector<hsize_t> dims;
+        size_t frames = 1, slice = 1;
+        hsize_t chunk = 1; // slices per chunk
+        bool mapped = false, contiguous = false;
+        haddr_t address = HADDR_UNDEF; // of contiguous datasets
+        thrust::host_vector<double> buffer;
+    };
+    Variable& variable( const std::string& name)
+    {
+        if( m_file < 0)
+            throw dg::Error( dg::Message(_ping_)<<"No file is mapped!");
+        auto it = m_vars.find( name);
+        if( it != m_vars.end())
+            return it->second;
+        Variable var;
+        var.dset = H5Dopen2( m_file, name.data(), H5P_DEFAULT);
+        if( var.dset < 0)
+            throw dg::Error( dg::Message(_ping_)<<"Variable "<<name<<" not found!");
+        hid_t space = H5Dget_space( var.dset);
+        int ndims = H5Sget_simple_extent_ndims( space);
+        var.dims.resize( ndims > 0 ? ndims : 1, 1);
+        if( ndims > 0)
+            H5Sget_simple_extent_dims( space, var.dims.data(), nullptr);
+        H5Sclose( space);
+        var.frames = var.dims[0];
+        for( unsigned i=1; i<var.dims.size(); i++)
+            var.slice *= var.dims[i];
+
+        hid_t type = H5Dget_type( var.dset);
+        bool native = H5Tequal( type, H5T_NATIVE_DOUBLE) > 0;
+        H5Tclose( type);
+        hid_t dcpl = H5Dget_create_plist( var.dset);
+        H5D_layout_t layout = H5Pget_layout( dcpl);
+        if( native && layout == H5D_CONTIGUOUS)
+        {
+            var.contiguous = true;
+            var.address = H5Dget_offset( var.dset);
+            var.mapped = ( var.address != HADDR_UNDEF);
+        }
+        else if( native && layout == H5D_CHUNKED && H5Pget_nfilters( dcpl) == 0)
+        {
+            std::vector<hsize_t> chunk( var.dims.size());
+            H5Pget_chunk( dcpl, chunk.size(), chunk.data());
+            var.chunk = chunk[0];
+            var.mapped = true;
+            for( unsigned i=1; i<var.dims.size(); i++)
+                if( chunk[i] != var.dims[i])
+                    var.mapped = false;
+        }
+        H5Pclose( dcpl);
+        return m_vars.emplace( name, std::move(var)).first->second;
+    }
+    //file offset of slice idx or HADDR_UNDEF if not yet written
+    //(hdf5 addresses are absolute, i.e. they include a userblock)
+    haddr_t offset( const Variable& var, size_t idx) const
+    {
+        if( var.contiguous)
+            return var.address + idx*var.slice*sizeof(double);
+        std::vector<hsize_t> coord( var.dims.size(), 0);
+        coord[0] = idx - idx%var.chunk;
+        unsigned filter_mask = 0;
+        haddr_t address = HADDR_UNDEF;
+        hsize_t size = 0;
+        if( H5Dget_chunk_info_by_coord( var.dset, coord.data(), &filter_mask,
+                &address, &size) < 0 || address == HADDR_UNDEF)
+            return HADDR_UNDEF;
+        return address + (idx%var.chunk)*var.slice*sizeof(double);
+    }
+    int m_fd = -1;
+    hid_t m_file = -1;
+    const char* m_map = nullptr;
+    size_t m_size = 0;
+    std::map<std::string, Variable> m_vars;
+};
+
+}//namespace file
+}//namespace dg
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <netcdf.h>
+#include <cmath>
+
+#include "dg/algorithm.h"
+#define _FILE_INCLUDED_BY_DG_
+#include "nc_utilities.h"
+#include "mapped_reader.h"
+
+double function( double x, double y){return sin(x)*sin(y);}
+
+int main()
+{
+    std::cout << "WRITE A TIMEDEPENDENT AND A STATIC FIELD TO A NETCDF4 FILE AND MAP IT BACK\n";
+    dg::Grid2d g( 0, 2.*M_PI, 0, 2.*M_PI, 3, 20, 20, dg::PER, dg::PER);
+    unsigned NT = 10;
+    dg::HVec f = dg::evaluate( function, g), ft( f);
+
+    int ncid, dim_ids[3], tvarID, dataID, staticID;
+    dg::file::NC_Error_Handle err;
+    err = nc_create( "mapped.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+    err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g);
+    err = nc_def_var( ncid, "field", NC_DOUBLE, 3, dim_ids, &dataID);
+    err = nc_def_var( ncid, "static", NC_DOUBLE, 2, &dim_ids[1], &staticID);
+    err = nc_enddef( ncid);
+    err = nc_put_var_double( ncid, staticID, f.data());
+    size_t start[3] = {0, 0, 0}, count[3] = {1, g.n()*g.Ny(), g.n()*g.Nx()};
+    for( unsigned i=0; i<NT; i++)
+    {
+        start[0] = i;
+        double time = i;
+        dg::blas1::axpby( cos( time), f, 0., ft);
+        err = nc_put_vara_double( ncid, tvarID, start, count, &time);
+        err = nc_put_vara_double( ncid, dataID, start, count, ft.data());
+    }
+    err = nc_close( ncid);
+
+    dg::file::MappedReader reader( "mapped.nc", true);
+    std::cout << "Number of frames "<<reader.frames( "field")<<" ("<<NT<<")\n";
+    std::cout << "Field  is mapped "<<std::boolalpha<<reader.is_mapped( "field")<<"\n";
+    std::cout << "Static is mapped "<<std::boolalpha<<reader.is_mapped( "static")<<"\n";
+    double error = 0;
+    for( unsigned i=0; i<NT; i++)
+    {
+        reader.prefetch( "field", i+1);
+        dg::View<const dg::HVec> view = reader.frame( "field", i);
+        dg::blas1::axpby( cos( (double)i), f, 0., ft);
+        dg::blas1::axpby( 1., view, -1., ft);
+        error = std::max( error, dg::blas1::dot( ft, ft));
+    }
+    std::cout << "Max error in field  "<<error<<" (0)\n";
+    //the slices of a 2d variable are its rows
+    error = 0;
+    unsigned rows = reader.frames( "static"), slice = reader.slice_size( "static");
+    for( unsigned i=0; i<rows; i++)
+    {
+        dg::View<const dg::HVec> view = reader.frame( "static", i);
+        for( unsigned k=0; k<slice; k++)
+            error = std::max( error, fabs( view.data()[k] - f[i*slice+k]));
+    }
+    std::cout << "Max error in static "<<error<<" (0)\n";
+    return 0;
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <netcdf.h>
+#include "thrust/host_vector.h"
+#include "thrust/copy.h"
+
+#include "dg/backend/exceptions.h"
+#include "dg/blas2.h"
+#include "dg/topology/interpolation.h"
+#ifdef MPI_VERSION
+#include "dg/backend/mpi_vector.h"
+#include "dg/topology/mpi_projection.h"
+#endif //MPI_VERSION
+
+#include "nc_utilities.h"
+
+/*!@file
+ *
+ * Synthetic probes with buffered netcdf output
+ */
+
+namespace dg
+{
+namespace file
+{
+///@cond
+namespace detail
+{
+template<class real_type, class Topology>
+thrust::host_vector<real_type> probe_coordinates( const thrust::host_vector<real_type>& x, const Topology&, SharedVectorTag)
+{
+    return x;
+}
+template<class Topology>
+get_host_vector<Topology> probe_vector( unsigned size, const Topology&, SharedVectorTag)
+{
+    return get_host_vector<Topology>( size);
+}
+template<class Container>
+const Container& probe_data( const Container& v, SharedVectorTag)
+{
+    return v;
+}
+#ifdef MPI_VERSION
+//Only rank 0 in the communicator of the grid (the rank that owns the file) keeps the probes
+template<class real_type, class Topology>
+thrust::host_vector<real_type> probe_coordinates( const thrust::host_vector<real_type>& x, const Topology& g, MPIVectorTag)
+{
+    int rank;
+    MPI_Comm_rank( g.communicator(), &rank);
+    if( rank == 0)
+        return x;
+    return thrust::host_vector<real_type>();
+}
+template<class Topology>
+get_host_vector<Topology> probe_vector( unsigned size, const Topology& g, MPIVectorTag)
+{
+    using container_type = typename get_host_vector<Topology>::container_type;
+    return get_host_vector<Topology>( container_type( size), g.communicator());
+}
+template<class Container>
+const typename Container::container_type& probe_data( const Container& v, MPIVectorTag)
+{
+    return v.data();
+}
+#endif //MPI_VERSION
+}//namespace detail
+///@endcond
+
+/**
+ * @brief Synthetic probes: time series of fields at fixed points with buffered netcdf output
+ *
+ * The fields are interpolated to the probe positions with a single
+ * interpolation matrix that is assembled once in the constructor. The probe
+ * values are appended to a host buffer with every call to \c buffer and
+ * written to file only in \c flush, with one \c nc_put_vara call per
+ * variable for all buffered time steps. This makes it cheap to record
+ * probe data at every time step of a simulation.
+ *
+ * In the file each field is a variable with dimensions (time, probe), where
+ * time is an unlimited dimension of its own.
+ * @code
+dg::file::Probes<dg::x::IDMatrix, dg::x::DVec> probes( R, Z, P, grid,
+    {"electrons_probes", "potential_probes"}, 100);
+DG_RANK0 err = nc_create( "file.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+DG_RANK0 err = probes.define( ncid);
+DG_RANK0 err = nc_close( ncid);
+for( unsigned i=0; i<steps; i++)
+{
+    stepper.step( rhs, time, y0);
+    probes.buffer( time, {&ne, &phi});
+    if( probes.full())
+    {
+        DG_RANK0 err = nc_open( "file.nc", NC_WRITE, &ncid);
+        err = probes.flush( ncid); // the buffer is emptied on all ranks
+        DG_RANK0 err = nc_close( ncid);
+    }
+}
+ * @endcode
+ * @note In MPI all probe values are gathered by the interpolation matrix on
+ * rank 0 in the communicator of the grid, which is the rank that must own the file. All
+ * members are to be called by all ranks, the ones that write to file only
+ * access \c ncid on rank 0.
+ * @tparam IMatrix The interpolation matrix type (e.g. \c dg::x::IDMatrix)
+ * @tparam Container The vector type of the fields (e.g. \c dg::x::DVec)
+ * @ingroup netcdf
+ */
+template<class IMatrix, class Container>
+struct Probes
+{
+    using matrix_type = IMatrix;
+    using container_type = Container;
+    using value_type = get_value_type<Container>;
+    using host_vector = thrust::host_vector<value_type>;
+    ///@brief No probes
+    Probes() = default;
+    /**
+     * @brief Construct 2d probes
+     *
+     * @param x x-coordinates of the probes
+     * @param y y-coordinates of the probes
+     * @param g The grid on which the fields live (shared or MPI)
+     * @param names The names of the fields, each field is one variable in the file
+     * @param buffer_size The number of time steps that can be buffered
+     * before \c flush must be called
+     */
+    template<class Topology>
+    Probes( const host_vector& x, const host_vector& y, const Topology& g,
+        std::vector<std::string> names, unsigned buffer_size = 100)
+    {
+        if( x.size() != y.size())
+            throw dg::Error( dg::Message(_ping_)<<"Probes: x has "<<x.size()<<" and y "<<y.size()<<" coordinates!");
+        get_tensor_category<get_host_vector<Topology>> tag;
+        host_vector xs = detail::probe_coordinates( x, g, tag);
+        host_vector ys = detail::probe_coordinates( y, g, tag);
+        dg::blas2::transfer( dg::create::interpolation( xs, ys, g, g.bcx(),
+                    g.bcy()), m_interpolate);
+        m_values = dg::construct<Container>( detail::probe_vector( xs.size(), g, tag));
+        init( {xs, ys}, names, buffer_size);
+    }
+    /**
+     * @brief Construct 3d probes
+     *
+     * @param x x-coordinates of the probes (e.g. R)
+     * @param y y-coordinates of the probes (e.g. Z)
+     * @param z z-coordinates of the probes (e.g. \f$ \varphi\f$)
+     * @param g The grid on which the fields live (shared or MPI)
+     * @param names The names of the fields, each field is one variable in the file
+     * @param buffer_size The number of time steps that can be buffered
+     * before \c flush must be called
+     */
+    template<class Topology>
+    Probes( const host_vector& x, const host_vector& y, const host_vector& z,
+        const Topology& g, std::vector<std::string> names, unsigned buffer_size = 100)
+    {
+        if( x.size() != y.size() || x.size() != z.size())
+            throw dg::Error( dg::Message(_ping_)<<"Probes: x has "<<x.size()<<", y "<<y.size()<<" and z "<<z.size()<<" coordinates!");
+        get_tensor_category<get_host_vector<Topology>> tag;
+        host_vector xs = detail::probe_coordinates( x, g, tag);
+        host_vector ys = detail::probe_coordinates( y, g, tag);
+        host_vector zs = detail::probe_coordinates( z, g, tag);
+        dg::blas2::transfer( dg::create::interpolation( xs, ys, zs, g,
+                    g.bcx(), g.bcy(), g.bcz()), m_interpolate);
+        m_values = dg::construct<Container>( detail::probe_vector( xs.size(), g, tag));
+        init( {xs, ys, zs}, names, buffer_size);
+    }
+
+    ///@brief The number of probes (0 on all but rank 0 in MPI)
+    unsigned size() const{ return m_num;}
+    ///@brief The number of time steps that fit into the buffer
+    unsigned buffer_size() const{ return m_times.size();}
+    ///@brief The number of time steps currently in the buffer
+    unsigned buffered() const{ return m_filled;}
+    ///@brief The number of time steps written to file so far
+    unsigned written() const{ return m_written;}
+    ///@brief True if \c buffer cannot be called before the next \c flush
+    bool full() const{ return m_filled == m_times.size();}
+
+    /**
+     * @brief Define the probe dimensions and variables in an open file
+     *
+     * Defines an unlimited dimension and variable \c prefix+"_time", a
+     * dimension \c prefix of size \c size() with the coordinate variables
+     * \c prefix+"_x", \c prefix+"_y" (and \c prefix+"_z"), which are
+     * written, and one variable with dimensions (\c prefix+"_time", \c prefix)
+     * for each name given in the constructor.
+     * @param ncid file ID (the file must be in define mode)
+     * @param prefix The name of the probe dimension
+     * @return netcdf error code if any
+     * @note File stays in define mode
+     */
+    int define( int ncid, std::string prefix = "probe")
+    {
+        int retval = NC_NOERR;
+        if( m_num == 0)
+            return retval;
+        int dimIDs[2];
+        std::string time = prefix+"_time";
+        if( (retval = define_real_time<value_type>( ncid, time.data(), &dimIDs[0], &m_tvarID))){ return retval;}
+        if( (retval = nc_def_dim( ncid, prefix.data(), m_num, &dimIDs[1]))){ return retval;}
+        std::vector<int> coordIDs( m_coords.size());
+        std::string axes = "xyz";
+        for( unsigned i=0; i<m_coords.size(); i++)
+        {
+            std::string name = prefix+"_"+axes[i];
+            if( (retval = nc_def_var( ncid, name.data(), getNCDataType<value_type>(), 1, &dimIDs[1], &coordIDs[i]))){ return retval;}
+        }
+        m_varIDs.resize( m_names.size());
+        for( unsigned k=0; k<m_names.size(); k++)
+            if( (retval = nc_def_var( ncid, m_names[k].data(), getNCDataType<value_type>(), 2, dimIDs, &m_varIDs[k]))){ return retval;}
+        if( (retval = nc_enddef(ncid)) ) {return retval;} //not necessary for NetCDF4 files
+        for( unsigned i=0; i<m_coords.size(); i++)
+            if( (retval = nc_put_var( ncid, coordIDs[i], m_coords[i].data()))){ return retval;}
+        retval = nc_redef(ncid); //not necessary for NetCDF4 files
+        return retval;
+    }
+
+    /**
+     * @brief Interpolate fields to the probes and append the values to the buffer
+     *
+     * @param time The time of the fields
+     * @param fields The fields in the order of the names given in the constructor
+     * @attention throws a \c dg::Error if the buffer is \c full()
+     */
+    void buffer( value_type time, const std::vector<const Container*>& fields)
+    {
+        if( fields.size() != m_names.size())
+            throw dg::Error( dg::Message(_ping_)<<"Probes: "<<fields.size()<<" fields given but "<<m_names.size()<<" are defined!");
+        if( full())
+            throw dg::Error( dg::Message(_ping_)<<"Probes: buffer of size "<<buffer_size()<<" is full! Call flush first.");
+        m_times[m_filled] = time;
+        for( unsigned k=0; k<fields.size(); k++)
+        {
+            dg::blas2::symv( m_interpolate, *fields[k], m_values);
+            const auto& values = detail::probe_data( m_values,
+                get_tensor_category<Container>());
+            thrust::copy( values.begin(), values.end(), m_buffer.begin() +
+                (k*buffer_size() + m_filled)*m_num);
+        }
+        m_filled++;
+    }
+
+    /**
+     * @brief Write all buffered time steps to file and empty the buffer
+     *
+     * @param ncid file ID (the file must be open and contain the
+     * definitions made in \c define)
+     * @return netcdf error code if any
+     */
+    int flush( int ncid)
+    {
+        int retval = NC_NOERR;
+        if( m_num > 0 && m_filled > 0)
+        {
+            size_t start[2] = {m_written, 0}, count[2] = {m_filled, m_num};
+            if( (retval = nc_put_vara( ncid, m_tvarID, start, count, m_times.data()))){ return retval;}
+            for( unsigned k=0; k<m_names.size(); k++)
+                if( (retval = nc_put_vara( ncid, m_varIDs[k], start, count,
+                        &m_buffer[k*buffer_size()*m_num]))){ return retval;}
+        }
+        m_written += m_filled;
+        m_filled = 0;
+        return retval;
+    }
+    private:
+    void init( std::vector<host_vector> coords, std::vector<std::string> names, unsigned buffer_size)
+    {
+        if( buffer_size == 0)
+            throw dg::Error( dg::Message(_ping_)<<"Probes: buffer size must not be zero!");
+        m_coords = coords;
+        m_names = names;
+        m_num = coords[0].size();
+        m_times.resize( buffer_size);
+        m_buffer.resize( names.size()*buffer_size*m_num);
+    }
+    IMatrix m_interpolate;
+    Container m_values;
+    std::vector<host_vector> m_coords;
+    std::vector<std::string> m_names;
+    host_vector m_times, m_buffer;
+    size_t m_num = 0, m_filled = 0, m_written = 0;
+    int m_tvarID = 0;
+    std::vector<int> m_varIDs;
+};
+
+}//namespace file
+}//namespace dg
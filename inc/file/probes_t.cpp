@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <netcdf.h>
+#include <cmath>
+
+#include "dg/algorithm.h"
+#define _FILE_INCLUDED_BY_DG_
+#include "probes.h"
+
+double function( double x, double y){return sin(x)*sin(y);}
+
+int main()
+{
+    std::cout << "WRITE BUFFERED PROBE DATA TO A NETCDF4 FILE AND READ IT BACK\n";
+    dg::Grid2d g( 0, 2.*M_PI, 0, 2.*M_PI, 3, 20, 20, dg::PER, dg::PER);
+    unsigned num = 5, NT = 25;
+    dg::HVec x( num), y( num);
+    for( unsigned i=0; i<num; i++)
+        x[i] = 0.3+1.1*i, y[i] = 0.7+0.9*i;
+    dg::file::Probes<dg::IDMatrix, dg::DVec> probes( x, y, g, {"probe_f", "probe_g"}, 10);
+
+    int ncid;
+    dg::file::NC_Error_Handle err;
+    err = nc_create( "probes.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+    err = probes.define( ncid);
+    err = nc_close( ncid);
+
+    dg::DVec f = dg::construct<dg::DVec>( dg::evaluate( function, g)), ft(f), gt(f);
+    double dt = 0.1;
+    for( unsigned i=0; i<NT; i++)
+    {
+        double time = i*dt;
+        dg::blas1::axpby( cos( time), f, 0., ft);
+        dg::blas1::axpby( sin( time), f, 0., gt);
+        probes.buffer( time, {&ft, &gt});
+        if( probes.full())
+        {
+            err = nc_open( "probes.nc", NC_WRITE, &ncid);
+            err = probes.flush( ncid);
+            err = nc_close( ncid);
+        }
+    }
+    err = nc_open( "probes.nc", NC_WRITE, &ncid);
+    err = probes.flush( ncid);
+    err = nc_close( ncid);
+    std::cout << "Written time steps "<<probes.written()<<" ("<<NT<<")\n";
+
+    err = nc_open( "probes.nc", NC_NOWRITE, &ncid);
+    int varID;
+    size_t length;
+    err = nc_inq_dimid( ncid, "probe_time", &varID);
+    err = nc_inq_dimlen( ncid, varID, &length);
+    std::cout << "Length of time dimension "<<length<<" ("<<NT<<")\n";
+    dg::HVec data( NT*num), times( NT);
+    err = nc_inq_varid( ncid, "probe_time", &varID);
+    err = nc_get_var_double( ncid, varID, times.data());
+    err = nc_inq_varid( ncid, "probe_g", &varID);
+    err = nc_get_var_double( ncid, varID, data.data());
+    err = nc_close( ncid);
+    double error = 0;
+    for( unsigned i=0; i<NT; i++)
+        for( unsigned k=0; k<num; k++)
+        {
+            double ref = sin( times[i])*function( x[k], y[k]);
+            error = std::max( error, fabs( data[i*num+k]-ref));
+        }
+    std::cout << "Max error in probe values "<<error<<" (small)\n";
+    return 0;
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <netcdf.h>
+
+#include "dg/backend/exceptions.h"
+
+/*!@file
+ *
+ * Batched variable definitions and buffered time series output
+ */
+
+namespace dg
+{
+namespace file
+{
+
+/**
+ * @brief Define all variables of a file at once and write small time series in blocks
+ *
+ * In netcdf-4 files every \c nc_enddef / \c nc_redef cycle rewrites the
+ * metadata and every write of a single time step of a scalar or 1d variable is
+ * a separate hdf5 call. This class
+ *  - collects variable definitions (and their attributes) and makes them in a
+ *  single \c define call that leaves define mode exactly once,
+ *  - caches the variable IDs by name (also those of existing variables with \c inquire) and
+ *  - buffers consecutive time slices of 0d and 1d variables, i.e. variables with
+ *  dimensions (time) or (time, x), and writes them with one \c nc_put_vara per variable in \c flush.
+ * @code
+dg::file::Writer writer;
+writer.def_var( "time", {dim_ids[0]}, "Time");
+writer.def_var( "mass", {dim_ids[0]}, "Total mass");
+writer.def_var( "electrons", {dim_ids[0], dim_ids[1], dim_ids[2]}, "Electron density");
+err = writer.define( ncid); //file is in data mode afterwards
+for( unsigned i=0; i<maxout; i++)
+{
+    writer.stage( "time", i, time);
+    writer.stage( "mass", i, mass);
+    dg::file::put_vara_double( ncid, writer.id( "electrons"), i, grid, ne);
+    if( writer.buffered() == 100)
+        err = writer.flush( ncid);
+}
+err = writer.flush( ncid);
+ * @endcode
+ * @note In MPI only the rank that owns the file should be active. Inactive
+ * ranks make no netcdf calls, buffer nothing and return the ID 0 for all declared variables.
+ * This allows to call all members on all ranks.
+ * @attention Only \c double variables can be buffered
+ * @ingroup netcdf
+ */
+struct Writer
+{
+    /**
+     * @brief No variables
+     * @param active if \c false no netcdf calls are made (use \c rank==0 in MPI)
+     */
+    Writer( bool active = true) : m_active( active){}
+
+    /**
+     * @brief Declare a variable that is defined in the next call to \c define
+     *
+     * @param name name of the variable
+     * @param dim_ids dimension IDs (the first one is the slowest varying)
+     * @param long_name if not empty, the "long_name" attribute of the variable
+     * @param xtype netcdf type of the variable
+     * @attention throws a \c dg::Error if a variable with the same name was declared before
+     */
+    void def_var( std::string name, std::vector<int> dim_ids,
+        std::string long_name = "", nc_type xtype = NC_DOUBLE)
+    {
+        if( m_ids.count( name))
+            throw dg::Error( dg::Message(_ping_)<<"Writer: Variable "<<name<<" is already declared!");
+        m_pending.push_back( {name, dim_ids, xtype});
+        m_ids[name] = 0;
+        if( !long_name.empty())
+            m_text_atts.push_back( {name, "long_name", long_name});
+    }
+    /**
+     * @brief Declare a text attribute of a declared variable
+     *
+     * @param name name of a variable declared with \c def_var or \c inquire
+     * @param att_name name of the attribute
+     * @param value value of the attribute
+     */
+    void def_att( std::string name, std::string att_name, std::string value)
+    {
+        id( name);
+        m_text_atts.push_back( {name, att_name, value});
+    }
+    /**
+     * @brief Declare a numerical attribute of a declared variable
+     *
+     * @param name name of a variable declared with \c def_var or \c inquire
+     * @param att_name name of the attribute
+     * @param values values of the attribute
+     */
+    void def_att( std::string name, std::string att_name, std::vector<double> values)
+    {
+        id( name);
+        m_double_atts.push_back( {name, att_name, values});
+    }
+    /**
+     * @brief Define all declared variables and attributes and leave define mode
+     *
+     * @param ncid file ID (the file may be in define or data mode)
+     * @return netcdf error code if any
+     * @note File is in data mode afterwards
+     */
+    int define( int ncid)
+    {
+        int retval = NC_NOERR;
+        if( !m_active)
+        {
+            clear_pending();
+            return retval;
+        }
+        if( !m_pending.empty() || !m_text_atts.empty() || !m_double_atts.empty())
+        {
+            retval = nc_redef( ncid);
+            if( retval != NC_NOERR && retval != NC_EINDEFINE){ return retval;}
+        }
+        for( auto& var : m_pending)
+            if( (retval = nc_def_var( ncid, var.name.data(), var.xtype,
+                    var.dim_ids.size(), var.dim_ids.data(), &m_ids.at(var.name)))){ return retval;}
+        for( auto& att : m_text_atts)
+            if( (retval = nc_put_att_text( ncid, m_ids.at(att.var), att.name.data(),
+                    att.value.size(), att.value.data()))){ return retval;}
+        for( auto& att : m_double_atts)
+            if( (retval = nc_put_att_double( ncid, m_ids.at(att.var), att.name.data(),
+                    NC_DOUBLE, att.value.size(), att.value.data()))){ return retval;}
+        clear_pending();
+        retval = nc_enddef( ncid);
+        if( retval == NC_ENOTINDEFINE)
+            retval = NC_NOERR;
+        return retval;
+    }
+    /**
+     * @brief Look up an existing variable in a file and cache its ID
+     *
+     * @param ncid file ID
+     * @param name name of the variable
+     * @return netcdf error code if any (e.g. \c NC_ENOTVAR if the variable does not exist)
+     */
+    int inquire( int ncid, std::string name)
+    {
+        int varID = 0, retval = NC_NOERR;
+        if( m_active && (retval = nc_inq_varid( ncid, name.data(), &varID))){ return retval;}
+        m_ids[name] = varID;
+        return retval;
+    }
+    /**
+     * @brief The ID of a defined or inquired variable
+     *
+     * @param name name of the variable
+     * @return cached variable ID
+     * @attention throws a \c dg::Error if \c name was neither declared nor inquired
+     */
+    int id( const std::string& name) const
+    {
+        auto it = m_ids.find( name);
+        if( it == m_ids.end())
+            throw dg::Error( dg::Message(_ping_)<<"Writer: Variable "<<name<<" is unknown!");
+        return it->second;
+    }
+
+    /**
+     * @brief Buffer one time slice of a 1d variable
+     *
+     * @param name name of a variable with dimensions (time, x)
+     * @param slice index in the time dimension; between two calls to \c flush the
+     * slices of a variable must be consecutive
+     * @param data the values (all slices of a variable must have the same size)
+     * @tparam ContainerType a host container with \c begin() and \c end()
+     * @attention throws a \c dg::Error if \c slice or the size does not continue the buffered slices
+     */
+    template<class ContainerType>
+    void stage( const std::string& name, size_t slice, const ContainerType& data)
+    {
+        if( !m_active)
+            return;
+        id( name);
+        Series& s = m_series[name];
+        size_t size = data.end() - data.begin();
+        if( s.slices == 0)
+            s.start = slice, s.size = size;
+        else if( slice != s.start + s.slices || size != s.size)
+            throw dg::Error( dg::Message(_ping_)<<"Writer: Slice "<<slice<<" of size "<<size<<" of variable "<<name<<" does not continue the buffered slices "<<s.start<<" to "<<s.start+s.slices-1<<" of size "<<s.size<<"! Call flush first.");
+        s.data.insert( s.data.end(), data.begin(), data.end());
+        s.slices++;
+    }
+    /**
+     * @brief Buffer one time slice of a 0d variable
+     *
+     * @param name name of a variable with dimension (time)
+     * @param slice index in the time dimension; between two calls to \c flush the
+     * slices of a variable must be consecutive
+     * @param value the value
+     */
+    void stage( const std::string& name, size_t slice, double value)
+    {
+        stage( name, slice, std::vector<double>( 1, value));
+    }
+    /// @brief The largest number of slices buffered for any variable
+    size_t buffered() const
+    {
+        size_t slices = 0;
+        for( auto& pair : m_series)
+            slices = std::max( slices, pair.second.slices);
+        return slices;
+    }
+    /**
+     * @brief Write all buffered slices to file and empty the buffers
+     *
+     * @param ncid file ID (the file must be in data mode)
+     * @return netcdf error code if any
+     */
+    int flush( int ncid)
+    {
+        int retval = NC_NOERR;
+        for( auto& pair : m_series)
+        {
+            Series& s = pair.second;
+            if( s.slices == 0)
+                continue;
+            size_t start[2] = {s.start, 0}, count[2] = {s.slices, s.size};
+            if( (retval = nc_put_vara_double( ncid, id( pair.first), start, count,
+                    s.data.data()))){ return retval;}
+            s.data.clear();
+            s.slices = 0;
+        }
+        return retval;
+    }
+    private:
+    struct Variable
+    {
+        std::string name;
+        std::vector<int> dim_ids;
+        nc_type xtype;
+    };
+    template<class T>
+    struct Attribute
+    {
+        std::string var, name;
+        T value;
+    };
+    struct Series
+    {
+        size_t start = 0, slices = 0, size = 0;
+        std::vector<double> data;
+    };
+    void clear_pending()
+    {
+        m_pending.clear();
+        m_text_atts.clear();
+        m_double_atts.clear();
+    }
+    bool m_active = true;
+    std::map<std::string, int> m_ids;
+    std::vector<Variable> m_pending;
+    std::vector<Attribute<std::string>> m_text_atts;
+    std::vector<Attribute<std::vector<double>>> m_double_atts;
+    std::map<std::string, Series> m_series;
+};
+
+}//namespace file
+}//namespace dg
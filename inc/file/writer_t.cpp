@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include <netcdf.h>
+#include <cmath>
+
+#include "dg/algorithm.h"
+#define _FILE_INCLUDED_BY_DG_
+#include "nc_utilities.h"
+#include "writer.h"
+
+double function( double x){return sin(x);}
+
+int main()
+{
+    std::cout << "DEFINE ALL VARIABLES AT ONCE AND WRITE BUFFERED TIME SERIES\n";
+    dg::Grid1d g( 0, 2.*M_PI, 3, 10);
+    int ncid, dim_ids[2], tvarID;
+    dg::file::NC_Error_Handle err;
+    err = nc_create( "writer.nc", NC_NETCDF4|NC_CLOBBER, &ncid);
+    err = dg::file::define_dimensions( ncid, dim_ids, &tvarID, g);
+    dg::file::Writer writer;
+    err = writer.inquire( ncid, "time");
+    writer.def_var( "f", {dim_ids[1]}, "Static function");
+    writer.def_var( "mass", {dim_ids[0]}, "Time dependent scalar");
+    writer.def_var( "g", {dim_ids[0], dim_ids[1]}, "Time dependent function");
+    writer.def_att( "g", "bounds", std::vector<double>{ g.x0(), g.x1()});
+    err = writer.define( ncid);
+    dg::HVec f = dg::evaluate( function, g), gt(f);
+    err = nc_put_var_double( ncid, writer.id( "f"), f.data());
+    unsigned NT = 25;
+    double dt = 0.1;
+    for( unsigned i=0; i<NT; i++)
+    {
+        double time = i*dt;
+        dg::blas1::axpby( cos( time), f, 0., gt);
+        writer.stage( "time", i, time);
+        writer.stage( "mass", i, cos(time));
+        writer.stage( "g", i, gt);
+        if( writer.buffered() == 10)
+            err = writer.flush( ncid);
+    }
+    err = writer.flush( ncid);
+    err = nc_close( ncid);
+
+    err = nc_open( "writer.nc", NC_NOWRITE, &ncid);
+    size_t length;
+    int dimID, varID;
+    err = nc_inq_dimid( ncid, "time", &dimID);
+    err = nc_inq_dimlen( ncid, dimID, &length);
+    std::cout << "Length of time dimension "<<length<<" ("<<NT<<")\n";
+    dg::HVec data( NT*g.size()), times( NT), mass( NT);
+    err = nc_inq_varid( ncid, "time", &varID);
+    err = nc_get_var_double( ncid, varID, times.data());
+    err = nc_inq_varid( ncid, "mass", &varID);
+    err = nc_get_var_double( ncid, varID, mass.data());
+    err = nc_inq_varid( ncid, "g", &varID);
+    err = nc_get_var_double( ncid, varID, data.data());
+    double bounds[2];
+    err = nc_get_att_double( ncid, varID, "bounds", bounds);
+    err = nc_close( ncid);
+    double error = 0;
+    for( unsigned i=0; i<NT; i++)
+    {
+        error = std::max( error, fabs( times[i]-i*dt));
+        error = std::max( error, fabs( mass[i]-cos( i*dt)));
+        for( unsigned k=0; k<g.size(); k++)
+            error = std::max( error, fabs( data[i*g.size()+k]-cos(i*dt)*f[k]));
+    }
+    std::cout << "Max error in written values "<<error<<" (0)\n";
+    std::cout << "Bounds attribute "<<bounds[0]<<" "<<bounds[1]<<" (0 "<<2.*M_PI<<")\n";
+    return 0;
+}
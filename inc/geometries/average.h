@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <thrust/host_vector.h>
+#include <thrust/scan.h>
 #include "dg/topology/weights.h"
 #include "magnetic_field.h"
 #include "flux.h"
@@ -141,6 +144,193 @@ struct FluxVolumeIntegral
     const container m_w2d;
 };
 
+/**
+ * @brief Flux surface and flux volume integrals for many psi values at once
+ *
+ * Computes the same quantities as \c FluxSurfaceIntegral and \c FluxVolumeIntegral
+ \f[ I_j = \int dR dZ f(R,Z) \delta(\psi_p(R,Z)-\psi_j) g(R,Z) \qquad
+ V_j = \int dR dZ f(R,Z) \Theta(\psi_j-\psi_p(R,Z)) g(R,Z) \f]
+ for all values \f$ \psi_j\f$ of a given list in one pass over the 2d grid.
+ In the constructor each quadrature point is assigned once to all \f$\psi_j\f$
+ for which its (truncated) Gaussian delta weight is non-negligible
+ and to the \f$\psi\f$ interval it lies in. Both assignments are stored as sparse
+ matrices such that a whole profile costs one \c dg::blas1::pointwiseDot and
+ one sparse matrix-vector product (plus a scan for the volume)
+ instead of one full 2d sweep per \f$\psi_j\f$.
+ The result is reproducible since every \f$ I_j\f$ is summed in a fixed order.
+ * @note The delta function is truncated where it falls below machine precision
+ * relative to its maximum, so results agree with \c FluxSurfaceIntegral up to round-off
+ * @note Shared memory only: \c container must be a shared vector (e.g. \c dg::HVec
+ * or \c dg::DVec) and \c g2d a shared memory grid, since the profile matrices
+ * index the whole 2d grid and the volume is accumulated with \c thrust::inclusive_scan
+ * over the local vector. In MPI programs gather the 2d fields to one rank
+ * (or use \c FluxSurfaceIntegral and \c FluxVolumeIntegral) instead.
+ * @code
+ dg::Grid1d grid1d( psipmin, psipmax, 3, 64);
+ dg::geo::FluxIntegralProfile<dg::HVec> fip( grid2d, mag,
+        dg::evaluate( dg::cooX1d, grid1d));
+ fip.set_right( xpoint_weights);
+ dg::HVec area, volume;
+ fip.surface( area); // same as dg::evaluate( fsi, grid1d)
+ fip.volume( volume); // same as dg::evaluate( fvi, grid1d)
+ @endcode
+ * @copydoc hide_container
+ * @ingroup misc_geo
+ */
+template<class container>
+struct FluxIntegralProfile
+{
+    ///@brief CSR matrix type that lives in the same memory space as \c container
+    using matrix_type = std::conditional_t< std::is_same<
+        get_execution_policy<container>, SerialTag>::value,
+        dg::IHMatrix, dg::IDMatrix>;
+    /**
+     * @brief Construct from a grid and a magnetic field
+     * f and g are default initialized to 1
+     * @param g2d grid
+     * @param mag contains psip, psipR and psipZ
+     * @param psi the list of \f$ \psi_j\f$ values (in ascending order) at which to evaluate the integrals
+     * @param width_factor can be used to tune the width of the numerical delta function (\c width = \c 0.5*h*GradPsi*width_factor)
+     */
+    template<class Geometry2d>
+    FluxIntegralProfile(const Geometry2d& g2d, const TokamakMagneticField& mag,
+            const thrust::host_vector<double>& psi, double width_factor = 1.):
+        m_f(dg::evaluate(dg::one, g2d)), m_g(m_f), m_temp(m_f),
+        m_size( psi.size())
+    {
+        for( unsigned j=1; j<psi.size(); j++)
+            if( psi[j] < psi[j-1])
+                throw dg::Error(dg::Message(_ping_)<<"FluxIntegralProfile: psi values are not sorted in ascending order!");
+        thrust::host_vector<double> psipR  = dg::pullback( mag.psipR(), g2d);
+        thrust::host_vector<double> psipZ  = dg::pullback( mag.psipZ(), g2d);
+        double psipRmax = dg::blas1::reduce( psipR, 0., dg::AbsMax<double>()  );
+        double psipZmax = dg::blas1::reduce( psipZ, 0., dg::AbsMax<double>()  );
+        double deltapsi = 0.5*(psipZmax*g2d.hy() +psipRmax*g2d.hx())/g2d.n();
+        m_eps = deltapsi*width_factor;
+
+        thrust::host_vector<double> psip = dg::pullback( mag.psip(), g2d);
+        thrust::host_vector<double> w2d = dg::create::volume( g2d);
+        unsigned size = psip.size();
+        //sort quadrature points by their psi value
+        std::vector<unsigned> sorted( size);
+        for( unsigned i=0; i<size; i++)
+            sorted[i] = i;
+        std::stable_sort( sorted.begin(), sorted.end(), [&psip]( unsigned i, unsigned k){
+                return psip[i] < psip[k];});
+        std::vector<double> sorted_psip( size);
+        for( unsigned i=0; i<size; i++)
+            sorted_psip[i] = psip[sorted[i]];
+
+        //delta function: the points within the cutoff of psi_j form row j
+        const double cutoff = m_eps*sqrt( -2.*log(std::numeric_limits<double>::epsilon()));
+        const dg::GaussianX delta( 0., m_eps, 1./(sqrt(2.*M_PI)*m_eps));
+        std::vector<std::vector<int>> rows( m_size);
+        unsigned nnz = 0;
+        for( unsigned j=0; j<m_size; j++)
+        {
+            auto first = std::lower_bound( sorted_psip.begin(), sorted_psip.end(), psi[j] - cutoff);
+            auto last  = std::upper_bound( sorted_psip.begin(), sorted_psip.end(), psi[j] + cutoff);
+            for( auto it = first; it != last; it++)
+                rows[j].push_back( sorted[it - sorted_psip.begin()]);
+            //keep the summation order of the original vector
+            std::sort( rows[j].begin(), rows[j].end());
+            nnz += rows[j].size();
+        }
+        dg::IHMatrix deltaH( m_size, size, nnz);
+        deltaH.row_offsets[0] = 0;
+        unsigned pos = 0;
+        for( unsigned j=0; j<m_size; j++)
+        {
+            for( unsigned k=0; k<rows[j].size(); k++)
+            {
+                int i = rows[j][k];
+                deltaH.column_indices[pos] = i;
+                deltaH.values[pos] = delta( psip[i] - psi[j])*w2d[i];
+                pos++;
+            }
+            deltaH.row_offsets[j+1] = pos;
+        }
+        dg::blas2::transfer( deltaH, m_delta);
+
+        //Heaviside function: point i belongs to interval k if psi_{k-1} < psip_i <= psi_k
+        for( unsigned j=0; j<m_size; j++)
+            rows[j].clear();
+        nnz = 0;
+        for( unsigned i=0; i<size; i++)
+        {
+            unsigned k = std::lower_bound( psi.begin(), psi.end(), psip[i]) - psi.begin();
+            if( k < m_size)
+            {
+                rows[k].push_back( i); //i is ascending
+                nnz++;
+            }
+        }
+        dg::IHMatrix heaviH( m_size, size, nnz);
+        heaviH.row_offsets[0] = 0;
+        pos = 0;
+        for( unsigned k=0; k<m_size; k++)
+        {
+            for( unsigned l=0; l<rows[k].size(); l++)
+            {
+                heaviH.column_indices[pos] = rows[k][l];
+                heaviH.values[pos] = w2d[rows[k][l]];
+                pos++;
+            }
+            heaviH.row_offsets[k+1] = pos;
+        }
+        dg::blas2::transfer( heaviH, m_heavi);
+    }
+    ///@copydoc FluxSurfaceIntegral::get_deltapsi()
+    double get_deltapsi() const{return m_eps;}
+    ///@brief The number of psi values given in the constructor
+    unsigned size() const{return m_size;}
+
+    /**
+     * @brief Set the left function to integrate
+     *
+     * @param f the container containing the discretized function
+     */
+    void set_left( const container& f){
+        dg::blas1::copy( f, m_f);
+    }
+    /**
+     * @brief Set the right function to integrate
+     *
+     * @param g the container containing the discretized function
+     */
+    void set_right( const container& g){
+        dg::blas1::copy( g, m_g);
+    }
+    /**
+     * @brief Calculate the Flux Surface Integral at all psi values
+     *
+     * @param profile (write only) contains Int_psi_j (f,g) on output (resized to \c size())
+     */
+    void surface( container& profile)
+    {
+        profile.resize( m_size);
+        dg::blas1::pointwiseDot( m_f, m_g, m_temp);
+        dg::blas2::symv( m_delta, m_temp, profile);
+    }
+    /**
+     * @brief Calculate the Flux Volume Integral at all psi values
+     *
+     * @param profile (write only) contains Int_0^psi_j (f,g) on output (resized to \c size())
+     */
+    void volume( container& profile)
+    {
+        profile.resize( m_size);
+        dg::blas1::pointwiseDot( m_f, m_g, m_temp);
+        dg::blas2::symv( m_heavi, m_temp, profile);
+        thrust::inclusive_scan( profile.begin(), profile.end(), profile.begin());
+    }
+    private:
+    double m_eps;
+    container m_f, m_g, m_temp;
+    matrix_type m_delta, m_heavi;
+    unsigned m_size;
+};
+
 
 /**
  * @brief Flux surface average (differential volume average) over quantity
@@ -138,6 +138,22 @@ int main( int argc, char* argv[])
         dg::blas1::scal(psi_vol, 2.*M_PI);
         map1d.emplace_back( "psi_vol", psi_vol,
             "Flux volume with delta function");
+        //all psi values at once
+        dg::geo::FluxIntegralProfile<dg::HVec> fip( (dg::CartesianGrid2d)grid2d, mag,
+                dg::evaluate( dg::cooX1d, grid1d));
+        fip.set_right( xpoint_weights);
+        dg::HVec psi_vol_profile, areaT_profile;
+        fip.volume( psi_vol_profile);
+        dg::blas1::scal(psi_vol_profile, 2.*M_PI);
+        fip.surface( areaT_profile);
+        dg::blas1::axpby( 1., psi_vol, -1., psi_vol_profile);
+        dg::blas1::axpby( 1., areaT_psip, -1., areaT_profile);
+        std::cout << "Profile vs single volume   difference: "
+                  <<sqrt( dg::blas1::dot( psi_vol_profile, psi_vol_profile)/
+                          dg::blas1::dot( psi_vol, psi_vol))<<"\n";
+        std::cout << "Profile vs single surface  difference: "
+                  <<sqrt( dg::blas1::dot( areaT_profile, areaT_profile)/
+                          dg::blas1::dot( areaT_psip, areaT_psip))<<"\n";
         double volumeFVI = 2.*M_PI*fvi(psipmax);
         double volumeSep = 2.*M_PI*fvi(0.);
         std::cout << "volume enclosed by separatrix: "<<volumeSep<<"\n";
@@ -195,6 +195,68 @@ struct ComputeDSSDIR{
     ComputeDSS m_dss;
 };
 
+//compute ds and dss from the same plus and minus values in one pass
+template<class DSFunctor, class DSSFunctor>
+struct ComputeDSAndDSS{
+    ComputeDSAndDSS( DSFunctor ds, DSSFunctor dss): m_ds(ds), m_dss(dss){}
+    DG_DEVICE
+    void operator()( double& dsf, double& dssf, double fm, double fo, double fp,
+            double hm, double hp)
+    {
+        m_ds( dsf, fm, fo, fp, hm, hp);
+        m_dss( dssf, fm, fo, fp, hm, hp);
+    }
+    DG_DEVICE
+    void operator()( double& dsf, double& dssf, double fm, double fo, double fp,
+            double hm, double hp, double hbm, double hbp,
+            double bpm, double bpo, double bpp)
+    {
+        m_ds( dsf, fm, fo, fp, hm, hp, hbm, hbp, bpm, bpo, bpp);
+        m_dss( dssf, fm, fo, fp, hm, hp, hbm, hbp, bpm, bpo, bpp);
+    }
+    private:
+    DSFunctor m_ds;
+    DSSFunctor m_dss;
+};
+//compute ds (write-only) and lap = alpha*( divv ds + dss) + beta*lap in one pass
+//ds and dss must be constructed with alpha=1, beta=0
+template<class DSFunctor, class DSSFunctor>
+struct ComputeDSAndLapPar{
+    ComputeDSAndLapPar( double alpha, double beta, DSFunctor ds, DSSFunctor dss):
+        m_alpha(alpha), m_beta(beta), m_ds(ds), m_dss(dss){}
+    DG_DEVICE
+    void operator()( double& dsf, double& lapf, double divv, double fm,
+            double fo, double fp, double hm, double hp)
+    {
+        double dssf = 0;
+        m_ds( dsf, fm, fo, fp, hm, hp);
+        m_dss( dssf, fm, fo, fp, hm, hp);
+        lapf = m_alpha*( divv*dsf + dssf) + m_beta*lapf;
+    }
+    DG_DEVICE
+    void operator()( double& dsf, double& lapf, double divv, double fm,
+            double fo, double fp, double hm, double hp, double hbm, double hbp,
+            double bpm, double bpo, double bpp)
+    {
+        double dssf = 0;
+        m_ds( dsf, fm, fo, fp, hm, hp, hbm, hbp, bpm, bpo, bpp);
+        m_dss( dssf, fm, fo, fp, hm, hp, hbm, hbp, bpm, bpo, bpp);
+        lapf = m_alpha*( divv*dsf + dssf) + m_beta*lapf;
+    }
+    private:
+    double m_alpha, m_beta;
+    DSFunctor m_ds;
+    DSSFunctor m_dss;
+};
+template<class DSFunctor, class DSSFunctor>
+ComputeDSAndDSS<DSFunctor, DSSFunctor> make_ds_and_dss( DSFunctor ds, DSSFunctor dss){
+    return ComputeDSAndDSS<DSFunctor,DSSFunctor>( ds, dss);
+}
+template<class DSFunctor, class DSSFunctor>
+ComputeDSAndLapPar<DSFunctor, DSSFunctor> make_ds_and_lap( double alpha, double beta, DSFunctor ds, DSSFunctor dss){
+    return ComputeDSAndLapPar<DSFunctor,DSSFunctor>( alpha, beta, ds, dss);
+}
+
 }//namespace detail
 ///@endcond
 
@@ -368,8 +430,7 @@ struct DS
     * @copydoc hide_ds_parameters4
     */
     void centered( double alpha, const container& f, double beta, container& g){
-        m_fa(einsPlus, f, m_tempP);
-        m_fa(einsMinus, f, m_tempM);
+        m_fa(einsPlus, f, m_tempP, einsMinus, f, m_tempM);
         ds_centered( m_fa, alpha, m_tempM, f, m_tempP, beta, g);
     }
     /**
@@ -531,11 +592,122 @@ struct DS
      * @copydoc hide_ds_parameters4
      */
     void dss( double alpha, const container& f, double beta, container& g){
-        m_fa(einsPlus, f, m_tempP);
-        m_fa(einsMinus, f, m_tempM);
+        m_fa(einsPlus, f, m_tempP, einsMinus, f, m_tempM);
         dss_centered( m_fa, alpha, m_tempM, f, m_tempP, beta, g);
     }
 
+    /**
+     * @brief Interpolate f to the plus and minus planes once and cache the result
+     *
+     * Both interpolations are done in one combined call to the underlying
+     * Fieldaligned object. The \c cached_* member functions then compute
+     * their derivatives from the cache without any further interpolation
+     * until \c set_field is called again. Use this if more than one
+     * derivative of the same field is needed:
+     * @code
+     ds.set_field( f);
+     ds.cached_lapPar( divb, 1., dsf, 0., lapf); // one kernel
+     ds.cached_ds( dg::forward, 1., 0., dsfF);   // no interpolation
+     * @endcode
+     * @param f the field (a copy is kept)
+     * @param adjoint if true also the two adjoint interpolations needed for
+     * \c cached_divCentered are computed and cached
+     */
+    void set_field( const container& f, bool adjoint = false){
+        m_f = f;
+        if( !m_field_allocated)
+        {
+            m_fP = m_fM = m_temp;
+            m_field_allocated = true;
+        }
+        m_fa(einsPlus, f, m_fP, einsMinus, f, m_fM);
+        m_adjoint_cached = adjoint;
+        if( adjoint)
+        {
+            if( !m_adjoint_allocated)
+            {
+                m_fPT = m_fMT = m_temp;
+                m_adjoint_allocated = true;
+            }
+            dg::blas1::pointwiseDot(  m_vol3d, f, m_temp0);
+            dg::blas1::axpby( 1., m_fa.hp(), 1., m_fa.hm(), m_tempP);
+            dg::blas1::pointwiseDivide( m_temp0, m_tempP, m_temp0);
+            m_fa(einsPlusT,  m_temp0, m_fPT, einsMinusT, m_temp0, m_fMT);
+        }
+    }
+    ///@brief The field cached in \c set_field
+    const container& field() const{ return m_f;}
+    ///@brief The cached \c einsMinus interpolation of \c field()
+    const container& field_minus() const{ return m_fM;}
+    ///@brief The cached \c einsPlus interpolation of \c field()
+    const container& field_plus() const{ return m_fP;}
+    /**
+     * @brief Derivative \f$ g = \alpha \vec v \cdot \nabla f + \beta g\f$ of the field cached in \c set_field
+     *
+     * @param dir the direction of the derivative
+     * @param alpha Scalar
+     * @param beta Scalar
+     * @param g contains result on output (write only)
+     * @note Same result as \c ds(dir, alpha, f, beta, g) but without interpolation
+     */
+    void cached_ds( dg::direction dir, double alpha, double beta, container& g) const{
+        switch( dir){
+            case dg::centered:
+            return ds_centered( m_fa, alpha, m_fM, m_f, m_fP, beta, g);
+            case dg::forward:
+            return ds_forward( m_fa, alpha, m_f, m_fP, beta, g);
+            case dg::backward:
+            return ds_backward( m_fa, alpha, m_fM, m_f, beta, g);
+        }
+    }
+    /**
+     * @brief Second derivative \f$ g = \alpha (\vec v\cdot \nabla)^2 f + \beta g\f$ of the field cached in \c set_field
+     *
+     * @param alpha Scalar
+     * @param beta Scalar
+     * @param g contains result on output (write only)
+     * @note Same result as \c dss(alpha, f, beta, g) but without interpolation
+     */
+    void cached_dss( double alpha, double beta, container& g) const{
+        dss_centered( m_fa, alpha, m_fM, m_f, m_fP, beta, g);
+    }
+    /**
+     * @brief Centered first and second derivative of the field cached in \c set_field in one kernel
+     *
+     * @param dsf contains \f$ \vec v\cdot\nabla f\f$ on output (write only)
+     * @param dssf contains \f$ (\vec v\cdot\nabla)^2 f\f$ on output (write only)
+     */
+    void cached_ds_dss( container& dsf, container& dssf) const{
+        ds_dss_centered( m_fa, m_fM, m_f, m_fP, dsf, dssf);
+    }
+    /**
+     * @brief Centered derivative and direct parallel Laplacian of the field cached in \c set_field in one kernel
+     *
+     * Computes \f$ h = \alpha\left( (\nabla\cdot\vec v)\vec v\cdot\nabla f + (\vec v\cdot\nabla)^2 f\right) + \beta h\f$
+     * @param divv the divergence of the vector field \f$ \nabla\cdot\vec v\f$
+     * @param alpha Scalar
+     * @param dsf contains \f$ \vec v\cdot\nabla f\f$ on output (write only)
+     * @param beta Scalar
+     * @param lapf contains the parallel Laplacian on output
+     */
+    void cached_lapPar( const container& divv, double alpha, container& dsf, double beta, container& lapf) const{
+        ds_lapPar_centered( m_fa, alpha, m_fM, m_f, m_fP, divv, dsf, beta, lapf);
+    }
+    /**
+     * @brief Centered divergence \f$ g = \alpha \nabla\cdot(\vec v f) + \beta g\f$ of the field cached in \c set_field
+     *
+     * @param alpha Scalar
+     * @param beta Scalar
+     * @param g contains result on output (write only)
+     * @note Same result as \c divCentered(alpha, f, beta, g) but without interpolation
+     * @attention \c set_field must have been called with \c adjoint=true
+     */
+    void cached_divCentered( double alpha, double beta, container& g) const{
+        if( !m_adjoint_cached)
+            throw dg::Error(dg::Message(_ping_)<<"Adjoint interpolations are not cached! Call set_field with adjoint=true.");
+        dg::blas1::pointwiseDot( alpha, m_fMT, m_inv3d, -alpha, m_fPT, m_inv3d, beta, g);
+    }
+
     const container& weights()const {
         return m_vol3d;
     }
@@ -562,6 +734,8 @@ struct DS
     container m_temp;
     container m_tempP, m_temp0, m_tempM;
     container m_vol3d, m_inv3d, m_weights_wo_vol;
+    container m_f, m_fP, m_fM, m_fPT, m_fMT; //cache of set_field
+    bool m_field_allocated = false, m_adjoint_allocated = false, m_adjoint_cached = false;
     dg::direction m_dir;
     Matrix m_jumpX, m_jumpY;
 };
@@ -629,8 +803,7 @@ void DS<G, I,M,container>::do_divCentered( double alpha, const container& f, dou
     dg::blas1::pointwiseDot(  m_vol3d, f, m_temp0);
     dg::blas1::axpby( 1., m_fa.hp(), 1., m_fa.hm(), m_tempP);
     dg::blas1::pointwiseDivide( m_temp0, m_tempP, m_temp0);
-    m_fa(einsPlusT,  m_temp0, m_tempP);
-    m_fa(einsMinusT, m_temp0, m_tempM);
+    m_fa(einsPlusT,  m_temp0, m_tempP, einsMinusT, m_temp0, m_tempM);
     dg::blas1::pointwiseDot( alpha, m_tempM, m_inv3d, -alpha, m_tempP, m_inv3d, beta, dsf);
 
 }
@@ -641,23 +814,19 @@ void DS<G,I,M,container>::do_symv( double alpha, const container& f, double beta
 
     if(m_dir == dg::centered) //does not converge with BC!!
     {
-        m_fa(einsPlus, f, m_tempP);
-        m_fa(einsMinus, f, m_tempM);
+        m_fa(einsPlus, f, m_tempP, einsMinus, f, m_tempM);
         dg::blas1::subroutine( detail::ComputeSymv(), m_tempP, m_tempM,
                 m_fa.hp(), m_fa.hm(), m_vol3d);
-        m_fa(einsPlusT,  m_tempP, m_temp);
-        m_fa(einsMinusT, m_tempP, m_tempM);
+        m_fa(einsPlusT,  m_tempP, m_temp, einsMinusT, m_tempP, m_tempM);
         dg::blas1::subroutine( detail::ComputeSymvEnd(), m_temp,
             m_tempM, m_weights_wo_vol);
     }
     else
     {
-        m_fa(einsPlus, f, m_tempP);
-        m_fa(einsMinus, f, m_tempM);
+        m_fa(einsPlus, f, m_tempP, einsMinus, f, m_tempM);
         dg::blas1::subroutine( detail::ComputeSymv(), m_tempP, m_tempM, f,
             m_fa.hp(), m_fa.hm(), m_vol3d);
-        m_fa(einsPlusT, m_tempP, m_temp0);
-        m_fa(einsMinusT, m_tempM, m_temp);
+        m_fa(einsPlusT, m_tempP, m_temp0, einsMinusT, m_tempM, m_temp);
         dg::blas1::subroutine( detail::ComputeSymvEnd(), m_temp,
             m_tempM, m_tempP, m_temp0, m_weights_wo_vol);
     }
@@ -815,6 +984,139 @@ void dss_centered_bc_along_field( const FieldAligned& fa, double alpha, const
     }
 }
 
+/**
+ * @brief Centered first and second derivative \f$ g = \vec v \cdot \nabla f\f$ and \f$ h = (\vec v\cdot \nabla)^2 f \f$ in one kernel
+ *
+ * Computes the same as \c ds_centered and \c dss_centered but reads the
+ * plus, minus and centre values and the grid distances only once.
+ * @param fa this object will be used to get grid distances
+ * @copydoc hide_ds_fm
+ * @param f The vector to derive
+ * @copydoc hide_ds_fp
+ * @param dsf contains the first derivative on output (write only)
+ * @param dssf contains the second derivative on output (write only)
+ * @ingroup fieldaligned
+ * @copydoc hide_ds_freestanding
+ */
+template<class FieldAligned, class container>
+void ds_dss_centered( const FieldAligned& fa, const container& fm,
+        const container& f, const container& fp, container& dsf, container& dssf)
+{
+    dg::blas1::subroutine( detail::make_ds_and_dss(
+            detail::ComputeDSCentered( 1., 0.), detail::ComputeDSS( 1., 0.)),
+            dsf, dssf, fm, f, fp, fa.hm(), fa.hp());
+}
+/**
+ * @brief Centered derivative \f$ g = \vec v \cdot \nabla f\f$ and parallel Laplacian \f$ h = \alpha\left( (\nabla\cdot\vec v) \vec v\cdot\nabla f + (\vec v\cdot \nabla)^2 f\right) + \beta h\f$ in one kernel
+ *
+ * The parallel Laplacian \f$ \nabla\cdot(\vec v \vec v\cdot\nabla f)\f$ is
+ * discretized directly from the centered first and second derivatives, i.e.
+ * the result is the same as calling \c ds_centered and \c dss_centered
+ * followed by a \c pointwiseDot with \c divv.
+ * @param fa this object will be used to get grid distances
+ * @param alpha Scalar
+ * @copydoc hide_ds_fm
+ * @param f The vector to derive
+ * @copydoc hide_ds_fp
+ * @param divv the divergence of the vector field \f$ \nabla\cdot\vec v\f$
+ * (may be a \c dg::PlaneBroadcast)
+ * @param dsf contains the first derivative on output (write only)
+ * @param beta Scalar
+ * @param lapf contains the parallel Laplacian on output
+ * @ingroup fieldaligned
+ * @copydoc hide_ds_freestanding
+ */
+template<class FieldAligned, class container, class container0>
+void ds_lapPar_centered( const FieldAligned& fa, double alpha,
+        const container& fm, const container& f, const container& fp,
+        const container0& divv, container& dsf, double beta, container& lapf)
+{
+    dg::blas1::subroutine( detail::make_ds_and_lap( alpha, beta,
+            detail::ComputeDSCentered( 1., 0.), detail::ComputeDSS( 1., 0.)),
+            dsf, lapf, divv, fm, f, fp, fa.hm(), fa.hp());
+}
+/**
+ * @brief Centered first and second derivative \f$ g = \vec v \cdot \nabla f\f$ and \f$ h = (\vec v\cdot \nabla)^2 f \f$ in one kernel
+ *
+ * Computes the same as \c ds_centered_bc_along_field and
+ * \c dss_centered_bc_along_field but reads the plus, minus and centre values
+ * and the grid distances only once.
+ * @param fa this object will be used to get grid distances
+ * @copydoc hide_ds_fm
+ * @param f The vector to derive
+ * @copydoc hide_ds_fp
+ * @param dsf contains the first derivative on output (write only)
+ * @param dssf contains the second derivative on output (write only)
+ * @param bound either dg::NEU or dg::DIR (rest not implemented yet)
+ * @param boundary_value first value is for incoming fieldlines, second one for outgoing
+ * @ingroup fieldaligned
+ */
+template<class FieldAligned, class container>
+void ds_dss_centered_bc_along_field( const FieldAligned& fa,
+        const container& fm, const container& f, const container& fp,
+        container& dsf, container& dssf, dg::bc bound,
+        std::array<double,2> boundary_value = {0,0})
+{
+    if( bound == dg::NEU)
+    {
+        dg::blas1::subroutine( detail::make_ds_and_dss(
+                detail::ComputeDSCenteredNEU( 1., 0., boundary_value),
+                detail::ComputeDSSNEU( 1., 0., boundary_value)),
+                dsf, dssf, fm, f, fp, fa.hm(), fa.hp(), fa.hbm(),
+                fa.hbp(), fa.bbm(), fa.bbo(), fa.bbp());
+    }
+    else// if( bound == dg::DIR)
+    {
+        dg::blas1::subroutine( detail::make_ds_and_dss(
+                detail::ComputeDSCenteredDIR( 1., 0., boundary_value),
+                detail::ComputeDSSDIR( 1., 0., boundary_value)),
+                dsf, dssf, fm, f, fp, fa.hm(), fa.hp(), fa.hbm(),
+                fa.hbp(), fa.bbm(), fa.bbo(), fa.bbp());
+    }
+}
+/**
+ * @brief Centered derivative \f$ g = \vec v \cdot \nabla f\f$ and parallel Laplacian \f$ h = \alpha\left( (\nabla\cdot\vec v) \vec v\cdot\nabla f + (\vec v\cdot \nabla)^2 f\right) + \beta h\f$ in one kernel
+ *
+ * The same as \c ds_lapPar_centered with the boundary condition implemented
+ * along the field-line as in \c ds_centered_bc_along_field and \c dss_centered_bc_along_field
+ * @param fa this object will be used to get grid distances
+ * @param alpha Scalar
+ * @copydoc hide_ds_fm
+ * @param f The vector to derive
+ * @copydoc hide_ds_fp
+ * @param divv the divergence of the vector field \f$ \nabla\cdot\vec v\f$
+ * (may be a \c dg::PlaneBroadcast)
+ * @param dsf contains the first derivative on output (write only)
+ * @param beta Scalar
+ * @param lapf contains the parallel Laplacian on output
+ * @param bound either dg::NEU or dg::DIR (rest not implemented yet)
+ * @param boundary_value first value is for incoming fieldlines, second one for outgoing
+ * @ingroup fieldaligned
+ */
+template<class FieldAligned, class container, class container0>
+void ds_lapPar_centered_bc_along_field( const FieldAligned& fa, double alpha,
+        const container& fm, const container& f, const container& fp,
+        const container0& divv, container& dsf, double beta, container& lapf,
+        dg::bc bound, std::array<double,2> boundary_value = {0,0})
+{
+    if( bound == dg::NEU)
+    {
+        dg::blas1::subroutine( detail::make_ds_and_lap( alpha, beta,
+                detail::ComputeDSCenteredNEU( 1., 0., boundary_value),
+                detail::ComputeDSSNEU( 1., 0., boundary_value)),
+                dsf, lapf, divv, fm, f, fp, fa.hm(), fa.hp(), fa.hbm(),
+                fa.hbp(), fa.bbm(), fa.bbo(), fa.bbp());
+    }
+    else// if( bound == dg::DIR)
+    {
+        dg::blas1::subroutine( detail::make_ds_and_lap( alpha, beta,
+                detail::ComputeDSCenteredDIR( 1., 0., boundary_value),
+                detail::ComputeDSSDIR( 1., 0., boundary_value)),
+                dsf, lapf, divv, fm, f, fp, fa.hm(), fa.hp(), fa.hbm(),
+                fa.hbp(), fa.bbm(), fa.bbo(), fa.bbp());
+    }
+}
+
 }//namespace geo
 
 ///@cond
@@ -57,7 +57,9 @@ int main(int argc, char * argv[])
          {"forwardLap",{&fun,&sol3}},       {"backwardLap",{&fun,&sol3}},
          {"centeredLap",{&fun,&sol3}},      {"directLap",{&fun,&sol3}},
          {"invForwardLap",{&sol4,&fun}},    {"invBackwardLap",{&sol4,&fun}},
-         {"invCenteredLap",{&sol4,&fun}}
+         {"invCenteredLap",{&sol4,&fun}},   {"cachedCentered",{&fun,&sol0}},
+         {"cachedDss",{&fun,&sol1}},        {"cachedDivCentered",{&fun,&sol2}},
+         {"cachedLap",{&fun,&sol3}}
     };
     std::cout << "# TEST NEU Boundary conditions!\n";
     std::cout << "# TEST ADJOINT derivatives do unfortunately not fulfill Neumann BC!\n";
@@ -55,7 +55,8 @@ int main()
     std::cout << "L2 Norm of relative error is:               " <<sqrt( normerr/norm)<<std::endl;
     dg::SparseTensor<dg::DVec> hh = dg::geo::createProjectionTensor( bhat, g3d);
     dg::Elliptic3d<dg::CylindricalGrid3d, dg::DMatrix, dg::DVec> ellipticP(g3d, dg::not_normed, dg::centered);
-    ellipticP.set_chi( hh);
+    //the projection tensor does not depend on phi: store only one plane
+    ellipticP.set_chi( dg::broadcast_plane( hh, g3d));
     dg::DVec one = dg::evaluate( dg::one, g3d);
     dg::blas1::copy( 3., one);
     ellipticP.set_chi( one);
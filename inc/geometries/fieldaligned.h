@@ -4,6 +4,7 @@
 #include <cusp/csr_matrix.h>
 
 #include "dg/backend/transpose.h"
+#include "dg/backend/broadcast.h"
 #include "dg/blas.h"
 #include "dg/topology/grid.h"
 #include "dg/topology/interpolation.h"
@@ -378,40 +379,65 @@ struct Fieldaligned
     * @param out output may not equal input
     */
     void operator()(enum whichMatrix which, const container& in, container& out);
+    /**
+    * @brief Apply two interpolations to three-dimensional vectors at once
+    *
+    * Equivalent to
+    * @code
+    * (*this)( which0, in0, out0);
+    * (*this)( which1, in1, out1);
+    * @endcode
+    * In the MPI version, if one of the two is a plus (\c einsPlus or \c einsMinusT)
+    * and the other a minus (\c einsMinus or \c einsPlusT) interpolation, the
+    * exchange of the boundary planes of both is posted non-blocking
+    * and overlaps with the interpolation of the interior planes
+    * @param which0 specify what interpolation should be applied to \c in0
+    * @param in0 first input
+    * @param out0 first output may not equal any input
+    * @param which1 specify what interpolation should be applied to \c in1
+    * @param in1 second input
+    * @param out1 second output may not equal any input or \c out0
+    */
+    void operator()(enum whichMatrix which0, const container& in0, container& out0,
+                    enum whichMatrix which1, const container& in1, container& out1)
+    {
+        (*this)( which0, in0, out0);
+        (*this)( which1, in1, out1);
+    }
 
     ///@brief Distance between the planes \f$ (s_{k}-s_{k-1}) \f$
-    ///@return three-dimensional vector
-    const container& hm()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& hm()const {
         return m_hm;
     }
     ///@brief Distance between the planes \f$ (s_{k+1}-s_{k}) \f$
-    ///@return three-dimensional vector
-    const container& hp()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& hp()const {
         return m_hp;
     }
     ///@brief Distance between the planes and the boundary \f$ (s_{k}-s_{b}^-) \f$
-    ///@return three-dimensional vector
-    const container& hbm()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& hbm()const {
         return m_hbm;
     }
     ///@brief Distance between the planes \f$ (s_b^+-s_{k}) \f$
-    ///@return three-dimensional vector
-    const container& hbp()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& hbp()const {
         return m_hbp;
     }
     ///@brief Mask minus, 1 if fieldline intersects wall in minus direction but not in plus direction, 0 else
-    ///@return three-dimensional vector
-    const container& bbm()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& bbm()const {
         return m_bbm;
     }
     ///@brief Mask both, 1 if fieldline intersects wall in plus direction and in minus direction, 0 else
-    ///@return three-dimensional vector
-    const container& bbo()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& bbo()const {
         return m_bbo;
     }
     ///@brief Mask plus, 1 if fieldline intersects wall in plus direction but not in minus direction, 0 else
-    ///@return three-dimensional vector
-    const container& bbp()const {
+    ///@return two-dimensional vector broadcast to all planes
+    const dg::PlaneBroadcast<container>& bbp()const {
         return m_bbp;
     }
     ///Grid used for construction
@@ -443,8 +469,8 @@ struct Fieldaligned
     void ePlus( enum whichMatrix which, const container& in, container& out);
     void eMinus(enum whichMatrix which, const container& in, container& out);
     IMatrix m_plus, m_minus, m_plusT, m_minusT; //2d interpolation matrices
-    container m_hm, m_hp, m_hbm, m_hbp;         //3d size
-    container m_bbm, m_bbp, m_bbo;  //3d size masks
+    dg::PlaneBroadcast<container> m_hm, m_hp, m_hbm, m_hbp; //2d size, broadcast to 3d
+    dg::PlaneBroadcast<container> m_bbm, m_bbp, m_bbo;  //2d size masks, broadcast to 3d
     container m_hm2d, m_hp2d;       //2d size
     container m_left, m_right;      //perp_size
     container m_limiter;            //perp_size
@@ -454,14 +480,11 @@ struct Fieldaligned
     std::vector<dg::View<const container>> m_f;
     std::vector<dg::View< container>> m_temp;
     dg::ClonePtr<ProductGeometry> m_g;
-    template<class Geometry>
-    void assign3dfrom2d( const thrust::host_vector<double>& in2d, container& out, const Geometry& grid)
+    void assign3dfrom2d( const thrust::host_vector<double>& in2d, dg::PlaneBroadcast<container>& out)
     {
-        dg::split( out, m_temp, grid); //3d vector
         container tmp2d;
         dg::assign( in2d, tmp2d);
-        for( unsigned i=0; i<m_Nz; i++)
-            dg::blas1::copy( tmp2d, m_temp[i]);
+        out.construct( tmp2d, m_Nz);
     }
 };
 
@@ -548,19 +571,20 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
     dg::blas2::transfer( minus, m_minus);
     dg::blas2::transfer( minusT, m_minusT);
     ///%%%%%%%%%%%%%%%%%%%%copy into h vectors %%%%%%%%%%%%%%%%%%%//
-    dg::assign( dg::evaluate( dg::zero, grid), m_hm);
-    m_temp  = dg::split( m_hm, grid); //3d vector
-    m_f     = dg::split( (const container&)m_hm, grid);
-    m_hbp = m_hbm = m_hp = m_hm;
+    //the views are re-pointed before every use
+    container temp3d;
+    dg::assign( dg::evaluate( dg::zero, grid), temp3d);
+    m_temp  = dg::split( temp3d, grid); //3d vector
+    m_f     = dg::split( (const container&)temp3d, grid);
     dg::assign( yp_coarse[2], m_hp2d); //2d vector
     dg::assign( ym_coarse[2], m_hm2d); //2d vector
-    assign3dfrom2d( hbp, m_hbp, grid);
-    assign3dfrom2d( hbm, m_hbm, grid);
-    assign3dfrom2d( yp_coarse[2], m_hp, grid);
-    assign3dfrom2d( ym_coarse[2], m_hm, grid);
+    //the distances are the same in every plane
+    assign3dfrom2d( hbp, m_hbp);
+    assign3dfrom2d( hbm, m_hbm);
     dg::blas1::scal( m_hm2d, -1.);
-    dg::blas1::scal( m_hbm, -1.);
-    dg::blas1::scal( m_hm, -1.);
+    dg::blas1::scal( m_hbm.plane(), -1.);
+    m_hp.construct( m_hp2d, m_Nz);
+    m_hm.construct( m_hm2d, m_Nz);
 
     ///%%%%%%%%%%%%%%%%%%%%create mask vectors %%%%%%%%%%%%%%%%%%%//
     thrust::host_vector<double> bbm( in_boxp.size(),0.), bbo(bbm), bbp(bbm);
@@ -574,10 +598,9 @@ Fieldaligned<Geometry, IMatrix, container>::Fieldaligned(
             bbm[i] = 1.;
         // else all are 0
     }
-    m_bbm = m_bbo = m_bbp = m_hm;
-    assign3dfrom2d( bbm, m_bbm, grid);
-    assign3dfrom2d( bbo, m_bbo, grid);
-    assign3dfrom2d( bbp, m_bbp, grid);
+    assign3dfrom2d( bbm, m_bbm);
+    assign3dfrom2d( bbo, m_bbo);
+    assign3dfrom2d( bbp, m_bbp);
 }
 
 template<class G, class I, class container>
@@ -206,20 +206,22 @@ struct FluxGenerator : public aGenerator2d
         fx_.resize( zeta1d.size());
         thrust::host_vector<double> f_p(fx_);
         unsigned Nx = zeta1d.size(), Ny = eta1d.size();
-        for( unsigned i=0; i<zeta1d.size(); i++)
+        //all surfaces are independent
+        dg::geo::detail::for_each_surface( Nx, [&]( unsigned i, unsigned steps)
         {
             thrust::host_vector<double> ry, zy;
             thrust::host_vector<double> yr, yz, xr, xz;
             double R0, Z0;
-            if(mode_==0)dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZY, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose);
-            if(mode_==1)dg::geo::detail::compute_rzy( fpsiRibeiro, fieldRZYRYZYequalarc, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose);
+            if(mode_==0)steps = dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZY, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose, steps);
+            if(mode_==1)steps = dg::geo::detail::compute_rzy( fpsiRibeiro, fieldRZYRYZYequalarc, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose, steps);
             for( unsigned j=0; j<Ny; j++)
             {
                 x[j*Nx+i]  = ry[j], y[j*Nx+i]  = zy[j];
                 etaX[j*Nx+i] = yr[j], etaY[j*Nx+i] = yz[j];
                 zetaX[j*Nx+i] = xr[j]/fx_[i]*f0_, zetaY[j*Nx+i] = xz[j]/fx_[i]*f0_;
             }
-        }
+            return steps;
+        });
     }
     CylindricalFunctorsLvl2 psi_;
     CylindricalFunctorsLvl1 ipol_;
@@ -286,20 +288,22 @@ struct RibeiroFluxGenerator : public aGenerator2d
         fx_.resize( zeta1d.size());
         thrust::host_vector<double> f_p(fx_);
         unsigned Nx = zeta1d.size(), Ny = eta1d.size();
-        for( unsigned i=0; i<zeta1d.size(); i++)
+        //all surfaces are independent
+        dg::geo::detail::for_each_surface( Nx, [&]( unsigned i, unsigned steps)
         {
             thrust::host_vector<double> ry, zy;
             thrust::host_vector<double> yr, yz, xr, xz;
             double R0, Z0;
-            if(mode_==0)dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZYribeiro, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose);
-            if(mode_==1)dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZYequalarc, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose);
+            if(mode_==0)steps = dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZYribeiro, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose, steps);
+            if(mode_==1)steps = dg::geo::detail::compute_rzy( fpsi, fieldRZYRYZYequalarc, psi_x[i], eta1d, ry, zy, yr, yz, xr, xz, R0, Z0, fx_[i], f_p[i], m_verbose, steps);
             for( unsigned j=0; j<Ny; j++)
             {
                 x[j*Nx+i]  = ry[j], y[j*Nx+i]  = zy[j];
                 etaX[j*Nx+i] = yr[j], etaY[j*Nx+i] = yz[j];
                 zetaX[j*Nx+i] = xr[j]/fx_[i]*f0_, zetaY[j*Nx+i] = xz[j]/fx_[i]*f0_;
             }
-        }
+            return steps;
+        });
     }
     CylindricalFunctorsLvl2 psip_;
     double f0_, lx_, x0_, y0_, psi0_, psi1_;
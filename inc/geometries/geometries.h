@@ -11,6 +11,7 @@
 #include "hector.h"
 #include "polar.h"
 #include "ribeiroX.h"
+#include "grid_cache.h"
 //include grids
 #include "curvilinear.h"
 #include "curvilinearX.h"
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "dg/backend/exceptions.h"
+#include "dg/backend/memory.h"
+#include "dg/topology/evaluation.h"
+#include "dg/topology/grid.h"
+#include "generator.h"
+
+namespace dg
+{
+namespace geo
+{
+
+///@cond
+namespace detail
+{
+// A cache file is the magic number followed by any number of records
+// Each record is:
+// uint64 key length, key, uint64 Nzeta, uint64 Neta,
+// Nzeta zeta values, Neta eta values,
+// 6 arrays of Nzeta*Neta values: x, y, zetaX, zetaY, etaX, etaY
+// all in native byte order and double precision, zeta runs fastest
+static const char grid_cache_magic[8] = {'D','G','G','R','I','D','C','1'};
+
+struct GridCacheRecord
+{
+    std::string key;
+    std::vector<double> zeta, eta;
+    std::streamoff data; // position of the first coordinate array
+};
+
+// read the header of the next record and skip its data
+// returns false at the end of the file and throws on a truncated record
+inline bool read_grid_cache_record( std::ifstream& is, std::streamoff size,
+    GridCacheRecord& rec)
+{
+    if( is.peek() == std::ifstream::traits_type::eof())
+        return false;
+    uint64_t length = 0, Nzeta = 0, Neta = 0;
+    is.read( reinterpret_cast<char*>(&length), sizeof(length));
+    if( !is || length > (uint64_t)size)
+        throw dg::Error(dg::Message(_ping_)<<"Grid cache file is truncated or corrupted!");
+    rec.key.resize( length);
+    is.read( &rec.key[0], length);
+    is.read( reinterpret_cast<char*>(&Nzeta), sizeof(Nzeta));
+    is.read( reinterpret_cast<char*>(&Neta), sizeof(Neta));
+    if( !is || (Nzeta+Neta)*sizeof(double) > (uint64_t)size)
+        throw dg::Error(dg::Message(_ping_)<<"Grid cache file is truncated or corrupted!");
+    rec.zeta.resize( Nzeta), rec.eta.resize( Neta);
+    is.read( reinterpret_cast<char*>(rec.zeta.data()), Nzeta*sizeof(double));
+    is.read( reinterpret_cast<char*>(rec.eta.data()), Neta*sizeof(double));
+    if( !is)
+        throw dg::Error(dg::Message(_ping_)<<"Grid cache file is truncated or corrupted!");
+    rec.data = is.tellg();
+    const std::streamoff end = rec.data + (std::streamoff)(6*Nzeta*Neta*sizeof(double));
+    if( end > size)
+        throw dg::Error(dg::Message(_ping_)<<"Grid cache file is truncated or corrupted!");
+    is.seekg( end);
+    return true;
+}
+
+// append the headers of all records with the given key that start at or
+// after position indexed (0 for a new index) and advance indexed to the end
+inline void read_grid_cache_index( const std::string& filename,
+    const std::string& key, std::vector<GridCacheRecord>& index,
+    std::streamoff& indexed)
+{
+    std::ifstream is( filename, std::ios::binary);
+    if( !is)
+        return;
+    is.seekg( 0, std::ios::end);
+    const std::streamoff size = is.tellg();
+    if( size <= indexed)
+        return;
+    is.seekg( indexed);
+    if( indexed == 0)
+    {
+        char magic[8];
+        if( !is.read( magic, 8) ||
+            !std::equal( magic, magic+8, grid_cache_magic))
+            throw dg::Error(dg::Message(_ping_)<<filename<<" is not a grid cache file!");
+        indexed = 8;
+    }
+    GridCacheRecord rec;
+    while( read_grid_cache_record( is, size, rec))
+    {
+        indexed = rec.data + (std::streamoff)(6*rec.zeta.size()*rec.eta.size()*sizeof(double));
+        if( rec.key == key)
+            index.push_back( rec);
+    }
+}
+
+// find the contiguous index range in stored that holds the values in requested
+inline bool find_grid_cache_range( const std::vector<double>& stored,
+    const thrust::host_vector<double>& requested, unsigned& first)
+{
+    if( requested.size() == 0)
+        return false;
+    double eps = 1e-12*(fabs(stored.back()-stored.front()) + 1.);
+    for( first=0; first<stored.size(); first++)
+        if( fabs( stored[first] - requested[0]) < eps)
+            break;
+    if( first + requested.size() > stored.size())
+        return false;
+    for( unsigned i=1; i<requested.size(); i++)
+        if( fabs( stored[first+i] - requested[i]) > eps)
+            return false;
+    return true;
+}
+}//namespace detail
+///@endcond
+
+/**
+ * @brief A generator that reads coordinates and Jacobian from an on-disk cache
+ *
+ * The cache file holds any number of records, each identified by a key string
+ * and the \f$\zeta\f$ and \f$\eta\f$ abscissas it was generated on, i.e. by the
+ * generator parameters and the resolution.
+ * When the grid is generated, the record with the given key whose abscissas
+ * contain the requested ones is looked up and only the requested slab is read
+ * from disk. This is what MPI ranks need to read only their local part.
+ * If no such record exists the wrapped generator is called.
+ * Records are appended with the \c write member.
+ * The file is indexed once in the constructor, so a lookup does not rescan the
+ * file and only the slab itself is read in \c generate. Only if a lookup
+ * fails are records appended since then (e.g. by \c write on another rank) added to the index.
+ *
+ * The metric is not stored since the grids compute it from the Jacobian and
+ * the map (with \c detail::square) at negligible cost.
+ * @code
+dg::geo::CachedGenerator generator( dg::geo::FluxGenerator( mag.get_psip(),
+    mag.get_ipol(), psi_0, psi_1, mag.R0(), 0., 1), "flux.grid",
+    js["magnetic_field"].toStyledString() + "flux psi_0 psi_1 1");
+if( !generator.is_cached( n, Nx, Ny))
+    generator.write( n, Nx, Ny);
+dg::geo::CurvilinearGrid2d g2d( generator, n, Nx, Ny);
+ * @endcode
+ * @note The key is not interpreted; it is the user's responsibility to make
+ * it unique for the generator type and its parameters (e.g. the magnetic field
+ * parameters as a string)
+ * @note The file is written in native byte order and is not portable between
+ * machines of different endianness
+ * @ingroup generators_geo
+ */
+struct CachedGenerator : public aGenerator2d
+{
+    /**
+     * @brief Wrap a generator and a cache file
+     *
+     * @param generator used for writing the cache and whenever a grid is not found
+     * @param filename the cache file (need not exist)
+     * @param key identifies the generator and its parameters
+     * @note throws a \c dg::Error if the file exists but is not a grid cache
+     * file or a record is truncated
+     */
+    CachedGenerator( const aGenerator2d& generator, std::string filename,
+        std::string key) : m_generator( generator), m_filename(filename),
+        m_key(key)
+    {
+        detail::read_grid_cache_index( m_filename, m_key, m_index, m_indexed);
+    }
+    virtual CachedGenerator* clone() const override final{
+        return new CachedGenerator(*this);
+    }
+
+    ///read access to the cache file name
+    const std::string& filename() const{ return m_filename;}
+    ///read access to the key
+    const std::string& key() const{ return m_key;}
+
+    /**
+     * @brief Check if the cache holds the grid for the given resolution
+     *
+     * @param n number of polynomial coefficients
+     * @param Nx number of cells in \f$ \zeta\f$
+     * @param Ny number of cells in \f$ \eta\f$
+     * @return true if a record with our key and the grid abscissas exists
+     */
+    bool is_cached( unsigned n, unsigned Nx, unsigned Ny) const
+    {
+        thrust::host_vector<double> zeta1d, eta1d;
+        abscissas( n, Nx, Ny, zeta1d, eta1d);
+        detail::GridCacheRecord rec;
+        unsigned i0, j0;
+        return find( zeta1d, eta1d, rec, i0, j0);
+    }
+
+    /**
+     * @brief Generate the global grid with the wrapped generator and
+     * append it to the cache file
+     *
+     * @param n number of polynomial coefficients
+     * @param Nx number of cells in \f$ \zeta\f$
+     * @param Ny number of cells in \f$ \eta\f$
+     * @note in an MPI program only one rank should call this function
+     */
+    void write( unsigned n, unsigned Nx, unsigned Ny) const
+    {
+        thrust::host_vector<double> zeta1d, eta1d;
+        abscissas( n, Nx, Ny, zeta1d, eta1d);
+        std::vector<thrust::host_vector<double>> values(6);
+        m_generator->generate( zeta1d, eta1d, values[0], values[1], values[2],
+            values[3], values[4], values[5]);
+
+        bool exists = std::ifstream( m_filename).good();
+        std::ofstream os( m_filename, std::ios::binary | std::ios::app);
+        if( !os)
+            throw dg::Error(dg::Message(_ping_)<<"Cannot write grid cache file "<<m_filename);
+        if( !exists)
+            os.write( detail::grid_cache_magic, 8);
+        uint64_t length = m_key.size(), Nzeta = zeta1d.size(), Neta = eta1d.size();
+        os.write( reinterpret_cast<const char*>(&length), sizeof(length));
+        os.write( m_key.data(), length);
+        os.write( reinterpret_cast<const char*>(&Nzeta), sizeof(Nzeta));
+        os.write( reinterpret_cast<const char*>(&Neta), sizeof(Neta));
+        os.write( reinterpret_cast<const char*>(thrust::raw_pointer_cast(zeta1d.data())), Nzeta*sizeof(double));
+        os.write( reinterpret_cast<const char*>(thrust::raw_pointer_cast(eta1d.data())), Neta*sizeof(double));
+        for( unsigned k=0; k<6; k++)
+            os.write( reinterpret_cast<const char*>(thrust::raw_pointer_cast(values[k].data())),
+                Nzeta*Neta*sizeof(double));
+        if( !os)
+            throw dg::Error(dg::Message(_ping_)<<"Writing grid cache file "<<m_filename<<" failed!");
+    }
+
+    private:
+    void abscissas( unsigned n, unsigned Nx, unsigned Ny,
+        thrust::host_vector<double>& zeta1d, thrust::host_vector<double>& eta1d) const
+    {
+        dg::Grid1d gX1d( 0., width(), n, Nx);
+        dg::Grid1d gY1d( 0., height(), n, Ny);
+        zeta1d = dg::evaluate( dg::cooX1d, gX1d);
+        eta1d = dg::evaluate( dg::cooX1d, gY1d);
+    }
+    bool find( const thrust::host_vector<double>& zeta1d,
+        const thrust::host_vector<double>& eta1d, detail::GridCacheRecord& rec,
+        unsigned& i0, unsigned& j0) const
+    {
+        if( find_in_index( 0, zeta1d, eta1d, rec, i0, j0))
+            return true;
+        // index records that were appended since the last lookup
+        unsigned old = m_index.size();
+        detail::read_grid_cache_index( m_filename, m_key, m_index, m_indexed);
+        return find_in_index( old, zeta1d, eta1d, rec, i0, j0);
+    }
+    bool find_in_index( unsigned first, const thrust::host_vector<double>& zeta1d,
+        const thrust::host_vector<double>& eta1d, detail::GridCacheRecord& rec,
+        unsigned& i0, unsigned& j0) const
+    {
+        for( unsigned k=first; k<m_index.size(); k++)
+            if( detail::find_grid_cache_range( m_index[k].zeta, zeta1d, i0) &&
+                detail::find_grid_cache_range( m_index[k].eta, eta1d, j0))
+            {
+                rec = m_index[k];
+                return true;
+            }
+        return false;
+    }
+    virtual void do_generate(
+         const thrust::host_vector<double>& zeta1d,
+         const thrust::host_vector<double>& eta1d,
+         thrust::host_vector<double>& x,
+         thrust::host_vector<double>& y,
+         thrust::host_vector<double>& zetaX,
+         thrust::host_vector<double>& zetaY,
+         thrust::host_vector<double>& etaX,
+         thrust::host_vector<double>& etaY) const override final
+    {
+        detail::GridCacheRecord rec;
+        unsigned i0, j0;
+        if( !find( zeta1d, eta1d, rec, i0, j0))
+        {
+            m_generator->generate( zeta1d, eta1d, x, y, zetaX, zetaY, etaX, etaY);
+            return;
+        }
+        // read only the requested slab
+        std::ifstream is( m_filename, std::ios::binary);
+        const uint64_t Nzeta = rec.zeta.size(), Neta = rec.eta.size();
+        const unsigned Mzeta = zeta1d.size(), Meta = eta1d.size();
+        thrust::host_vector<double>* values[6] = {&x, &y, &zetaX, &zetaY, &etaX, &etaY};
+        for( unsigned k=0; k<6; k++)
+            for( unsigned j=0; j<Meta; j++)
+            {
+                std::streamoff pos = rec.data + ((k*Neta + j0+j)*Nzeta + i0)*sizeof(double);
+                is.seekg( pos);
+                is.read( reinterpret_cast<char*>(thrust::raw_pointer_cast(values[k]->data()) + j*Mzeta),
+                    Mzeta*sizeof(double));
+            }
+        if( !is)
+            throw dg::Error(dg::Message(_ping_)<<"Reading grid cache file "<<m_filename<<" failed!");
+    }
+    virtual double do_width() const override final{return m_generator->width();}
+    virtual double do_height() const override final{return m_generator->height();}
+    virtual bool do_isOrthogonal() const override final{return m_generator->isOrthogonal();}
+    dg::ClonePtr<aGenerator2d> m_generator;
+    std::string m_filename, m_key;
+    mutable std::vector<detail::GridCacheRecord> m_index;
+    mutable std::streamoff m_indexed = 0; // end of the indexed part of the file
+};
+
+}//namespace geo
+}//namespace dg
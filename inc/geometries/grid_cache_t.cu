@@ -0,0 +1,68 @@
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "dg/algorithm.h"
+
+#include "curvilinear.h"
+#include "polar.h"
+#include "grid_cache.h"
+
+int main( )
+{
+    unsigned n = 3, Nx = 8, Ny = 20;
+    std::cout << "Test the grid cache with a polar grid "<<n<<" x "<<Nx<<" x "<<Ny<<"\n";
+    const std::string filename = "grid_cache_t.grid";
+    std::remove( filename.c_str());
+    dg::geo::PolarGenerator polar( 1., 2.);
+    dg::geo::CachedGenerator cached( polar, filename, "polar 1 2");
+    std::cout << "Cached before write (0) "<<cached.is_cached( n, Nx, Ny)<<"\n";
+    cached.write( n, Nx, Ny);
+    // a second record with a different key must not be found
+    dg::geo::CachedGenerator other( dg::geo::PolarGenerator( 1., 3.), filename, "polar 1 3");
+    other.write( n, Nx, Ny);
+    std::cout << "Cached after  write (1) "<<cached.is_cached( n, Nx, Ny)<<"\n";
+    std::cout << "Other resolution    (0) "<<cached.is_cached( n, Nx, 2*Ny)<<"\n";
+
+    dg::geo::CurvilinearGrid2d g2d( polar, n, Nx, Ny);
+    dg::geo::CurvilinearGrid2d c2d( cached, n, Nx, Ny);
+    dg::HVec error( g2d.map()[0]);
+    dg::blas1::axpby( 1., c2d.map()[0], -1., g2d.map()[0], error);
+    std::cout << "Difference in x      (0) "<<sqrt( dg::blas1::dot( error, error))<<"\n";
+    dg::blas1::axpby( 1., c2d.metric().value(0,0), -1., g2d.metric().value(0,0), error);
+    std::cout << "Difference in g^xx   (0) "<<sqrt( dg::blas1::dot( error, error))<<"\n";
+
+    // read a slab as an MPI rank would
+    dg::Grid1d gX1d( cached.width()/2., cached.width(), n, Nx/2);
+    dg::Grid1d gY1d( 0., cached.height(), n, Ny);
+    dg::HVec zeta1d = dg::evaluate( dg::cooX1d, gX1d);
+    dg::HVec eta1d = dg::evaluate( dg::cooX1d, gY1d);
+    dg::HVec x, y, zetaX, zetaY, etaX, etaY;
+    dg::HVec xx, yy, zzetaX, zzetaY, eetaX, eetaY;
+    polar.generate( zeta1d, eta1d, x, y, zetaX, zetaY, etaX, etaY);
+    cached.generate( zeta1d, eta1d, xx, yy, zzetaX, zzetaY, eetaX, eetaY);
+    dg::blas1::axpby( 1., etaY, -1., eetaY);
+    std::cout << "Difference in slab   (0) "<<sqrt( dg::blas1::dot( eetaY, eetaY))<<"\n";
+
+    // a truncated record must throw
+    const std::string truncated = "grid_cache_t_truncated.grid";
+    {
+        std::ifstream is( filename, std::ios::binary);
+        std::string content( (std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        std::ofstream os( truncated, std::ios::binary);
+        os.write( content.data(), content.size() - 8);
+    }
+    bool thrown = false;
+    try{
+        dg::geo::CachedGenerator broken( polar, truncated, "polar 1 2");
+    }
+    catch( dg::Error& e){ thrown = true;}
+    std::cout << "Truncated file throws (1) "<<thrown<<"\n";
+    std::remove( truncated.c_str());
+    std::remove( filename.c_str());
+
+    return 0;
+}
@@ -32,9 +32,7 @@ struct RealCurvilinearMPIGrid2d : public dg::aRealMPIGeometry2d<real_type>
     RealCurvilinearMPIGrid2d( const aRealGenerator2d<real_type>& generator, unsigned n, unsigned Nx, unsigned Ny, dg::bc bcx, dg::bc bcy, MPI_Comm comm):
         dg::aRealMPIGeometry2d<real_type>( 0, generator.width(), 0., generator.height(), n, Nx, Ny, bcx, bcy, comm), m_handle(generator)
     {
-        //generate global 2d grid and then reduce to local
-        RealCurvilinearGrid2d<real_type> g(generator, n, Nx, Ny);
-        divide_and_conquer(g);
+        construct( n, Nx, Ny);
     }
     ///explicit conversion of 3d product grid to the perpendicular grid
     explicit RealCurvilinearMPIGrid2d( const RealCurvilinearProductMPIGrid3d<real_type>& g);
@@ -54,30 +52,39 @@ struct RealCurvilinearMPIGrid2d : public dg::aRealMPIGeometry2d<real_type>
     virtual void do_set( unsigned new_n, unsigned new_Nx, unsigned new_Ny) override final
     {
         dg::aRealMPITopology2d<real_type>::do_set(new_n, new_Nx, new_Ny);
-        RealCurvilinearGrid2d<real_type> g( *m_handle, new_n, new_Nx, new_Ny);
-        divide_and_conquer(g);//distribute to processes
+        construct( new_n, new_Nx, new_Ny);
     }
-    void divide_and_conquer(const RealCurvilinearGrid2d<real_type>& g_)
+    //generate only the local zeta slab (the generators need whole eta lines)
+    //and keep the local eta rows
+    void construct( unsigned n, unsigned Nx, unsigned Ny)
     {
-        dg::SparseTensor<thrust::host_vector<real_type> > jacobian=g_.jacobian();
-        dg::SparseTensor<thrust::host_vector<real_type> > metric=g_.metric();
-        std::vector<thrust::host_vector<real_type> > map = g_.map();
-        for( unsigned i=0; i<3; i++)
-            for( unsigned j=0; j<3; j++)
-            {
-                m_metric.idx(i,j) = metric.idx(i,j);
-                m_jac.idx(i,j) = jacobian.idx(i,j);
-            }
+        dg::RealGrid1d<real_type> gX1d( this->local().x0(), this->local().x1(), n, this->local().Nx());
+        dg::RealGrid1d<real_type> gY1d( this->global().y0(), this->global().y1(), n, Ny);
+        thrust::host_vector<real_type> x_vec = dg::evaluate( dg::cooX1d, gX1d);
+        thrust::host_vector<real_type> y_vec = dg::evaluate( dg::cooX1d, gY1d);
+        std::vector<thrust::host_vector<real_type>> values( 6);
+        m_handle->generate( x_vec, y_vec, values[0], values[1], values[2], values[3], values[4], values[5]);
+        //cut out the local eta rows
+        int dims[2], periods[2], coords[2];
+        MPI_Cart_get( this->communicator(), 2, dims, periods, coords);
+        unsigned size = this->local().size();
+        unsigned offset = coords[1]*size;
+        for( unsigned i=0; i<6; i++)
+            values[i] = thrust::host_vector<real_type>( values[i].begin()+offset,
+                values[i].begin()+offset+size);
         // Here we set the communicator implicitly
-        m_jac.values().resize( jacobian.values().size());
-        for( unsigned i=0; i<jacobian.values().size(); i++)
-            m_jac.values()[i] = global2local( jacobian.values()[i], *this);
-        m_metric.values().resize( metric.values().size());
-        for( unsigned i=0; i<metric.values().size(); i++)
-            m_metric.values()[i] = global2local( metric.values()[i], *this);
-        m_map.resize(map.size());
-        for( unsigned i=0; i<map.size(); i++)
-            m_map[i] = global2local( map[i], *this);
+        MPI_Vector<thrust::host_vector<real_type>> temp( values[0], this->communicator());
+        m_jac = SparseTensor< MPI_Vector<thrust::host_vector<real_type>>>( temp);//unit tensor
+        m_jac.values().resize( 6, temp);
+        for( unsigned i=2; i<6; i++)
+            m_jac.values()[i].data() = values[i];
+        m_jac.idx(0,0) = 2, m_jac.idx(0,1) = 3, m_jac.idx(1,0)=4, m_jac.idx(1,1) = 5;
+        m_map.assign(2, temp);
+        m_map[1].data() = values[1];
+        m_metric = detail::square( m_jac, m_map[0], m_handle->isOrthogonal());
+        // the (2,2) entry of the 2d metric is 1 (for the create::volume
+        // function to work properly)
+        dg::blas1::copy( 1., m_metric.values()[3]);
     }
 
     virtual SparseTensor<MPI_Vector<thrust::host_vector<real_type>>> do_compute_jacobian( ) const override final{
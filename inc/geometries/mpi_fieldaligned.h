@@ -57,6 +57,38 @@ void sendBackward( const thrust_vector0& in, thrust_vector1& out, MPI_Comm comm)
                     source, 3, //source
                     comm, &status);
 }
+///non-blocking version of sendForward; complete with MPI_Waitall on rqst
+template<class thrust_vector0, class thrust_vector1>
+void postForward( const thrust_vector0& in, thrust_vector1& out, MPI_Comm comm, MPI_Request rqst[2]) //send to next plane
+{
+    int source, dest;
+    MPI_Cart_shift( comm, 2, +1, &source, &dest);
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+    if( std::is_same< get_execution_policy<thrust_vector0>, CudaTag>::value) //could be serial tag
+        cudaDeviceSynchronize();//wait until device functions are finished before sending data
+#endif //THRUST_DEVICE_SYSTEM
+    unsigned size = in.size();
+    MPI_Irecv( thrust::raw_pointer_cast(out.data()), size, MPI_DOUBLE, //receiver
+               source, 9, comm, &rqst[0]); //source
+    MPI_Isend( thrust::raw_pointer_cast(in.data()), size, MPI_DOUBLE,  //sender
+               dest, 9, comm, &rqst[1]);  //destination
+}
+///non-blocking version of sendBackward; complete with MPI_Waitall on rqst
+template<class thrust_vector0, class thrust_vector1>
+void postBackward( const thrust_vector0& in, thrust_vector1& out, MPI_Comm comm, MPI_Request rqst[2]) //send to previous plane
+{
+    int source, dest;
+    MPI_Cart_shift( comm, 2, -1, &source, &dest);
+#if THRUST_DEVICE_SYSTEM==THRUST_DEVICE_SYSTEM_CUDA
+    if( std::is_same< get_execution_policy<thrust_vector0>, CudaTag>::value) //could be serial tag
+        cudaDeviceSynchronize();//wait until device functions are finished before sending data
+#endif //THRUST_DEVICE_SYSTEM
+    unsigned size = in.size();
+    MPI_Irecv( thrust::raw_pointer_cast(out.data()), size, MPI_DOUBLE, //receiver
+               source, 3, comm, &rqst[0]); //source
+    MPI_Isend( thrust::raw_pointer_cast(in.data()), size, MPI_DOUBLE,  //sender
+               dest, 3, comm, &rqst[1]);  //destination
+}
 }//namespace detail
 
 template <class ProductMPIGeometry, class LocalIMatrix, class CommunicatorXY, class LocalContainer>
@@ -131,57 +163,75 @@ struct Fieldaligned< ProductMPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY
     MPI_Vector<LocalContainer> evaluate( BinaryOp f, UnaryOp g, unsigned p0, unsigned rounds) const;
 
     void operator()(enum whichMatrix which, const MPI_Vector<LocalContainer>& in, MPI_Vector<LocalContainer>& out);
+    void operator()(enum whichMatrix which0, const MPI_Vector<LocalContainer>& in0, MPI_Vector<LocalContainer>& out0,
+                    enum whichMatrix which1, const MPI_Vector<LocalContainer>& in1, MPI_Vector<LocalContainer>& out1);
 
-    const MPI_Vector<LocalContainer>& hm()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& hm()const {
         return m_hm;
     }
-    const MPI_Vector<LocalContainer>& hp()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& hp()const {
         return m_hp;
     }
-    const MPI_Vector<LocalContainer>& hbm()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& hbm()const {
         return m_hbm;
     }
-    const MPI_Vector<LocalContainer>& hbp()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& hbp()const {
         return m_hbp;
     }
-    const MPI_Vector<LocalContainer>& bbm()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& bbm()const {
         return m_bbm;
     }
-    const MPI_Vector<LocalContainer>& bbo()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& bbo()const {
         return m_bbo;
     }
-    const MPI_Vector<LocalContainer>& bbp()const {
+    const MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& bbp()const {
         return m_bbp;
     }
     const ProductMPIGeometry& grid() const{return *m_g;}
   private:
+    typedef std::vector<MPI_Vector<dg::View<const LocalContainer>> > const_planes;
+    typedef std::vector<MPI_Vector<dg::View<LocalContainer>> > planes;
     void ePlus( enum whichMatrix which, const MPI_Vector<LocalContainer>& in, MPI_Vector<LocalContainer>& out);
     void eMinus(enum whichMatrix which, const MPI_Vector<LocalContainer>& in, MPI_Vector<LocalContainer>& out);
+    //split-phase parts of ePlus and eMinus:
+    //1. post: interpolate the plane needed by the neighbor process and start its exchange
+    //2. interior: interpolate all remaining planes while messages are in flight
+    //3. finish: (after MPI_Waitall) insert the received plane and apply boundary conditions
+    void ePlus_post( enum whichMatrix which, const const_planes& f, planes& fpe, MPI_Request rqst[2]);
+    void ePlus_interior( enum whichMatrix which, const const_planes& f, planes& fpe);
+    void ePlus_finish( const const_planes& f, planes& fpe);
+    void eMinus_post( enum whichMatrix which, const const_planes& f, planes& fme, MPI_Request rqst[2]);
+    void eMinus_interior( enum whichMatrix which, const const_planes& f, planes& fme);
+    void eMinus_finish( const const_planes& f, planes& fme);
     MPIDistMat<LocalIMatrix, CommunicatorXY> m_plus, m_minus, m_plusT, m_minusT; //2d interpolation matrices
-    MPI_Vector<LocalContainer> m_hm, m_hp, m_hbm, m_hbp; //3d size
-    MPI_Vector<LocalContainer> m_bbm, m_bbp, m_bbo; //3d size masks
+    MPI_Vector<dg::PlaneBroadcast<LocalContainer>> m_hm, m_hp, m_hbm, m_hbp; //2d size, broadcast to 3d
+    MPI_Vector<dg::PlaneBroadcast<LocalContainer>> m_bbm, m_bbp, m_bbo; //2d size masks, broadcast to 3d
     MPI_Vector<LocalContainer> m_hm2d, m_hp2d; //2d size
     MPI_Vector<LocalContainer> m_left, m_right; //2d size
     MPI_Vector<LocalContainer> m_limiter; //2d size
     MPI_Vector<LocalContainer> m_ghostM, m_ghostP; //2d size
+    MPI_Vector<LocalContainer> m_recvM, m_recvP; //2d size, receive buffers for halo planes
     unsigned m_Nz, m_perp_size;
     dg::bc m_bcx, m_bcy, m_bcz;
-    std::vector<MPI_Vector<dg::View<const LocalContainer>> > m_f;
-    std::vector<MPI_Vector<dg::View<LocalContainer>> > m_temp;
+    const_planes m_f, m_f2;
+    planes m_temp, m_temp2; //m_f2, m_temp2 for the second operand of a combined call
     dg::ClonePtr<ProductMPIGeometry> m_g;
     unsigned m_coords2, m_sizeZ; //number of processes in z
 #ifdef _DG_CUDA_UNAWARE_MPI
     //we need to manually send data through the host
-    thrust::host_vector<double> m_send_buffer, m_recv_buffer; //2d size
+    //index 0 is used by ePlus, index 1 by eMinus
+    std::array<thrust::host_vector<double>,2> m_send_buffer, m_recv_buffer; //2d size
 #endif
-    template<class MPIGeometry>
-    void assign3dfrom2d( const thrust::host_vector<double>& in2d, MPI_Vector<LocalContainer>& out, const MPIGeometry& grid)
+    //temp3d provides the communicators of the 3d vector
+    void assign3dfrom2d( const thrust::host_vector<double>& in2d,
+        MPI_Vector<dg::PlaneBroadcast<LocalContainer>>& out,
+        const MPI_Vector<LocalContainer>& temp3d)
     {
-        dg::split( out, m_temp, grid); //3d vector
         LocalContainer tmp2d;
         dg::assign( in2d, tmp2d);
-        for( unsigned i=0; i<m_Nz; i++)
-            dg::blas1::copy( tmp2d, m_temp[i].data());
+        out.data().construct( tmp2d, m_Nz);
+        out.set_communicator( temp3d.communicator(),
+            temp3d.communicator_mod(), temp3d.communicator_mod_reduce());
     }
 };
 //////////////////////////////////////DEFINITIONS/////////////////////////////////////
@@ -211,8 +261,10 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     dg::assign( dg::pullback(limit, *grid_coarse), m_limiter);
     dg::assign( dg::evaluate(zero, *grid_coarse), m_left);
     m_ghostM = m_ghostP = m_right = m_left;
+    m_recvM = m_recvP = m_left;
 #ifdef _DG_CUDA_UNAWARE_MPI
-    m_recv_buffer = m_send_buffer = m_ghostP.data();
+    m_recv_buffer[0] = m_send_buffer[0] = m_ghostP.data();
+    m_recv_buffer[1] = m_send_buffer[1] = m_ghostP.data();
 #endif
     ///%%%%%%%%%%Set starting points and integrate field lines%%%%%%%%%%%//
 #ifdef DG_BENCHMARK
@@ -281,21 +333,24 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
     if(rank==0) std::cout << "# DS: Conversion            took: "<<t.diff()<<"\n";
 #endif
     ///%%%%%%%%%%%%%%%%%%%%copy into h vectors %%%%%%%%%%%%%%%%%%%//
-    dg::assign( dg::evaluate( dg::zero, grid), m_hm);
-    m_temp = dg::split( m_hm, grid); //3d vector
-    m_f = dg::split( (const MPI_Vector<LocalContainer>&)m_hm, grid);
-    m_hbp = m_hbm = m_hp = m_hm;
+    //the views are re-pointed before every use
+    MPI_Vector<LocalContainer> temp3d;
+    dg::assign( dg::evaluate( dg::zero, grid), temp3d);
+    m_temp = dg::split( temp3d, grid); //3d vector
+    m_f = dg::split( (const MPI_Vector<LocalContainer>&)temp3d, grid);
+    m_temp2 = m_temp, m_f2 = m_f;
     dg::assign( dg::evaluate( dg::zero, *grid_coarse), m_hp2d);
     dg::assign( yp_coarse[2], m_hp2d.data()); //2d vector
     dg::assign( dg::evaluate( dg::zero, *grid_coarse), m_hm2d);
     dg::assign( ym_coarse[2], m_hm2d.data()); //2d vector
-    assign3dfrom2d( hbp, m_hbp, grid);
-    assign3dfrom2d( hbm, m_hbm, grid);
-    assign3dfrom2d( yp_coarse[2], m_hp, grid);
-    assign3dfrom2d( ym_coarse[2], m_hm, grid);
+    //the distances are the same in every plane
+    assign3dfrom2d( hbp, m_hbp, temp3d);
+    assign3dfrom2d( hbm, m_hbm, temp3d);
+    assign3dfrom2d( yp_coarse[2], m_hp, temp3d);
+    assign3dfrom2d( ym_coarse[2], m_hm, temp3d);
     dg::blas1::scal( m_hm2d, -1.);
-    dg::blas1::scal( m_hbm, -1.);
-    dg::blas1::scal( m_hm, -1.);
+    dg::blas1::scal( m_hbm.data().plane(), -1.);
+    dg::blas1::scal( m_hm.data().plane(), -1.);
     ///%%%%%%%%%%%%%%%%%%%%create mask vectors %%%%%%%%%%%%%%%%%%%//
     thrust::host_vector<double> bbm( in_boxp.size(),0.), bbo(bbm), bbp(bbm);
     for( unsigned i=0; i<in_boxp.size(); i++)
@@ -308,10 +363,9 @@ Fieldaligned<MPIGeometry, MPIDistMat<LocalIMatrix, CommunicatorXY>, MPI_Vector<L
             bbm[i] = 1.;
         // else all are 0
     }
-    m_bbm = m_bbo = m_bbp = m_hm;
-    assign3dfrom2d( bbm, m_bbm, grid);
-    assign3dfrom2d( bbo, m_bbo, grid);
-    assign3dfrom2d( bbp, m_bbp, grid);
+    assign3dfrom2d( bbm, m_bbm, temp3d);
+    assign3dfrom2d( bbo, m_bbo, temp3d);
+    assign3dfrom2d( bbp, m_bbp, temp3d);
 }
 
 template<class G, class M, class C, class container>
@@ -390,93 +444,181 @@ void Fieldaligned<G, MPIDistMat<M,C>, MPI_Vector<container> >::operator()(enum w
     if(which == einsMinus || which == einsPlusT) eMinus( which, f, fe);
 }
 
+template<class G, class M, class C, class container>
+void Fieldaligned<G, MPIDistMat<M,C>, MPI_Vector<container> >::operator()(
+        enum whichMatrix which0, const MPI_Vector<container>& f0, MPI_Vector<container>& fe0,
+        enum whichMatrix which1, const MPI_Vector<container>& f1, MPI_Vector<container>& fe1)
+{
+    bool plus0 = (which0 == einsPlus || which0 == einsMinusT);
+    bool plus1 = (which1 == einsPlus || which1 == einsMinusT);
+    if( plus0 == plus1) //both go in the same direction: no overlap possible
+    {
+        (*this)( which0, f0, fe0);
+        (*this)( which1, f1, fe1);
+        return;
+    }
+    //make 0 the plus and 1 the minus operand
+    if( !plus0)
+        return (*this)( which1, f1, fe1, which0, f0, fe0);
+    dg::split( f0, m_f, *m_g);
+    dg::split( fe0, m_temp, *m_g);
+    dg::split( f1, m_f2, *m_g);
+    dg::split( fe1, m_temp2, *m_g);
+    MPI_Request rqst[4];
+    ePlus_post(  which0, m_f,  m_temp,  &rqst[0]);
+    eMinus_post( which1, m_f2, m_temp2, &rqst[2]);
+    ePlus_interior(  which0, m_f,  m_temp);
+    eMinus_interior( which1, m_f2, m_temp2);
+    MPI_Waitall( 4, rqst, MPI_STATUSES_IGNORE);
+    ePlus_finish(  m_f,  m_temp);
+    eMinus_finish( m_f2, m_temp2);
+}
+
 template<class G, class M, class C, class container>
 void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::ePlus( enum whichMatrix which, const MPI_Vector<container>& f, MPI_Vector<container>& fpe )
 {
     dg::split( f, m_f, *m_g);
     dg::split( fpe, m_temp, *m_g);
-    //1. compute 2d interpolation in every plane and store in m_temp
-    for( unsigned i0=0; i0<m_Nz; i0++)
+    MPI_Request rqst[2];
+    ePlus_post( which, m_f, m_temp, rqst);
+    ePlus_interior( which, m_f, m_temp);
+    MPI_Waitall( 2, rqst, MPI_STATUSES_IGNORE);
+    ePlus_finish( m_f, m_temp);
+}
+
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::ePlus_post( enum whichMatrix which, const const_planes& f, planes& fpe, MPI_Request rqst[2])
+{
+    rqst[0] = rqst[1] = MPI_REQUEST_NULL;
+    //1. compute 2d interpolation in the last plane first since it is sent
+    unsigned i0 = m_Nz-1;
+    if(which == einsPlus)           dg::blas2::symv( m_plus,   f[0], fpe[i0]);
+    else if(which == einsMinusT)    dg::blas2::symv( m_minusT, f[0], fpe[i0]);
+
+    //2. start communication of halo in z
+    if( m_sizeZ != 1)
     {
-        unsigned ip = (i0==m_Nz-1) ? 0:i0+1;
-        if(which == einsPlus)           dg::blas2::symv( m_plus,   m_f[ip], m_temp[i0]);
-        else if(which == einsMinusT)    dg::blas2::symv( m_minusT, m_f[ip], m_temp[i0]);
+#ifdef _DG_CUDA_UNAWARE_MPI
+        thrust::copy( fpe[i0].data().cbegin(), fpe[i0].data().cend(), m_send_buffer[0].begin());
+        detail::postBackward( m_send_buffer[0], m_recv_buffer[0], m_g->communicator(), rqst);
+#else
+        detail::postBackward( fpe[i0].data(), m_recvM.data(), m_g->communicator(), rqst);
+#endif //_DG_CUDA_UNAWARE_MPI
     }
+}
 
-    //2. communicate halo in z
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::ePlus_interior( enum whichMatrix which, const const_planes& f, planes& fpe)
+{
+    //3. compute 2d interpolation in all other planes while the halo is in flight
+    for( unsigned i0=0; i0<m_Nz-1; i0++)
+    {
+        unsigned ip = i0+1;
+        if(which == einsPlus)           dg::blas2::symv( m_plus,   f[ip], fpe[i0]);
+        else if(which == einsMinusT)    dg::blas2::symv( m_minusT, f[ip], fpe[i0]);
+    }
+}
+
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::ePlus_finish( const const_planes& f, planes& fpe)
+{
+    unsigned i0=m_Nz-1;
     if( m_sizeZ != 1)
     {
-        unsigned i0 = m_Nz-1;
 #ifdef _DG_CUDA_UNAWARE_MPI
-        thrust::copy( m_temp[i0].data().cbegin(), m_temp[i0].data().cend(), m_send_buffer.begin());
-        detail::sendBackward( m_send_buffer, m_recv_buffer, m_g->communicator());
-        thrust::copy( m_recv_buffer.cbegin(), m_recv_buffer.cend(), m_temp[i0].data().begin());
+        thrust::copy( m_recv_buffer[0].cbegin(), m_recv_buffer[0].cend(), fpe[i0].data().begin());
 #else
-        detail::sendBackward( m_temp[i0].data(), m_ghostM.data(), m_g->communicator());
-        dg::blas1::copy( m_ghostM, m_temp[i0]);
+        dg::blas1::copy( m_recvM, fpe[i0]);
 #endif //_DG_CUDA_UNAWARE_MPI
     }
 
-    //3. apply right boundary conditions in last plane
-    unsigned i0=m_Nz-1;
+    //4. apply right boundary conditions in last plane
     if( m_bcz != dg::PER && m_g->local().z1() == m_g->global().z1())
     {
         if( m_bcz == dg::DIR || m_bcz == dg::NEU_DIR)
-            dg::blas1::axpby( 2, m_right, -1., m_f[i0], m_ghostP);
+            dg::blas1::axpby( 2, m_right, -1., f[i0], m_ghostP);
         if( m_bcz == dg::NEU || m_bcz == dg::DIR_NEU)
         {
             dg::blas1::pointwiseDot( m_right, m_hp2d, m_ghostP);
-            dg::blas1::axpby( 1., m_ghostP, 1., m_f[i0], m_ghostP);
+            dg::blas1::axpby( 1., m_ghostP, 1., f[i0], m_ghostP);
         }
         //interlay ghostcells with periodic cells: L*g + (1-L)*fpe
-        dg::blas1::axpby( 1., m_ghostP, -1., m_temp[i0], m_ghostP);
-        dg::blas1::pointwiseDot( 1., m_limiter, m_ghostP, 1., m_temp[i0]);
+        dg::blas1::axpby( 1., m_ghostP, -1., fpe[i0], m_ghostP);
+        dg::blas1::pointwiseDot( 1., m_limiter, m_ghostP, 1., fpe[i0]);
     }
 }
 
 template<class G, class M, class C, class container>
 void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::eMinus( enum whichMatrix which, const MPI_Vector<container>& f, MPI_Vector<container>& fme )
 {
-    int rank;
-    MPI_Comm_rank(m_g->communicator(), &rank);
     dg::split( f, m_f, *m_g);
     dg::split( fme, m_temp, *m_g);
-    //1. compute 2d interpolation in every plane and store in m_temp
-    for( unsigned i0=0; i0<m_Nz; i0++)
+    MPI_Request rqst[2];
+    eMinus_post( which, m_f, m_temp, rqst);
+    eMinus_interior( which, m_f, m_temp);
+    MPI_Waitall( 2, rqst, MPI_STATUSES_IGNORE);
+    eMinus_finish( m_f, m_temp);
+}
+
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::eMinus_post( enum whichMatrix which, const const_planes& f, planes& fme, MPI_Request rqst[2])
+{
+    rqst[0] = rqst[1] = MPI_REQUEST_NULL;
+    //1. compute 2d interpolation in the first plane first since it is sent
+    unsigned i0 = 0;
+    if(which == einsPlusT)         dg::blas2::symv( m_plusT, f[m_Nz-1], fme[i0]);
+    else if(which == einsMinus)    dg::blas2::symv( m_minus, f[m_Nz-1], fme[i0]);
+
+    //2. start communication of halo in z
+    if( m_sizeZ != 1)
+    {
+#ifdef _DG_CUDA_UNAWARE_MPI
+        thrust::copy( fme[i0].data().cbegin(), fme[i0].data().cend(), m_send_buffer[1].begin());
+        detail::postForward( m_send_buffer[1], m_recv_buffer[1], m_g->communicator(), rqst);
+#else
+        detail::postForward( fme[i0].data(), m_recvP.data(), m_g->communicator(), rqst);
+#endif //_DG_CUDA_UNAWARE_MPI
+    }
+}
+
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::eMinus_interior( enum whichMatrix which, const const_planes& f, planes& fme)
+{
+    //3. compute 2d interpolation in all other planes while the halo is in flight
+    for( unsigned i0=1; i0<m_Nz; i0++)
     {
-        unsigned im = (i0==0) ? m_Nz-1:i0-1;
-        if(which == einsPlusT)         dg::blas2::symv( m_plusT, m_f[im], m_temp[i0]);
-        else if(which == einsMinus)    dg::blas2::symv( m_minus, m_f[im], m_temp[i0]);
+        unsigned im = i0-1;
+        if(which == einsPlusT)         dg::blas2::symv( m_plusT, f[im], fme[i0]);
+        else if(which == einsMinus)    dg::blas2::symv( m_minus, f[im], fme[i0]);
     }
+}
 
-    //2. communicate halo in z
+template<class G, class M, class C, class container>
+void Fieldaligned<G,MPIDistMat<M,C>, MPI_Vector<container> >::eMinus_finish( const const_planes& f, planes& fme)
+{
+    unsigned i0=0;
     if( m_sizeZ != 1)
     {
-        unsigned i0 = 0;
 #ifdef _DG_CUDA_UNAWARE_MPI
-        thrust::copy( m_temp[i0].data().cbegin(), m_temp[i0].data().cend(), m_send_buffer.begin());
-        detail::sendForward( m_send_buffer, m_recv_buffer, m_g->communicator());
-        thrust::copy( m_recv_buffer.cbegin(), m_recv_buffer.cend(), m_temp[i0].data().begin());
+        thrust::copy( m_recv_buffer[1].cbegin(), m_recv_buffer[1].cend(), fme[i0].data().begin());
 #else
-        detail::sendForward( m_temp[i0].data(), m_ghostP.data(), m_g->communicator());
-        dg::blas1::copy( m_ghostP, m_temp[i0]);
+        dg::blas1::copy( m_recvP, fme[i0]);
 #endif //_DG_CUDA_UNAWARE_MPI
     }
 
-    //3. apply left boundary conditions in first plane
-    unsigned i0=0;
+    //4. apply left boundary conditions in first plane
     if( m_bcz != dg::PER && m_g->local().z0() == m_g->global().z0())
     {
         if( m_bcz == dg::DIR || m_bcz == dg::DIR_NEU)
-            dg::blas1::axpby( 2., m_left,  -1., m_f[i0], m_ghostM);
+            dg::blas1::axpby( 2., m_left,  -1., f[i0], m_ghostM);
         if( m_bcz == dg::NEU || m_bcz == dg::NEU_DIR)
         {
             dg::blas1::pointwiseDot( m_left, m_hm2d, m_ghostM);
-            dg::blas1::axpby( -1., m_ghostM, 1., m_f[i0], m_ghostM);
+            dg::blas1::axpby( -1., m_ghostM, 1., f[i0], m_ghostM);
         }
         //interlay ghostcells with periodic cells: L*g + (1-L)*fme
-        dg::blas1::axpby( 1., m_ghostM, -1., m_temp[i0], m_ghostM);
-        dg::blas1::pointwiseDot( 1., m_limiter, m_ghostM, 1., m_temp[i0]);
+        dg::blas1::axpby( 1., m_ghostM, -1., fme[i0], m_ghostM);
+        dg::blas1::pointwiseDot( 1., m_limiter, m_ghostM, 1., fme[i0]);
     }
 }
 
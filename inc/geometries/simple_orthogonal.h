@@ -185,8 +185,12 @@ struct Nemov
     void operator()(double t, const std::array<thrust::host_vector<double>,3 >& y, std::array<thrust::host_vector<double>,3>& yp)
     {
         //y[0] = R, y[1] = Z, y[2] = h, y[3] = hr, y[4] = hz
-        unsigned size = y[0].size();
-        for( unsigned i=0; i<size; i++)
+        //all coordinate lines are independent
+        const int size = y[0].size();
+#ifdef _OPENMP
+        #pragma omp parallel for
+#endif //_OPENMP
+        for( int i=0; i<size; i++)
         {
             double xx = y[0][i], yy = y[1][i];
             double psipR = psip_.dfx()(xx, yy), psipZ = psip_.dfy()(xx,yy);
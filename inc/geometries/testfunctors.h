@@ -294,6 +294,23 @@ unsigned max_iter = 1e4, double eps = 1e-6)
         dg::blas1::pointwiseDot( divb, out, out);
         ds.dss( 1., in, 1., out);
     }
+    else if( name == "cachedCentered"){
+        ds.set_field( in);
+        ds.cached_ds( dg::centered, 1., 0., out);
+    }
+    else if( name == "cachedDss"){
+        ds.set_field( in);
+        ds.cached_dss( 1., 0., out);
+    }
+    else if( name == "cachedDivCentered"){
+        ds.set_field( in, true);
+        ds.cached_divCentered( 1., 0., out);
+    }
+    else if( name == "cachedLap"){
+        container dsf( in);
+        ds.set_field( in);
+        ds.cached_lapPar( divb, 1., dsf, 0., out);
+    }
     else if( name == "invForwardLap"){
         dg::Invert<container> invert( in, max_iter, eps, 1);
         ds.set_direction( dg::forward);
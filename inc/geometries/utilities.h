@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include "fluxfunctions.h"
 
 ///@cond
@@ -511,8 +512,10 @@ void construct_psi_values( FieldFinv fpsiMinv,
 
 //compute the vector of r and z - values that form one psi surface
 //assumes that the initial line is perpendicular
+//steps is the number of steps to start the doubling with (e.g. from a neighboring surface)
+//returns the number of steps of the converged result
 template <class Fpsi, class FieldRZYRYZY>
-void compute_rzy(Fpsi fpsi, FieldRZYRYZY fieldRZYRYZY,
+unsigned compute_rzy(Fpsi fpsi, FieldRZYRYZY fieldRZYRYZY,
         double psi, const thrust::host_vector<double>& y_vec,
         thrust::host_vector<double>& r,
         thrust::host_vector<double>& z,
@@ -520,7 +523,8 @@ void compute_rzy(Fpsi fpsi, FieldRZYRYZY fieldRZYRYZY,
         thrust::host_vector<double>& yz,
         thrust::host_vector<double>& xr,
         thrust::host_vector<double>& xz,
-        double& R_0, double& Z_0, double& f, double& fp, bool verbose = false )
+        double& R_0, double& Z_0, double& f, double& fp, bool verbose = false,
+        unsigned steps = 1)
 {
     thrust::host_vector<double> r_old(y_vec.size(), 0), r_diff( r_old), yr_old(r_old), xr_old(r_old);
     thrust::host_vector<double> z_old(y_vec.size(), 0), z_diff( z_old), yz_old(r_old), xz_old(z_old);
@@ -535,7 +539,6 @@ void compute_rzy(Fpsi fpsi, FieldRZYRYZY fieldRZYRYZY,
     fieldRZYRYZY.initialize( begin[0], begin[1], begin[2], begin[3]);
     R_0 = begin[0], Z_0 = begin[1];
     if(verbose)std::cout <<f_psi<<" "<<" "<< begin[0] << " "<<begin[1]<<"\t";
-    unsigned steps = 1;
     double eps = 1e10, eps_old=2e10;
     while( eps < eps_old)
     {
@@ -565,7 +568,30 @@ void compute_rzy(Fpsi fpsi, FieldRZYRYZY fieldRZYRYZY,
     }
     r = r_old, z = z_old, yr = yr_old, yz = yz_old, xr = xr_old, xz = xz_old;
     f = f_psi;
+    return steps/4; //steps was doubled twice since the old result was computed
+}
 
+//Call steps = compute_surface( i, steps) for all flux surfaces i in [0,size)
+//The surfaces are independent and distributed over OpenMP threads in chunks
+//of fixed size. Within a chunk the number of integration steps is
+//warm-started from the previous surface. Since the chunks do not
+//depend on the number of threads neither does the result.
+template<class SurfaceFunctor>
+void for_each_surface( unsigned size, SurfaceFunctor compute_surface)
+{
+    const unsigned chunk_size = 8;
+    const int num_chunks = (size + chunk_size - 1)/chunk_size;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif //_OPENMP
+    for( int c=0; c<num_chunks; c++)
+    {
+        unsigned steps = 1;
+        unsigned end = std::min( size, (c+1)*chunk_size);
+        for( unsigned i=c*chunk_size; i<end; i++)
+            //the convergence test needs at least one coarser result
+            steps = std::max( 1u, compute_surface( i, steps)/2);
+    }
 }
 
 } //namespace detail
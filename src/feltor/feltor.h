@@ -19,6 +19,9 @@ struct Explicit
 {
     using vector = std::array<std::array<Container,2>,2>;
     using container = Container;
+    //the magnetic field does not depend on phi: store one plane only
+    using Broadcast = std::decay_t<decltype( dg::broadcast_plane(
+        std::declval<const Container&>(), std::declval<const Geometry&>()))>;
     Explicit( const Geometry& g, feltor::Parameters p,
         dg::geo::TokamakMagneticField mag ); //full system means explicit AND implicit
 
@@ -95,9 +98,8 @@ struct Explicit
         dg::geo::dss_centered_bc_along_field( m_fa, 1., m_minusU[i], m_fields[1][i], m_plusU[i], 0., dssU, dg::NEU, {0,0});
     }
     void compute_lapParU(int i, Container& lapU) {
-        compute_dsU(i, m_temp0);
-        compute_dssU(i, lapU);
-        dg::blas1::pointwiseDot( 1., m_divb, m_temp0, 1., lapU);
+        dg::geo::ds_lapPar_centered_bc_along_field( m_fa, 1., m_minusU[i],
+            m_fields[1][i], m_plusU[i], m_divb, m_temp0, 0., lapU, dg::NEU, {0,0});
     }
     void compute_gradSN( int i, std::array<Container,3>& gradS) const{
         // MW: don't like this function, if we need more gradients we might
@@ -110,26 +112,26 @@ struct Explicit
     void compute_dot_induction( Container& tmp) const {
         m_old_apar.derive( tmp);
     }
-    const dg::SparseTensor<Container>& projection() const{
+    const dg::SparseTensor<Broadcast>& projection() const{
         return m_hh;
     }
-    const std::array<Container, 3> & curv () const {
+    const std::array<Broadcast, 3> & curv () const {
         return m_curv;
     }
-    const std::array<Container, 3> & curvKappa () const {
+    const std::array<Broadcast, 3> & curvKappa () const {
         return m_curvKappa;
     }
-    const Container& divCurvKappa() const {
+    const Broadcast& divCurvKappa() const {
         return m_divCurvKappa;
     }
-    const Container& bphi( ) const { return m_bphi; }
-    const Container& binv( ) const { return m_binv; }
-    const Container& divb( ) const { return m_divb; }
+    const Broadcast& bphi( ) const { return m_bphi; }
+    const Broadcast& binv( ) const { return m_binv; }
+    const Broadcast& divb( ) const { return m_divb; }
     //volume with dG weights
     const Container& vol3d() const { return m_lapperpN.weights();}
     const Container& weights() const { return m_lapperpN.weights();}
     //bhat / sqrt{g} / B
-    const std::array<Container, 3> & bhatgB () const {
+    const std::array<Broadcast, 3> & bhatgB () const {
         return m_b;
     }
     const Container& lapMperpP (int i)
@@ -209,6 +211,9 @@ struct Explicit
         dg::geo::TokamakMagneticField);
     void construct_invert( const Geometry&, feltor::Parameters,
         dg::geo::TokamakMagneticField);
+    void invert_gamma( std::vector<dg::Helmholtz3d<Geometry, Matrix, Container> >& multi_gamma,
+        dg::ChebyshevHelmholtz<Container>& cheby_gamma,
+        Container& x, const Container& b);
 
     Container m_UE2;
     Container m_temp0, m_temp1, m_temp2;//helper variables
@@ -217,9 +222,9 @@ struct Explicit
 #endif //DG_MANUFACTURED
 
     //these should be considered const // m_curv is full curvature
-    std::array<Container,3> m_curv, m_curvKappa, m_b; //m_b is bhat/ sqrt(g) / B
-    Container m_divCurvKappa;
-    Container m_bphi, m_binv, m_divb;
+    std::array<Broadcast,3> m_curv, m_curvKappa, m_b; //m_b is bhat/ sqrt(g) / B
+    Broadcast m_divCurvKappa;
+    Broadcast m_bphi, m_binv, m_divb;
     Container m_source, m_profne, m_forcing, m_U_sheath, m_masked;
 
     Container m_apar;
@@ -241,9 +246,10 @@ struct Explicit
         m_multi_invgammaN, m_multi_induction;
 
     dg::MultigridCG2d<Geometry, Matrix, Container> m_multigrid;
+    dg::ChebyshevHelmholtz<Container> m_cheby_gammaP, m_cheby_gammaN;
     dg::Extrapolation<Container> m_old_phi, m_old_psi, m_old_gammaN, m_old_apar;
 
-    dg::SparseTensor<Container> m_hh;
+    dg::SparseTensor<Broadcast> m_hh;
 
     const feltor::Parameters m_p;
     double m_omega_source = 0., m_sheath_forcing = 0., m_wall_forcing = 0.;
@@ -259,6 +265,8 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_mag(
         throw dg::Error(dg::Message(_ping_)<<"Warning! perp_diff value '"<<p.perp_diff<<"' not recognized!! I do not know how to proceed! Exit now!");
     //due to the various approximations bhat and mag not always correspond
     dg::geo::CylindricalVectorLvl0 curvNabla, curvKappa;
+    Container divCurvKappa;
+    std::array<Container,3> curv, curvK;
     m_reversed_field = false;
     if( mag.ipol()( g.x0(), g.y0()) < 0)
         m_reversed_field = true;
@@ -267,7 +275,7 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_mag(
         curvNabla = dg::geo::createTrueCurvatureNablaB(mag);
         curvKappa = dg::geo::createTrueCurvatureKappa(mag);
         dg::assign(  dg::pullback(dg::geo::TrueDivCurvatureKappa(mag), g),
-            m_divCurvKappa);
+            divCurvKappa);
     }
     else if( p.curvmode == "low beta")
     {
@@ -275,7 +283,7 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_mag(
             curvNabla = curvKappa = dg::geo::createCurvatureNablaB(mag, -1);
         else
             curvNabla = curvKappa = dg::geo::createCurvatureNablaB(mag, +1);
-        dg::assign( dg::evaluate(dg::zero, g), m_divCurvKappa);
+        dg::assign( dg::evaluate(dg::zero, g), divCurvKappa);
     }
     else if( p.curvmode == "toroidal")
     {
@@ -284,25 +292,33 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_mag(
             curvNabla = dg::geo::createCurvatureNablaB(mag, -1);
             curvKappa = dg::geo::createCurvatureKappa(mag, -1);
             dg::assign(  dg::pullback(dg::geo::DivCurvatureKappa(mag, -1), g),
-                m_divCurvKappa);
+                divCurvKappa);
         }
         else
         {
             curvNabla = dg::geo::createCurvatureNablaB(mag, +1);
             curvKappa = dg::geo::createCurvatureKappa(mag, +1);
             dg::assign(  dg::pullback(dg::geo::DivCurvatureKappa(mag, +1), g),
-                m_divCurvKappa);
+                divCurvKappa);
         }
     }
     else
         throw dg::Error(dg::Message(_ping_)<<"Warning! curvmode value '"<<p.curvmode<<"' not recognized!! I don't know what to do! I exit!\n");
     dg::pushForward(curvNabla.x(), curvNabla.y(), curvNabla.z(),
-        m_curv[0], m_curv[1], m_curv[2], g);
+        curv[0], curv[1], curv[2], g);
     dg::pushForward(curvKappa.x(), curvKappa.y(), curvKappa.z(),
-        m_curvKappa[0], m_curvKappa[1], m_curvKappa[2], g);
-    dg::blas1::axpby( 1., m_curvKappa, 1., m_curv);
-    dg::assign(  dg::pullback(dg::geo::InvB(mag), g), m_binv);
-    dg::assign(  dg::pullback(dg::geo::Divb(mag), g), m_divb);
+        curvK[0], curvK[1], curvK[2], g);
+    dg::blas1::axpby( 1., curvK, 1., curv);
+    for( int i=0; i<3; i++)
+    {
+        m_curv[i] = dg::broadcast_plane( curv[i], g);
+        m_curvKappa[i] = dg::broadcast_plane( curvK[i], g);
+    }
+    m_divCurvKappa = dg::broadcast_plane( divCurvKappa, g);
+    dg::assign(  dg::pullback(dg::geo::InvB(mag), g), m_temp0);
+    m_binv = dg::broadcast_plane( m_temp0, g);
+    dg::assign(  dg::pullback(dg::geo::Divb(mag), g), m_temp0);
+    m_divb = dg::broadcast_plane( m_temp0, g);
 
 }
 template<class Grid, class IMatrix, class Matrix, class Container>
@@ -334,16 +350,21 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_bhat(
         bhat = dg::geo::createBHat(mag);
     else if( m_reversed_field)
         bhat = dg::geo::createEPhi(-1);
-    dg::pushForward(bhat.x(), bhat.y(), bhat.z(), m_b[0], m_b[1], m_b[2], g);
+    std::array<Container,3> b;
+    dg::pushForward(bhat.x(), bhat.y(), bhat.z(), b[0], b[1], b[2], g);
     dg::SparseTensor<Container> metric = g.metric();
-    dg::tensor::inv_multiply3d( metric, m_b[0], m_b[1], m_b[2],
-                                        m_b[0], m_b[1], m_b[2]);
-    dg::assign( m_b[2], m_bphi); //save bphi for momentum conservation
+    dg::tensor::inv_multiply3d( metric, b[0], b[1], b[2],
+                                        b[0], b[1], b[2]);
+    m_bphi = dg::broadcast_plane( b[2], g); //save bphi for momentum conservation
     Container detg = dg::tensor::volume( metric);
     dg::blas1::pointwiseDivide( m_binv, detg, m_temp0); //1/B/detg
     for( int i=0; i<3; i++)
-        dg::blas1::pointwiseDot( m_temp0, m_b[i], m_b[i]); //b_i/detg/B
-    m_hh = dg::geo::createProjectionTensor( bhat, g);
+    {
+        dg::blas1::pointwiseDot( m_temp0, b[i], b[i]); //b_i/detg/B
+        m_b[i] = dg::broadcast_plane( b[i], g);
+    }
+    m_hh = dg::broadcast_plane( dg::SparseTensor<Container>(
+        dg::geo::createProjectionTensor( bhat, g)), g);
     m_lapperpN.construct ( g, p.bcxN, p.bcyN, dg::PER, dg::normed, dg::centered),
     m_lapperpU.construct ( g, p.bcxU, p.bcyU, dg::PER, dg::normed, dg::centered),
     m_lapperpP.construct ( g, p.bcxP, p.bcyP, dg::PER, dg::normed, dg::centered),
@@ -398,6 +419,30 @@ void Explicit<Grid, IMatrix, Matrix, Container>::construct_invert(
             m_multi_induction[u].elliptic().set_compute_in_2d( true);
         }
     }
+    if( p.gamma_solver == "chebyshev")
+    {
+        dg::assign( dg::evaluate( dg::WhiteNoise(), g), m_temp1);
+        m_cheby_gammaP.construct( m_temp0, p.eps_gamma);
+        m_cheby_gammaN.construct( m_temp0, p.eps_gamma);
+        m_cheby_gammaP.set_bounds( m_multi_invgammaP[0], m_temp1);
+        m_cheby_gammaN.set_bounds( m_multi_invgammaN[0], m_temp1);
+    }
+}
+template<class Geometry, class IMatrix, class Matrix, class Container>
+void Explicit<Geometry, IMatrix, Matrix, Container>::invert_gamma(
+    std::vector<dg::Helmholtz3d<Geometry, Matrix, Container> >& multi_gamma,
+    dg::ChebyshevHelmholtz<Container>& cheby_gamma,
+    Container& x, const Container& b)
+{
+    if( m_p.gamma_solver == "chebyshev")
+        cheby_gamma.inverse( multi_gamma[0], x, b);
+    else
+    {
+        std::vector<unsigned> number = m_multigrid.direct_solve(
+            multi_gamma, x, b, m_p.eps_gamma);
+        if(  number[0] == m_multigrid.max_iter())
+            throw dg::Fail( m_p.eps_gamma);
+    }
 }
 template<class Grid, class IMatrix, class Matrix, class Container>
 Explicit<Grid, IMatrix, Matrix, Container>::Explicit( const Grid& g,
@@ -453,10 +498,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::initializene(
     dg::blas1::copy( src, target);
     if (m_p.tau[1] != 0.) {
         // ne-1 = Gamma (ni-1)
-        std::vector<unsigned> number = m_multigrid.direct_solve(
-            m_multi_invgammaN, target, src, m_p.eps_gamma);
-        if(  number[0] == m_multigrid.max_iter())
-            throw dg::Fail( m_p.eps_gamma);
+        invert_gamma( m_multi_invgammaN, m_cheby_gammaN, target, src);
     }
 }
 template<class Geometry, class IMatrix, class Matrix, class Container>
@@ -523,15 +565,11 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_phi(
         dg::blas1::evaluate( m_temp1, dg::plus_equals(), manufactured::SGammaNi{
             m_p.mu[0],m_p.mu[1],m_p.tau[0],m_p.tau[1],m_p.eta,
             m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
-        std::vector<unsigned> numberG = m_multigrid.direct_solve(
-            m_multi_invgammaN, m_temp0, m_temp1, m_p.eps_gamma);
+        invert_gamma( m_multi_invgammaN, m_cheby_gammaN, m_temp0, m_temp1);
 #else
-        std::vector<unsigned> numberG = m_multigrid.direct_solve(
-            m_multi_invgammaN, m_temp0, y[1], m_p.eps_gamma);
+        invert_gamma( m_multi_invgammaN, m_cheby_gammaN, m_temp0, y[1]);
 #endif //DG_MANUFACTURED
         m_old_gammaN.update( time, m_temp0);
-        if(  numberG[0] == m_multigrid.max_iter())
-            throw dg::Fail( m_p.eps_gamma);
         dg::blas1::axpby( -1., y[0], 1., m_temp0, m_temp0);
     }
 #ifdef DG_MANUFACTURED
@@ -562,15 +600,11 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_psi(
         dg::blas1::evaluate( m_temp0, dg::plus_equals(), manufactured::SGammaPhie{
             m_p.mu[0],m_p.mu[1],m_p.tau[0],m_p.tau[1],m_p.eta,
             m_p.beta,m_p.nu_perp,m_p.nu_parallel[0],m_p.nu_parallel[1]},m_R,m_Z,m_P,time);
-        std::vector<unsigned> number = m_multigrid.direct_solve(
-            m_multi_invgammaP, m_phi[1], m_temp0, m_p.eps_gamma);
+        invert_gamma( m_multi_invgammaP, m_cheby_gammaP, m_phi[1], m_temp0);
 #else
-        std::vector<unsigned> number = m_multigrid.direct_solve(
-            m_multi_invgammaP, m_phi[1], m_phi[0], m_p.eps_gamma);
+        invert_gamma( m_multi_invgammaP, m_cheby_gammaP, m_phi[1], m_phi[0]);
 #endif //DG_MANUFACTURED
         m_old_psi.update( time, m_phi[1]);
-        if(  number[0] == m_multigrid.max_iter())
-            throw dg::Fail( m_p.eps_gamma);
     }
     //-------Compute Psi and derivatives
     dg::blas2::symv( m_dx_P, m_phi[0], m_dP[0][0]);
@@ -764,14 +798,16 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_parallel(
     for( unsigned i=0; i<2; i++)
     {
 
-        m_fa( dg::geo::einsMinus, y[0][i], m_minusN[i]);
-        m_fa( dg::geo::einsPlus,  y[0][i], m_plusN[i]);
-        m_fa( dg::geo::einsMinus, fields[1][i], m_minusU[i]);
-        m_fa( dg::geo::einsPlus,  fields[1][i], m_plusU[i]);
-        m_fa( dg::geo::einsMinus, m_phi[i], m_minusP[i]);
-        m_fa( dg::geo::einsPlus,  m_phi[i], m_plusP[i]);
+        m_fa( dg::geo::einsPlus, y[0][i], m_plusN[i],
+              dg::geo::einsMinus, y[0][i], m_minusN[i]);
+        m_fa( dg::geo::einsPlus, fields[1][i], m_plusU[i],
+              dg::geo::einsMinus, fields[1][i], m_minusU[i]);
+        m_fa( dg::geo::einsPlus, m_phi[i], m_plusP[i],
+              dg::geo::einsMinus, m_phi[i], m_minusP[i]);
         dg::geo::ds_centered_bc_along_field( m_fa, 1., m_minusN[i], y[0][i], m_plusN[i], 0., m_temp0, dg::NEU, {0,0});
-        dg::geo::ds_centered_bc_along_field( m_fa, 1., m_minusU[i], fields[1][i], m_plusU[i], 0., m_temp1, dg::NEU, {0,0});
+        // dsU and Delta_par U = Div b dsU + dssU in one kernel
+        dg::geo::ds_lapPar_centered_bc_along_field( m_fa, 1., m_minusU[i],
+            fields[1][i], m_plusU[i], m_divb, m_temp1, 0., m_temp2, dg::NEU, {0,0});
         //---------------------density--------------------------//
         //density: -Div ( NUb)
         dg::blas1::pointwiseDot(-1., m_temp0, fields[1][i],
@@ -786,9 +822,7 @@ void Explicit<Geometry, IMatrix, Matrix, Container>::compute_parallel(
         dg::geo::ds_centered_bc_along_field( m_fa, -1./m_p.mu[i], m_minusP[i], m_phi[i], m_plusP[i], 1.0, yp[1][i], dg::DIR, {0,0});
         // viscosity: + nu_par Delta_par U/N = nu_par ( Div b dsU + dssU)/N
         // Maybe factor this out in an operator splitting method? To get larger timestep
-        dg::blas1::pointwiseDot(1., m_divb, m_temp1, 0., m_temp1);
-        dg::geo::dss_centered_bc_along_field( m_fa, 1., m_minusU[i], fields[1][i], m_plusU[i], 1., m_temp1, dg::NEU, {0,0});
-        dg::blas1::pointwiseDivide( m_p.nu_parallel[i], m_temp1, fields[0][i], 1., yp[1][i]);
+        dg::blas1::pointwiseDivide( m_p.nu_parallel[i], m_temp2, fields[0][i], 1., yp[1][i]);
     }
 }
 
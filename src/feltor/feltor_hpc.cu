@@ -58,7 +58,17 @@ int main( int argc, char* argv[])
     {
         try{
             dg::file::file2Json( argv[1], js, dg::file::comments::are_discarded, dg::file::error::is_throw);
-            feltor::Parameters( js, dg::file::error::is_throw);
+            feltor::Parameters pp( js, dg::file::error::is_throw);
+            // only 3d output fields can be reduced
+            for( auto& pair : pp.reduction_divide)
+            {
+                bool found = false;
+                for( auto& record : feltor::diagnostics3d_list)
+                    if( record.name == pair.first)
+                        found = true;
+                if( !found)
+                    throw std::runtime_error( "Value "+pair.first+" for reduction is invalid! Must be the name of a 3d output field\n");
+            }
         } catch( std::exception& e) {
             DG_RANK0 std::cerr << "ERROR in input parameter file "<<argv[1]<<std::endl;
             DG_RANK0 std::cerr << e.what()<<std::endl;
@@ -170,8 +180,21 @@ int main( int argc, char* argv[])
     feltor::Variables var = {
         feltor, p, mag, gradPsip, gradPsip, hoo
     };
-    // the vector ids
-    std::map<std::string, int> id3d, id4d, restart_ids;
+    // the vector ids are defined all at once and cached in the writer
+#ifdef WITH_MPI
+    dg::file::Writer writer( rank == 0);
+#else
+    dg::file::Writer writer;
+#endif //WITH_MPI
+    // reduction of 3d fields before output (default is the compression)
+    dg::file::Downsampler<dg::x::DMatrix, dg::x::DVec> reduce_default( grid,
+        {1, p.cx, p.cy, 1});
+    std::map<std::string, dg::file::Downsampler<dg::x::DMatrix, dg::x::DVec>> reducers;
+    auto reducer = [&]( const std::string& name) -> dg::file::Downsampler<dg::x::DMatrix, dg::x::DVec>&
+    {
+        auto it = reducers.find( name);
+        return it == reducers.end() ? reduce_default : it->second;
+    };
 
     double dEdt = 0, accuracy = 0;
     double E0 = 0.;
@@ -269,79 +292,66 @@ int main( int argc, char* argv[])
     if( !(g3d_out.local().z0() - g3d_out.global().z0() < 1e-14) ) write2d = false;
 #endif //WITH_MPI
 
-    //create & output static 3d variables into file
+    //Declare all variables and define them at once
+    for ( auto& record : feltor::diagnostics3d_static_list)
+        writer.def_var( record.name, {dim_ids[1], dim_ids[2], dim_ids[3]},
+            record.long_name);
+    for ( auto& record : feltor::diagnostics2d_static_list)
+        writer.def_var( record.name, {dim_ids[2], dim_ids[3]}, record.long_name);
+    for( auto& record : feltor::diagnostics3d_list)
+    {
+        std::string name = record.name;
+        int reduced_dim_ids[4] = {dim_ids[0], dim_ids[1], dim_ids[2], dim_ids[3]};
+        if( p.reduction_divide.count( name))
+        {
+            dg::file::DownsamplingParameters params;
+            std::array<unsigned,4> divide = p.reduction_divide.at(name);
+            params.divide_n = divide[0], params.divide_Nx = divide[1];
+            params.divide_Ny = divide[2], params.stride_Nz = divide[3];
+            params.region = p.reduction_region.at(name);
+            reducers.emplace( name, dg::file::Downsampler<dg::x::DMatrix,
+                dg::x::DVec>( grid, params));
+            DG_RANK0 err = reducers.at(name).define( ncid, &reduced_dim_ids[1],
+                {"z_"+name, "y_"+name, "x_"+name});
+        }
+        writer.def_var( name, {reduced_dim_ids[0], reduced_dim_ids[1],
+            reduced_dim_ids[2], reduced_dim_ids[3]}, record.long_name);
+    }
+    for( auto& record : feltor::restart3d_list)
+        writer.def_var( record.name, {restart_dim_ids[0], restart_dim_ids[1],
+            restart_dim_ids[2]}, record.long_name);
+    for( auto& record : feltor::diagnostics2d_list)
+    {
+        writer.def_var( record.name + "_ta2d", {dim_ids3d[0], dim_ids3d[1],
+            dim_ids3d[2]}, record.long_name + " (Toroidal average)");
+        writer.def_var( record.name + "_2d", {dim_ids3d[0], dim_ids3d[1],
+            dim_ids3d[2]}, record.long_name + " (Evaluated on phi = 0 plane)");
+    }
+    //probes are buffered every time step and written in blocks
+    dg::file::Probes<dg::x::IDMatrix, dg::x::DVec> probes( p.probesR, p.probesZ,
+        p.probesP, grid, {"electrons_probes", "ions_probes", "Ue_probes",
+        "Ui_probes", "potential_probes", "induction_probes"}, p.probes_buffer);
+    DG_RANK0 err = probes.define( ncid);
+    err = writer.define( ncid); //leaves define mode
+
+    //output static 3d variables into file
     for ( auto& record : feltor::diagnostics3d_static_list)
     {
-        int vecID;
-        DG_RANK0 err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 3,
-            &dim_ids[1], &vecID);
-        DG_RANK0 err = nc_put_att_text( ncid, vecID,
-            "long_name", record.long_name.size(), record.long_name.data());
-        DG_RANK0 err = nc_enddef( ncid);
         DG_RANK0 std::cout << "Computing "<<record.name<<"\n";
         record.function( transferH, var, g3d_out);
         //record.function( resultH, var, grid);
         //dg::blas2::symv( projectH, resultH, transferH);
-        dg::file::put_var_double( ncid, vecID, g3d_out, transferH);
-        DG_RANK0 err = nc_redef(ncid);
+        dg::file::put_var_double( ncid, writer.id( record.name), g3d_out, transferH);
     }
-    //create & output static 2d variables into file
+    //output static 2d variables into file
     for ( auto& record : feltor::diagnostics2d_static_list)
     {
-        int vecID;
-        DG_RANK0 err = nc_def_var( ncid, record.name.data(), NC_DOUBLE, 2,
-            &dim_ids[2], &vecID);
-        DG_RANK0 err = nc_put_att_text( ncid, vecID,
-            "long_name", record.long_name.size(), record.long_name.data());
-        DG_RANK0 err = nc_enddef( ncid);
         DG_RANK0 std::cout << "Computing2d "<<record.name<<"\n";
         //record.function( transferH, var, g3d_out); //ATTENTION: This does not work because feltor internal varialbes return full grid functions
         record.function( resultH, var, grid);
         dg::blas2::symv( projectH, resultH, transferH);
-        if(write2d)dg::file::put_var_double( ncid, vecID, *g2d_out_ptr, transferH);
-        DG_RANK0 err = nc_redef(ncid);
+        if(write2d)dg::file::put_var_double( ncid, writer.id( record.name), *g2d_out_ptr, transferH);
     }
-
-    //Create field IDs
-    for( auto& record : feltor::diagnostics3d_list)
-    {
-        std::string name = record.name;
-        std::string long_name = record.long_name;
-        id4d[name] = 0;//creates a new id4d entry for all processes
-        DG_RANK0 err = nc_def_var( ncid, name.data(), NC_DOUBLE, 4, dim_ids,
-            &id4d.at(name));
-        DG_RANK0 err = nc_put_att_text( ncid, id4d.at(name), "long_name", long_name.size(),
-            long_name.data());
-    }
-    for( auto& record : feltor::restart3d_list)
-    {
-        std::string name = record.name;
-        std::string long_name = record.long_name;
-        restart_ids[name] = 0;//creates a new entry for all processes
-        DG_RANK0 err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, restart_dim_ids,
-            &restart_ids.at(name));
-        DG_RANK0 err = nc_put_att_text( ncid, restart_ids.at(name), "long_name", long_name.size(),
-            long_name.data());
-    }
-    for( auto& record : feltor::diagnostics2d_list)
-    {
-        std::string name = record.name + "_ta2d";
-        std::string long_name = record.long_name + " (Toroidal average)";
-        id3d[name] = 0;//creates a new id3d entry for all processes
-        DG_RANK0 err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
-            &id3d.at(name));
-        DG_RANK0 err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
-            long_name.data());
-
-        name = record.name + "_2d";
-        long_name = record.long_name + " (Evaluated on phi = 0 plane)";
-        id3d[name] = 0;
-        DG_RANK0 err = nc_def_var( ncid, name.data(), NC_DOUBLE, 3, dim_ids3d,
-            &id3d.at(name));
-        DG_RANK0 err = nc_put_att_text( ncid, id3d.at(name), "long_name", long_name.size(),
-            long_name.data());
-    }
-    DG_RANK0 err = nc_enddef(ncid);
     ///////////////////////////////////first output/////////////////////////
     DG_RANK0 std::cout << "First output ... \n";
     //first, update feltor (to get potential etc.)
@@ -365,15 +375,13 @@ int main( int argc, char* argv[])
     for( auto& record : feltor::diagnostics3d_list)
     {
         record.function( resultD, var);
-        dg::blas2::symv( projectD, resultD, transferD);
-        dg::assign( transferD, transferH);
-        dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
+        reducer( record.name).write( ncid, writer.id( record.name), start, resultD);
     }
     for( auto& record : feltor::restart3d_list)
     {
         record.function( resultD, var);
         dg::assign( resultD, resultH);
-        dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
+        dg::file::put_var_double( ncid, writer.id( record.name), grid, resultH);
     }
     for( auto& record : feltor::diagnostics2d_list)
     {
@@ -391,7 +399,7 @@ int main( int argc, char* argv[])
         tti.toc();
         DG_RANK0 std::cout<< name << " Computing average took "<<tti.diff()<<"\n";
         tti.tic();
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
         tti.toc();
         DG_RANK0 std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
         tti.tic();
@@ -401,7 +409,7 @@ int main( int argc, char* argv[])
         feltor::slice_vector3d( transferD, transferD2d, local_size2d);
         dg::assign( transferD2d, transferH2d);
         if( record.integral) time_integrals[name].init( time, transferH2d);
-        if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+        if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
         tti.toc();
         DG_RANK0 std::cout<< name << " 2d output took "<<tti.diff()<<"\n";
     }
@@ -459,6 +467,15 @@ int main( int argc, char* argv[])
                     return -1;
                 }
                 step++;
+                probes.buffer( time, {&feltor.density(0), &feltor.density(1),
+                    &feltor.velocity(0), &feltor.velocity(1),
+                    &feltor.potential(0), &feltor.induction()});
+                if( probes.full())
+                {
+                    DG_RANK0 err = nc_open(file_name.data(), NC_WRITE, &ncid);
+                    err = probes.flush( ncid);
+                    DG_RANK0 err = nc_close(ncid);
+                }
             }
             dg::Timer tti;
             tti.tic();
@@ -529,15 +546,13 @@ int main( int argc, char* argv[])
         for( auto& record : feltor::diagnostics3d_list)
         {
             record.function( resultD, var);
-            dg::blas2::symv( projectD, resultD, transferD);
-            dg::assign( transferD, transferH);
-            dg::file::put_vara_double( ncid, id4d.at(record.name), start, g3d_out, transferH);
+            reducer( record.name).write( ncid, writer.id( record.name), start, resultD);
         }
         for( auto& record : feltor::restart3d_list)
         {
             record.function( resultD, var);
             dg::assign( resultD, resultH);
-            dg::file::put_var_double( ncid, restart_ids.at(record.name), grid, resultH);
+            dg::file::put_var_double( ncid, writer.id( record.name), grid, resultH);
         }
         for( auto& record : feltor::diagnostics2d_list)
         {
@@ -546,12 +561,12 @@ int main( int argc, char* argv[])
                 std::string name = record.name+"_ta2d";
                 transferH2d = time_integrals.at(name).get_integral();
                 time_integrals.at(name).flush();
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
 
                 name = record.name+"_2d";
                 transferH2d = time_integrals.at(name).get_integral( );
                 time_integrals.at(name).flush( );
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
             }
             else // compute from scratch
             {
@@ -561,15 +576,16 @@ int main( int argc, char* argv[])
                 std::string name = record.name+"_ta2d";
                 dg::assign( transferD, transferH);
                 toroidal_average( transferH, transferH2d, false);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
 
                 // 2d data of plane varphi = 0
                 name = record.name+"_2d";
                 feltor::slice_vector3d( transferD, transferD2d, local_size2d);
                 dg::assign( transferD2d, transferH2d);
-                if(write2d) dg::file::put_vara_double( ncid, id3d.at(name), start, *g2d_out_ptr, transferH2d);
+                if(write2d) dg::file::put_vara_double( ncid, writer.id( name), start, *g2d_out_ptr, transferH2d);
             }
         }
+        err = probes.flush( ncid);
         DG_RANK0 err = nc_close(ncid);
         ti.toc();
         DG_RANK0 std::cout << "\n\t Time for output: "<<ti.diff()<<"s\n\n"<<std::flush;
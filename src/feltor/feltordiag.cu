@@ -9,6 +9,7 @@
 #include "dg/algorithm.h"
 #include "dg/geometries/geometries.h"
 #include "dg/file/file.h"
+#include "dg/file/mapped_reader.h"
 #include "feltordiag.h"
 
 int main( int argc, char* argv[])
@@ -46,30 +47,97 @@ int main( int argc, char* argv[])
         "electrons", "ions", "Ue", "Ui", "potential", "induction"
     };
 
-    //-----------------Create Netcdf output file with attributes----------//
-    int ncid_out;
-    err = nc_create(argv[argc-1],NC_NETCDF4|NC_NOCLOBBER, &ncid_out);
-
-    /// Set global attributes
-    std::map<std::string, std::string> att;
-    att["title"] = "Output file of feltor/src/feltor/feltordiag.cu";
-    att["Conventions"] = "CF-1.7";
-    ///Get local time and begin file history
+    //-----------------Create or reopen Netcdf output file----------//
+    auto get_att_text = [&err]( int ncid, const char* name)
+    {
+        size_t length;
+        err = nc_inq_attlen( ncid, NC_GLOBAL, name, &length);
+        std::string text(length, 'x');
+        err = nc_get_att_text( ncid, NC_GLOBAL, name, &text[0]);
+        return text;
+    };
+    ///Get local time and program-name + args for the file history
     auto ttt = std::time(nullptr);
     auto tm = *std::localtime(&ttt);
     std::ostringstream oss;
     ///time string  + program-name + args
     oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
     for( int i=0; i<argc; i++) oss << " "<<argv[i];
-    att["history"] = oss.str();
-    att["comment"] = "Find more info in feltor/src/feltor.tex";
-    att["source"] = "FELTOR";
-    att["references"] = "https://github.com/feltor-dev/feltor";
-    att["inputfile"] = inputfile;
-    att["geomfile"] = geomfile;
-    for( auto pair : att)
-        err = nc_put_att_text( ncid_out, NC_GLOBAL,
-            pair.first.data(), pair.second.size(), pair.second.data());
+
+    int ncid_out;
+    // An existing output file is appended to: only time steps that are not
+    // yet recorded in the processed_files and processed_steps attributes are computed
+    bool append = ( nc_open( argv[argc-1], NC_WRITE, &ncid_out) == NC_NOERR);
+    std::vector<int> processed_steps( argc-2, 0);
+    if( append)
+    {
+        std::cout << "Output file exists! Append new time steps ...\n";
+        if( get_att_text( ncid_out, "inputfile") != inputfile ||
+            get_att_text( ncid_out, "geomfile") != geomfile)
+        {
+            std::cerr << "The inputfile or geomfile of "<<argv[argc-1]<<" do not match "<<argv[1]<<"! Exit\n";
+            return -1;
+        }
+        size_t length;
+        if( nc_inq_attlen( ncid_out, NC_GLOBAL, "processed_files", &length) != NC_NOERR)
+        {
+            std::cerr << "The output file "<<argv[argc-1]<<" has no record of processed files and cannot be appended to! Exit\n";
+            return -1;
+        }
+        std::stringstream files( get_att_text( ncid_out, "processed_files"));
+        std::string file;
+        std::vector<std::string> processed_files;
+        while( std::getline( files, file))
+            processed_files.push_back( file);
+        if( processed_files.size() > processed_steps.size())
+        {
+            std::cerr << "The output file has already processed "<<processed_files.size()<<" input files but only "<<processed_steps.size()<<" are given! Exit\n";
+            return -1;
+        }
+        for( unsigned i=0; i<processed_files.size(); i++)
+            if( processed_files[i] != argv[i+1])
+            {
+                std::cerr << "Input file "<<argv[i+1]<<" does not match processed file "<<processed_files[i]<<"! Exit\n";
+                return -1;
+            }
+        if( !processed_files.empty())
+            err = nc_get_att_int( ncid_out, NC_GLOBAL, "processed_steps", processed_steps.data());
+        std::string history = get_att_text( ncid_out, "history") + "\n" + oss.str();
+        err = nc_put_att_text( ncid_out, NC_GLOBAL, "history", history.size(), history.data());
+    }
+    else
+    {
+        err = nc_create(argv[argc-1],NC_NETCDF4|NC_NOCLOBBER, &ncid_out);
+
+        /// Set global attributes
+        std::map<std::string, std::string> att;
+        att["title"] = "Output file of feltor/src/feltor/feltordiag.cu";
+        att["Conventions"] = "CF-1.7";
+        att["history"] = oss.str();
+        att["comment"] = "Find more info in feltor/src/feltor.tex";
+        att["source"] = "FELTOR";
+        att["references"] = "https://github.com/feltor-dev/feltor";
+        att["inputfile"] = inputfile;
+        att["geomfile"] = geomfile;
+        for( auto pair : att)
+            err = nc_put_att_text( ncid_out, NC_GLOBAL,
+                pair.first.data(), pair.second.size(), pair.second.data());
+    }
+    //record which time steps of which input files are contained in the output file
+    //(only up to the last file with at least one processed step, so that
+    //trailing files that were never processed may be left out when appending)
+    auto put_processed = [&]( )
+    {
+        unsigned num = 0;
+        for( unsigned k=0; k<processed_steps.size(); k++)
+            if( processed_steps[k] > 0)
+                num = k+1;
+        std::string files;
+        for( unsigned k=0; k<num; k++)
+            files += std::string( argv[k+1]) + "\n";
+        err = nc_put_att_text( ncid_out, NC_GLOBAL, "processed_files", files.size(), files.data());
+        err = nc_put_att_int( ncid_out, NC_GLOBAL, "processed_steps", NC_INT, num, processed_steps.data());
+    };
 
     //-------------------Construct grids-------------------------------------//
 
@@ -108,89 +176,119 @@ int main( int argc, char* argv[])
 
     //std::cout << "Type X-point grid resolution (n(3), Npsi(32), Neta(640)) Must be divisible by 8\n";
     //we use so many Neta so that we get close to the X-point
-    std::cout << "Using default X-point grid resolution (n(3), Npsi(64), Neta(640))\n";
     unsigned npsi = 3, Npsi = 64, Neta = 640;//set number of psivalues (NPsi % 8 == 0)
-    //std::cin >> npsi >> Npsi >> Neta;
-    std::cout << "You typed "<<npsi<<" x "<<Npsi<<" x "<<Neta<<"\n";
-    std::cout << "Generate X-point flux-aligned grid!\n";
-    double R_X = gp.R_0-1.1*gp.triangularity*gp.a;
-    double Z_X = -1.1*gp.elongation*gp.a;
-    dg::geo::findXpoint( mag.get_psip(), R_X, Z_X);
-    dg::geo::CylindricalSymmTensorLvl1 monitor_chi = dg::geo::make_Xconst_monitor( mag.get_psip(), R_X, Z_X) ;
     double R_O = gp.R_0, Z_O = 0;
     dg::geo::findOpoint( mag.get_psip(), R_O, Z_O);
     double psipO = mag.psip()(R_O, Z_O);
-
-    dg::geo::SeparatrixOrthogonal generator(mag.get_psip(), monitor_chi, psipO, R_X, Z_X, mag.R0(), 0, 0, false);
     double fx_0 = 1./8.;
-    double psipmax = dg::blas1::reduce( psipog2d, 0. ,thrust::maximum<double>()); //DEPENDS ON GRID RESOLUTION!!
-    std::cout << "psi max is            "<<psipmax<<"\n";
-    psipmax = -fx_0/(1.-fx_0)*psipO;
-    std::cout << "psi max in g1d_out is "<<psipmax<<"\n";
-    dg::geo::CurvilinearGridX2d gridX2d( generator, fx_0, 0., npsi, Npsi, Neta, dg::DIR_NEU, dg::NEU);
-    std::cout << "psi max in gridX2d is "<<gridX2d.x1()<<"\n";
-    std::cout << "DONE!\n";
+    double psipmax = -fx_0/(1.-fx_0)*psipO;
+    dg::Grid2d gX2d( 0., 1., 0., 1., npsi, Npsi, Neta, dg::DIR_NEU, dg::NEU);
+    std::vector<dg::HVec > coordsX;
+    dg::HVec volX2d, gradZetaX, dvdpsip;
+    if( !append)
+    {
+        std::cout << "Using default X-point grid resolution (n(3), Npsi(64), Neta(640))\n";
+        //std::cin >> npsi >> Npsi >> Neta;
+        std::cout << "You typed "<<npsi<<" x "<<Npsi<<" x "<<Neta<<"\n";
+        std::cout << "Generate X-point flux-aligned grid!\n";
+        double R_X = gp.R_0-1.1*gp.triangularity*gp.a;
+        double Z_X = -1.1*gp.elongation*gp.a;
+        dg::geo::findXpoint( mag.get_psip(), R_X, Z_X);
+        dg::geo::CylindricalSymmTensorLvl1 monitor_chi = dg::geo::make_Xconst_monitor( mag.get_psip(), R_X, Z_X) ;
+
+        dg::geo::SeparatrixOrthogonal generator(mag.get_psip(), monitor_chi, psipO, R_X, Z_X, mag.R0(), 0, 0, false);
+        double psipmaxg2d = dg::blas1::reduce( psipog2d, 0. ,thrust::maximum<double>()); //DEPENDS ON GRID RESOLUTION!!
+        std::cout << "psi max is            "<<psipmaxg2d<<"\n";
+        std::cout << "psi max in g1d_out is "<<psipmax<<"\n";
+        dg::geo::CurvilinearGridX2d gridX2d( generator, fx_0, 0., npsi, Npsi, Neta, dg::DIR_NEU, dg::NEU);
+        std::cout << "psi max in gridX2d is "<<gridX2d.x1()<<"\n";
+        std::cout << "DONE!\n";
+        gX2d = gridX2d.grid();
+        //metric and map
+        dg::SparseTensor<dg::HVec> metricX = gridX2d.metric();
+        coordsX = gridX2d.map();
+        volX2d = dg::tensor::volume2d( metricX);
+        dg::blas1::pointwiseDot( coordsX[0], volX2d, volX2d); //R\sqrt{g}
+        gradZetaX = metricX.value(0,0);
+        dg::blas1::transform( gradZetaX, gradZetaX, dg::SQRT<double>());
+        dg::blas1::pointwiseDot( volX2d, gradZetaX, gradZetaX); //R\sqrt{g}|\nabla\zeta|
+    }
+    else
+    {
+        //reuse the X-point grid of the previous run
+        std::cout << "Read X-point flux-aligned grid from output file!\n";
+        int varID;
+        double bounds[4];
+        coordsX.assign( 2, dg::evaluate( dg::zero, gX2d));
+        volX2d = coordsX[0];
+        dvdpsip = dg::HVec( npsi*Npsi);
+        err = nc_inq_varid( ncid_out, "xc_X", &varID);
+        err = nc_get_var_double( ncid_out, varID, coordsX[0].data());
+        err = nc_inq_varid( ncid_out, "yc_X", &varID);
+        err = nc_get_var_double( ncid_out, varID, coordsX[1].data());
+        err = nc_inq_varid( ncid_out, "vol_X", &varID);
+        err = nc_get_var_double( ncid_out, varID, volX2d.data());
+        err = nc_get_att_double( ncid_out, varID, "bounds", bounds);
+        gX2d = dg::Grid2d( bounds[0], bounds[1], bounds[2], bounds[3], npsi, Npsi, Neta, dg::DIR_NEU, dg::NEU);
+        err = nc_inq_varid( ncid_out, "dvdpsi", &varID);
+        err = nc_get_var_double( ncid_out, varID, dvdpsip.data());
+    }
     //Create 1d grid
     dg::Grid1d g1d_out(psipO, psipmax, npsi, Npsi, dg::DIR_NEU); //inner value is always 0
     std::cout << "Cell separatrix boundary is "<<Npsi*(1.-fx_0)*g1d_out.h()+g1d_out.x0()<<"\n";
-    const double f0 = ( gridX2d.x1() - gridX2d.x0() ) / ( psipmax - psipO );
+    const double f0 = ( gX2d.x1() - gX2d.x0() ) / ( psipmax - psipO );
     dg::HVec t1d = dg::evaluate( dg::zero, g1d_out), fsa1d( t1d);
     dg::HVec transfer1d = dg::evaluate(dg::zero,g1d_out);
+    dg::HVec transferH2dX(volX2d);
+    dg::Average<dg::HVec > poloidal_average( gX2d, dg::coo2d::y);
 
     /// ------------------- Compute 1d flux labels ---------------------//
 
     std::vector<std::tuple<std::string, dg::HVec, std::string> > map1d;
-    /// Compute flux volume label
-    dg::Average<dg::HVec > poloidal_average( gridX2d.grid(), dg::coo2d::y);
-    dg::HVec dvdpsip;
-    //metric and map
-    dg::SparseTensor<dg::HVec> metricX = gridX2d.metric();
-    std::vector<dg::HVec > coordsX = gridX2d.map();
-    dg::HVec volX2d = dg::tensor::volume2d( metricX);
-    dg::HVec transferH2dX(volX2d);
-    dg::blas1::pointwiseDot( coordsX[0], volX2d, volX2d); //R\sqrt{g}
-    poloidal_average( volX2d, dvdpsip, false);
-    dg::blas1::scal( dvdpsip, 4.*M_PI*M_PI*f0);
-    map1d.emplace_back( "dvdpsi", dvdpsip,
-        "Derivative of flux volume with respect to flux label psi");
-    dg::HVec X_psi_vol = dg::integrate( dvdpsip, g1d_out);
-    map1d.emplace_back( "psi_vol", X_psi_vol,
-        "Flux volume evaluated with X-point grid");
-
-    /// Compute flux area label
-    dg::HVec gradZetaX = metricX.value(0,0), X_psi_area;
-    dg::blas1::transform( gradZetaX, gradZetaX, dg::SQRT<double>());
-    dg::blas1::pointwiseDot( volX2d, gradZetaX, gradZetaX); //R\sqrt{g}|\nabla\zeta|
-    poloidal_average( gradZetaX, X_psi_area, false);
-    dg::blas1::scal( X_psi_area, 4.*M_PI*M_PI);
-    map1d.emplace_back( "psi_area", X_psi_area,
-        "Flux area evaluated with X-point grid");
-
-    dg::HVec rho = dg::evaluate( dg::cooX1d, g1d_out);
-    dg::blas1::axpby( -1./psipO, rho, +1., 1., rho); //transform psi to rho
-    map1d.emplace_back("rho", rho,
-        "Alternative flux label rho = 1-psi/psimin");
-    dg::blas1::transform( rho, rho, dg::SQRT<double>());
-    map1d.emplace_back("rho_p", rho,
-        "Alternative flux label rho_p = sqrt(1-psi/psimin)");
-    dg::geo::SafetyFactor qprof( mag);
-    dg::HVec qprofile = dg::evaluate( qprof, g1d_out);
-    map1d.emplace_back("q-profile", qprofile,
-        "q-profile (Safety factor) using direct integration");
-    map1d.emplace_back("psi_psi",    dg::evaluate( dg::cooX1d, g1d_out),
-        "Poloidal flux label psi (same as coordinate)");
-    dg::HVec psit = dg::integrate( qprofile, g1d_out);
-    map1d.emplace_back("psit1d", psit,
-        "Toroidal flux label psi_t integrated using q-profile");
-    //we need to avoid integrating >=0 for total psi_t
-    dg::Grid1d g1d_fine(psipO<0. ? psipO : 0., psipO<0. ? 0. : psipO, npsi ,Npsi,dg::DIR_NEU);
-    qprofile = dg::evaluate( qprof, g1d_fine);
-    dg::HVec w1d = dg::create::weights( g1d_fine);
-    double psit_tot = dg::blas1::dot( w1d, qprofile);
-    dg::blas1::scal ( psit, 1./psit_tot);
-    dg::blas1::transform( psit, psit, dg::SQRT<double>());
-    map1d.emplace_back("rho_t", psit,
-        "Toroidal flux label rho_t = sqrt( psit/psit_tot)");
+    if( !append)
+    {
+        /// Compute flux volume label
+        poloidal_average( volX2d, dvdpsip, false);
+        dg::blas1::scal( dvdpsip, 4.*M_PI*M_PI*f0);
+        map1d.emplace_back( "dvdpsi", dvdpsip,
+            "Derivative of flux volume with respect to flux label psi");
+        dg::HVec X_psi_vol = dg::integrate( dvdpsip, g1d_out);
+        map1d.emplace_back( "psi_vol", X_psi_vol,
+            "Flux volume evaluated with X-point grid");
+
+        /// Compute flux area label
+        dg::HVec X_psi_area;
+        poloidal_average( gradZetaX, X_psi_area, false);
+        dg::blas1::scal( X_psi_area, 4.*M_PI*M_PI);
+        map1d.emplace_back( "psi_area", X_psi_area,
+            "Flux area evaluated with X-point grid");
+
+        dg::HVec rho = dg::evaluate( dg::cooX1d, g1d_out);
+        dg::blas1::axpby( -1./psipO, rho, +1., 1., rho); //transform psi to rho
+        map1d.emplace_back("rho", rho,
+            "Alternative flux label rho = 1-psi/psimin");
+        dg::blas1::transform( rho, rho, dg::SQRT<double>());
+        map1d.emplace_back("rho_p", rho,
+            "Alternative flux label rho_p = sqrt(1-psi/psimin)");
+        dg::geo::SafetyFactor qprof( mag);
+        dg::HVec qprofile = dg::evaluate( qprof, g1d_out);
+        map1d.emplace_back("q-profile", qprofile,
+            "q-profile (Safety factor) using direct integration");
+        map1d.emplace_back("psi_psi",    dg::evaluate( dg::cooX1d, g1d_out),
+            "Poloidal flux label psi (same as coordinate)");
+        dg::HVec psit = dg::integrate( qprofile, g1d_out);
+        map1d.emplace_back("psit1d", psit,
+            "Toroidal flux label psi_t integrated using q-profile");
+        //we need to avoid integrating >=0 for total psi_t
+        dg::Grid1d g1d_fine(psipO<0. ? psipO : 0., psipO<0. ? 0. : psipO, npsi ,Npsi,dg::DIR_NEU);
+        qprofile = dg::evaluate( qprof, g1d_fine);
+        dg::HVec w1d = dg::create::weights( g1d_fine);
+        double psit_tot = dg::blas1::dot( w1d, qprofile);
+        dg::blas1::scal ( psit, 1./psit_tot);
+        dg::blas1::transform( psit, psit, dg::SQRT<double>());
+        map1d.emplace_back("rho_t", psit,
+            "Toroidal flux label rho_t = sqrt( psit/psit_tot)");
+    }
 
     // interpolate from 2d grid to X-point points
     dg::IHMatrix grid2gridX2d  = dg::create::interpolation(
@@ -206,30 +304,55 @@ int main( int argc, char* argv[])
 
     // define 2d and 1d and 0d dimensions and variables
     int dim_ids[3], tvarID;
-    err = dg::file::define_dimensions( ncid_out, dim_ids, &tvarID, g2d_out);
-    //Write long description
-    std::string long_name = "Time at which 2d fields are written";
-    err = nc_put_att_text( ncid_out, tvarID, "long_name", long_name.size(),
-            long_name.data());
-    int dim_ids1d[2] = {dim_ids[0], 0}; //time,  psi
-    err = dg::file::define_dimension( ncid_out, &dim_ids1d[1], g1d_out, {"psi"} );
-    std::map<std::string, int> id0d, id1d, id2d;
-
-    size_t count1d[2] = {1, g1d_out.n()*g1d_out.N()};
+    int dim_ids1d[2] = {0, 0}; //time,  psi
+    std::string long_name;
+    // all variables are defined at once, their IDs are cached and the 0d and
+    // 1d time series are buffered and written in blocks
+    dg::file::Writer writer;
+    if( !append)
+    {
+        err = dg::file::define_dimensions( ncid_out, dim_ids, &tvarID, g2d_out);
+        //Write long description
+        long_name = "Time at which 2d fields are written";
+        err = nc_put_att_text( ncid_out, tvarID, "long_name", long_name.size(),
+                long_name.data());
+        dim_ids1d[0] = dim_ids[0];
+        err = dg::file::define_dimension( ncid_out, &dim_ids1d[1], g1d_out, {"psi"} );
+    }
+    err = writer.inquire( ncid_out, "time");
+    // in append mode the variables exist already
+    auto define_var = [&]( const std::string& name, const std::string& description,
+        std::vector<int> dims)
+    {
+        if( append)
+            err = writer.inquire( ncid_out, name);
+        else
+            writer.def_var( name, dims, description);
+    };
+
     size_t count2d[3] = {1, g2d_out.n()*g2d_out.Ny(), g2d_out.n()*g2d_out.Nx()};
     size_t start2d[3] = {0, 0, 0};
 
-    //write 1d static vectors (psi, q-profile, ...) into file
+    //1d static vectors (psi, q-profile, ...)
     for( auto tp : map1d)
+        writer.def_var( std::get<0>(tp), {dim_ids1d[1]}, std::get<2>(tp));
+    //X-point grid so that appending runs do not need to generate it again
+    std::vector<std::tuple<std::string, const dg::HVec*, std::string> > mapX;
+    if( !append)
     {
-        int vid;
-        err = nc_def_var( ncid_out, std::get<0>(tp).data(), NC_DOUBLE, 1,
-            &dim_ids1d[1], &vid);
-        err = nc_put_att_text( ncid_out, vid, "long_name",
-            std::get<2>(tp).size(), std::get<2>(tp).data());
-        err = nc_enddef( ncid_out);
-        err = nc_put_var_double( ncid_out, vid, std::get<1>(tp).data());
-        err = nc_redef(ncid_out);
+        int dim_idsX[2];
+        err = nc_def_dim( ncid_out, "etaX", gX2d.n()*gX2d.Ny(), &dim_idsX[0]);
+        err = nc_def_dim( ncid_out, "zetaX", gX2d.n()*gX2d.Nx(), &dim_idsX[1]);
+        mapX = {
+            {"xc_X", &coordsX[0], "R-coordinate of X-point grid"},
+            {"yc_X", &coordsX[1], "Z-coordinate of X-point grid"},
+            {"vol_X", &volX2d, "Volume form R sqrt(g) of X-point grid"}
+        };
+        for( auto tp : mapX)
+            writer.def_var( std::get<0>(tp), {dim_idsX[0], dim_idsX[1]},
+                std::get<2>(tp));
+        writer.def_att( "vol_X", "bounds", std::vector<double>{
+            gX2d.x0(), gX2d.x1(), gX2d.y0(), gX2d.y1()});
     }
 
     for( auto& record : feltor::diagnostics2d_list)
@@ -239,67 +362,53 @@ int main( int argc, char* argv[])
             record_name[1] = 'v';
         std::string name = record_name + "_fluc2d";
         long_name = record.long_name + " (Fluctuations wrt fsa on phi = 0 plane.)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 3, dim_ids,
-            &id2d[name]);
-        err = nc_put_att_text( ncid_out, id2d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids[0], dim_ids[1], dim_ids[2]});
 
         name = record_name + "_cta2d";
         long_name = record.long_name + " (Convoluted toroidal average on 2d plane.)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 3, dim_ids,
-            &id2d[name]);
-        err = nc_put_att_text( ncid_out, id2d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids[0], dim_ids[1], dim_ids[2]});
 
         name = record_name + "_fsa2d";
         long_name = record.long_name + " (Flux surface average interpolated to 2d plane.)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 3, dim_ids,
-            &id2d[name]);
-        err = nc_put_att_text( ncid_out, id2d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids[0], dim_ids[1], dim_ids[2]});
 
         name = record_name + "_fsa";
         long_name = record.long_name + " (Flux surface average.)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 2, dim_ids1d,
-            &id1d[name]);
-        err = nc_put_att_text( ncid_out, id1d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids1d[0], dim_ids1d[1]});
         name = record_name + "_std_fsa";
         long_name = record.long_name + " (Flux surface average standard deviation on outboard midplane.)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 2, dim_ids1d,
-            &id1d[name]);
-        err = nc_put_att_text( ncid_out, id1d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids1d[0], dim_ids1d[1]});
 
         name = record_name + "_ifs";
         long_name = record.long_name + " (wrt. vol integrated flux surface average)";
         if( record_name[0] == 'j')
             long_name = record.long_name + " (wrt. vol derivative of the flux surface average)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 2, dim_ids1d,
-            &id1d[name]);
-        err = nc_put_att_text( ncid_out, id1d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids1d[0], dim_ids1d[1]});
 
         name = record_name + "_ifs_lcfs";
         long_name = record.long_name + " (wrt. vol integrated flux surface average evaluated on last closed flux surface)";
         if( record_name[0] == 'j')
             long_name = record.long_name + " (flux surface average evaluated on the last closed flux surface)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 1, dim_ids,
-            &id0d[name]);
-        err = nc_put_att_text( ncid_out, id0d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids[0]});
 
         name = record_name + "_ifs_norm";
         long_name = record.long_name + " (wrt. vol integrated square flux surface average from 0 to lcfs)";
         if( record_name[0] == 'j')
             long_name = record.long_name + " (wrt. vol integrated square derivative of the flux surface average from 0 to lcfs)";
-        err = nc_def_var( ncid_out, name.data(), NC_DOUBLE, 1, dim_ids,
-            &id0d[name]);
-        err = nc_put_att_text( ncid_out, id0d[name], "long_name", long_name.size(),
-            long_name.data());
+        define_var( name, long_name, {dim_ids[0]});
     }
+    err = writer.define( ncid_out);
+    for( auto tp : map1d)
+        err = nc_put_var_double( ncid_out, writer.id( std::get<0>(tp)),
+            std::get<1>(tp).data());
+    for( auto tp : mapX)
+        err = nc_put_var_double( ncid_out, writer.id( std::get<0>(tp)),
+            std::get<1>(tp)->data());
     /////////////////////////////////////////////////////////////////////////
-    size_t counter = 0;
+    size_t counter = 0; //number of time steps in output file
+    for( unsigned k=0; k<processed_steps.size(); k++)
+        counter += ( k > 0 && processed_steps[k] > 0) ? processed_steps[k]-1 : processed_steps[k];
+    put_processed();
     int ncid;
     for( int j=1; j<argc-1; j++)
     {
@@ -316,47 +425,48 @@ int main( int argc, char* argv[])
             std::cerr << "Continue with next file\n";
             continue;
         }
+        // read the 2d fields without copies from the memory mapped file
+        dg::file::MappedReader reader( argv[j], true);
         err = nc_inq_unlimdim( ncid, &timeID); //Attention: Finds first unlimited dim, which hopefully is time and not energy_time
         err = nc_inq_dimlen( ncid, timeID, &steps);
         //steps = 3;
-        for( unsigned i=0; i<steps; i++)//timestepping
+        // look up once per file which of the 2d fields exist
+        std::map<std::string, bool> available;
+        for( auto& record : feltor::diagnostics2d_list)
+            for( std::string name : {record.name+"_ta2d", record.name+"_2d"})
+            {
+                int dataID = 0;
+                available[name] = ( nc_inq_varid( ncid, name.data(), &dataID) == NC_NOERR);
+                if( !available[name])
+                    std::cerr << "Variable "<<name<<" not found in "<<argv[j]<<"! Writing zeros ... \n";
+            }
+        if( processed_steps[j-1] > 0)
+            std::cout << "Skip "<<processed_steps[j-1]<<" processed time steps\n";
+        for( unsigned i=processed_steps[j-1]; i<steps; i++)//timestepping
         {
             if( j > 1 && i == 0)
+            {
+                processed_steps[j-1] = 1;
                 continue; // else we duplicate the first timestep
+            }
             start2d[0] = i;
             size_t start2d_out[3] = {counter, 0,0};
-            size_t start1d_out[2] = {counter, 0};
             // read and write time
             double time=0.;
             err = nc_get_vara_double( ncid, timeID, start2d, count2d, &time);
             std::cout << counter << " Timestep = " << i <<"/"<<steps-1 << "  time = " << time << std::endl;
             counter++;
-            err = nc_put_vara_double( ncid_out, tvarID, start2d_out, count2d, &time);
+            writer.stage( "time", start2d_out[0], time);
             for( auto& record : feltor::diagnostics2d_list)
             {
                 std::string record_name = record.name;
                 if( record_name[0] == 'j')
                     record_name[1] = 'v';
                 //1. Read toroidal average
-                int dataID =0;
-                bool available = true;
-                try{
-                    err = nc_inq_varid(ncid, (record.name+"_ta2d").data(), &dataID);
-                } catch ( dg::file::NC_Error& error)
+                if( available.at( record.name+"_ta2d"))
                 {
-                    if(  i == 0)
-                    {
-                        std::cerr << error.what() <<std::endl;
-                        std::cerr << "Offending variable is "<<record.name+"_ta2d\n";
-                        std::cerr << "Writing zeros ... \n";
-                    }
-                    available = false;
-                }
-                if( available)
-                {
-                    err = nc_get_vara_double( ncid, dataID,
-                        start2d, count2d, transferH2d.data());
-                    dg::DVec transferD2d = transferH2d;
+                    dg::View<const dg::HVec> ta2d = reader.frame( record.name+"_ta2d", i);
+                    dg::DVec transferD2d( ta2d.begin(), ta2d.end());
                     fieldaligned.integrate_between_coarse_grid( g3d, transferD2d, transferD2d);
                     transferH2d = transferD2d;
                     t2d_mp = transferH2d; //save toroidal average
@@ -379,36 +489,21 @@ int main( int argc, char* argv[])
                     dg::blas1::scal( transferH2d, 0.);
                     dg::blas1::scal( t2d_mp, 0.);
                 }
-                err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_fsa"),
-                    start1d_out, count1d, fsa1d.data());
-                err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fsa2d"),
+                writer.stage( record_name+"_fsa", start2d_out[0], fsa1d);
+                err = nc_put_vara_double( ncid_out, writer.id( record_name+"_fsa2d"),
                     start2d_out, count2d, transferH2d.data() );
                 if( record_name[0] == 'j')
                     dg::blas1::pointwiseDot( t2d_mp, dvdpsip2d, t2d_mp );//make it jv
-                err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_cta2d"),
+                err = nc_put_vara_double( ncid_out, writer.id( record_name+"_cta2d"),
                     start2d_out, count2d, t2d_mp.data() );
                 //4. Read 2d variable and compute fluctuations
-                available = true;
-                try{
-                    err = nc_inq_varid(ncid, (record.name+"_2d").data(), &dataID);
-                } catch ( dg::file::NC_Error& error)
-                {
-                    if(  i == 0)
-                    {
-                        std::cerr << error.what() <<std::endl;
-                        std::cerr << "Offending variable is "<<record.name+"_2d\n";
-                        std::cerr << "Writing zeros ... \n";
-                    }
-                    available = false;
-                }
-                if( available)
+                if( available.at( record.name+"_2d"))
                 {
-                    err = nc_get_vara_double( ncid, dataID, start2d, count2d,
-                        t2d_mp.data());
+                    dg::blas1::copy( reader.frame( record.name+"_2d", i), t2d_mp);
                     if( record_name[0] == 'j')
                         dg::blas1::pointwiseDot( t2d_mp, dvdpsip2d, t2d_mp );
                     dg::blas1::axpby( 1.0, t2d_mp, -1.0, transferH2d);
-                    err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fluc2d"),
+                    err = nc_put_vara_double( ncid_out, writer.id( record_name+"_fluc2d"),
                         start2d_out, count2d, transferH2d.data() );
 
                     //5. flux surface integral/derivative
@@ -427,11 +522,9 @@ int main( int argc, char* argv[])
 
                         result = dg::interpolate( dg::xspace, transfer1d, -1e-12, g1d_out); //make sure to take inner cell for interpolation
                     }
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_ifs"),
-                        start1d_out, count1d, transfer1d.data());
+                    writer.stage( record_name+"_ifs", start2d_out[0], transfer1d);
                     //flux surface integral/derivative on last closed flux surface
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_lcfs"),
-                        start2d_out, count2d, &result );
+                    writer.stage( record_name+"_ifs_lcfs", start2d_out[0], result);
                     //6. Compute norm of time-integral terms to get relative importance
                     if( record_name[0] == 'j') //j indicates a flux
                     {
@@ -452,8 +545,7 @@ int main( int argc, char* argv[])
                         result = dg::interpolate( dg::xspace, transfer1d, -1e-12, g1d_out);
                         result = sqrt(result);
                     }
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_norm"),
-                        start2d_out, count2d, &result );
+                    writer.stage( record_name+"_ifs_norm", start2d_out[0], result);
                     //7. Compute midplane fluctuation amplitudes
                     dg::blas1::pointwiseDot( transferH2d, transferH2d, transferH2d);
                     dg::blas2::symv( grid2gridX2d, transferH2d, transferH2dX); //interpolate onto X-point grid
@@ -462,30 +554,32 @@ int main( int argc, char* argv[])
                     dg::blas1::scal( t1d, 4*M_PI*M_PI*f0); //
                     dg::blas1::pointwiseDivide( t1d, dvdpsip, fsa1d );
                     dg::blas1::transform ( fsa1d, fsa1d, dg::SQRT<double>() );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_std_fsa"),
-                        start1d_out, count1d, fsa1d.data());
+                    writer.stage( record_name+"_std_fsa", start2d_out[0], fsa1d);
                 }
                 else
                 {
                     dg::blas1::scal( transferH2d, 0.);
                     dg::blas1::scal( transfer1d, 0.);
                     double result = 0.;
-                    err = nc_put_vara_double( ncid_out, id2d.at(record_name+"_fluc2d"),
+                    err = nc_put_vara_double( ncid_out, writer.id( record_name+"_fluc2d"),
                         start2d_out, count2d, transferH2d.data() );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_ifs"),
-                        start1d_out, count1d, transfer1d.data());
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_lcfs"),
-                        start2d_out, count2d, &result );
-                    err = nc_put_vara_double( ncid_out, id0d.at(record_name+"_ifs_norm"),
-                        start2d_out, count2d, &result );
-                    err = nc_put_vara_double( ncid_out, id1d.at(record_name+"_std_fsa"),
-                        start1d_out, count1d, transfer1d.data());
+                    writer.stage( record_name+"_ifs", start2d_out[0], transfer1d);
+                    writer.stage( record_name+"_ifs_lcfs", start2d_out[0], result);
+                    writer.stage( record_name+"_ifs_norm", start2d_out[0], result);
+                    writer.stage( record_name+"_std_fsa", start2d_out[0], transfer1d);
                 }
 
             }
-
-
+            processed_steps[j-1] = i+1;
+            //the processed steps are recorded only once the time series are written
+            if( writer.buffered() >= 100)
+            {
+                err = writer.flush( ncid_out);
+                put_processed();
+            }
         } //end timestepping
+        err = writer.flush( ncid_out);
+        put_processed();
         err = nc_close(ncid);
     }
     err = nc_close(ncid_out);
@@ -110,9 +110,9 @@ struct RadialEnergyFlux{
     double m_tau, m_mu, m_z;
 };
 
-template<class Container>
-void dot( const std::array<Container, 3>& v,
-          const std::array<Container, 3>& w,
+template<class Container0, class Container1, class Container>
+void dot( const std::array<Container0, 3>& v,
+          const std::array<Container1, 3>& w,
           Container& result)
 {
     dg::blas1::evaluate( result, dg::equals(), dg::PairSum(),
@@ -160,16 +160,25 @@ struct Jacobian{
                     b_2*( d0P*d1S-d1P*d0S);
     }
 };
-template<class Container>
+template<class Container0, class Container1, class Container2, class Container>
 void jacobian(
-          const std::array<Container, 3>& a,
-          const std::array<Container, 3>& b,
-          const std::array<Container, 3>& c,
+          const std::array<Container0, 3>& a,
+          const std::array<Container1, 3>& b,
+          const std::array<Container2, 3>& c,
           Container& result)
 {
     dg::blas1::evaluate( result, dg::equals(), Jacobian(),
         a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2]);
 }
+//expand a plane broadcast (e.g. the magnetic field) to a full 3d vector
+template<class Broadcast>
+void copy_broadcast( const Broadcast& in, dg::x::HVec& result,
+    const dg::x::CylindricalGrid3d& grid)
+{
+    dg::x::DVec temp = dg::construct<dg::x::DVec>( dg::evaluate( dg::zero, grid));
+    dg::blas1::copy( in, temp);
+    dg::assign( temp, result);
+}
 }//namespace routines
 
 //From here on, we use the typedefs to ease the notation
@@ -328,52 +337,52 @@ std::vector<Record_static> diagnostics2d_static_list = {
     },
     { "Divb", "The divergence of the magnetic unit vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid ){
-            result = v.f.divb();
+            routines::copy_broadcast( v.f.divb(), result, grid);
         }
     },
     { "InvB", "Inverse of Bmodule",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid ){
-            result = v.f.binv();
+            routines::copy_broadcast( v.f.binv(), result, grid);
         }
     },
     { "CurvatureKappaR", "R-component of the Kappa B curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid ){
-            result = v.f.curvKappa()[0];
+            routines::copy_broadcast( v.f.curvKappa()[0], result, grid);
         }
     },
     { "CurvatureKappaZ", "Z-component of the Kappa B curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.curvKappa()[1];
+            routines::copy_broadcast( v.f.curvKappa()[1], result, grid);
         }
     },
     { "CurvatureKappaP", "Contravariant Phi-component of the Kappa B curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.curvKappa()[2];
+            routines::copy_broadcast( v.f.curvKappa()[2], result, grid);
         }
     },
     { "DivCurvatureKappa", "Divergence of the Kappa B curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.divCurvKappa();
+            routines::copy_broadcast( v.f.divCurvKappa(), result, grid);
         }
     },
     { "CurvatureR", "R-component of the curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.curv()[0];
+            routines::copy_broadcast( v.f.curv()[0], result, grid);
         }
     },
     { "CurvatureZ", "Z-component of the full curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.curv()[1];
+            routines::copy_broadcast( v.f.curv()[1], result, grid);
         }
     },
     { "CurvatureP", "Contravariant Phi-component of the full curvature vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.curv()[2];
+            routines::copy_broadcast( v.f.curv()[2], result, grid);
         }
     },
     { "bphi", "Contravariant Phi-component of the magnetic unit vector",
         []( dg::x::HVec& result, Variables& v, dg::x::CylindricalGrid3d& grid){
-            result = v.f.bphi();
+            routines::copy_broadcast( v.f.bphi(), result, grid);
         }
     },
     {"NormGradPsip", "Norm of gradient of Psip",
@@ -35,7 +35,7 @@ struct ImplicitDensity
         dg::SparseTensor<Container> hh
             = dg::geo::createProjectionTensor( bhat, g);
         //set perpendicular projection tensor h
-        m_lapM_perpN.set_chi( hh);
+        m_lapM_perpN.set_chi( dg::broadcast_plane( hh, g));
         if( p.curvmode != "true")
             m_lapM_perpN.set_compute_in_2d( true);
 
@@ -126,7 +126,7 @@ struct ImplicitVelocity
         dg::SparseTensor<Container> hh
             = dg::geo::createProjectionTensor( bhat, g);
         //set perpendicular projection tensor h
-        m_lapM_perpU.set_chi( hh);
+        m_lapM_perpU.set_chi( dg::broadcast_plane( hh, g));
         if( p.curvmode != "true")
             m_lapM_perpU.set_compute_in_2d(true);
         //m_induction.construct(  g,
@@ -144,7 +144,8 @@ struct ImplicitVelocity
                 bhat, m_multigrid.grid(u));
             m_multi_induction[u].construct(  m_multigrid.grid(u),
                 p.bcxU, p.bcyU, dg::PER, -1., dg::centered);
-            m_multi_induction[u].elliptic().set_chi( hh);
+            m_multi_induction[u].elliptic().set_chi(
+                dg::broadcast_plane( hh, m_multigrid.grid(u)));
             if( p.curvmode != "true")
                 m_multi_induction[u].elliptic().set_compute_in_2d(true);
         }
@@ -2,6 +2,7 @@
 #include <map>
 #include <array>
 #include <string>
+#include <limits>
 #include "dg/enums.h"
 #include "json/json.h"
 #include "dg/file/json_utilities.h"
@@ -47,9 +48,14 @@ struct Parameters
     double boxscaleZm, boxscaleZp;
 
     enum dg::bc bcxN, bcyN, bcxU, bcyU, bcxP, bcyP;
-    std::string initne, initphi, curvmode, perp_diff;
+    std::string initne, initphi, curvmode, perp_diff, gamma_solver;
     std::string source_type, sheath_bc;
     bool symmetric, periodify, explicit_diffusion ;
+    std::vector<double> probesR, probesZ, probesP;
+    unsigned probes_buffer = 100;
+    // output reduction of 3d fields: divide n, Nx, Ny and stride Nz and region R0, R1, Z0, Z1
+    std::map<std::string, std::array<unsigned,4>> reduction_divide;
+    std::map<std::string, std::array<double,4>> reduction_region;
     Parameters() = default;
     Parameters( const Json::Value& js, enum dg::file::error mode = dg::file::error::is_warning ) {
         //We need to check if a member is present
@@ -77,6 +83,17 @@ struct Parameters
         jfactor     = dg::file::get( mode, js, "jumpfactor", 1).asDouble();
 
         eps_gamma   = dg::file::get( mode, js, "eps_gamma", 1e-6).asDouble();
+        gamma_solver = dg::file::get( mode, js, "gamma_solver", "multigrid").asString();
+        if( !(gamma_solver == "multigrid" || gamma_solver == "chebyshev"))
+        {
+            if( dg::file::error::is_throw == mode)
+                throw std::runtime_error( "Value "+gamma_solver+" for gamma_solver is invalid! Must be either multigrid or chebyshev\n");
+            else if ( dg::file::error::is_warning == mode)
+                std::cerr << "Value "+gamma_solver+" for gamma_solver is invalid!\n";
+            else
+                ;
+            gamma_solver = "multigrid";
+        }
         mx          = dg::file::get_idx( mode, js,"FCI","refine", 0u, 1).asUInt();
         my          = dg::file::get_idx( mode, js,"FCI","refine", 1u, 1).asUInt();
         rk4eps      = dg::file::get( mode, js,"FCI", "rk4eps", 1e-6).asDouble();
@@ -145,6 +162,34 @@ struct Parameters
 
         curvmode    = dg::file::get( mode, js, "curvmode", "toroidal").asString();
         symmetric   = dg::file::get( mode, js, "symmetric", false).asBool();
+        if( js.isMember( "probes"))
+        {
+            for( unsigned i=0; i<js["probes"]["R"].size(); i++)
+            {
+                probesR.push_back( dg::file::get_idx( mode, js, "probes", "R", i, 0.).asDouble());
+                probesZ.push_back( dg::file::get_idx( mode, js, "probes", "Z", i, 0.).asDouble());
+                probesP.push_back( dg::file::get_idx( mode, js, "probes", "P", i, 0.).asDouble());
+            }
+            probes_buffer = dg::file::get( mode, js, "probes", "buffer", 100).asUInt();
+        }
+        if( js.isMember( "reduction"))
+        {
+            const double inf = std::numeric_limits<double>::infinity();
+            const Json::Value& jr = js["reduction"];
+            for( auto name : jr.getMemberNames())
+            {
+                reduction_divide[name] = {
+                    dg::file::get_idx( mode, jr, name, "divide", 0u, 1).asUInt(),
+                    dg::file::get_idx( mode, jr, name, "divide", 1u, cx).asUInt(),
+                    dg::file::get_idx( mode, jr, name, "divide", 2u, cy).asUInt(),
+                    dg::file::get( mode, jr, name, "stride_Nz", 1).asUInt()};
+                reduction_region[name] = {
+                    dg::file::get_idx( mode, jr, name, "region", 0u, -inf).asDouble(),
+                    dg::file::get_idx( mode, jr, name, "region", 1u, +inf).asDouble(),
+                    dg::file::get_idx( mode, jr, name, "region", 2u, -inf).asDouble(),
+                    dg::file::get_idx( mode, jr, name, "region", 3u, +inf).asDouble()};
+            }
+        }
     }
 };
 
@@ -1,5 +1,7 @@
 #pragma once
 // #include <string>
+#include <iostream>
+#include <stdexcept>
 #include "dg/enums.h"
 
 // #include "dg/algorithm.h"
@@ -32,9 +34,9 @@ struct Parameters
     double lx, ly;
     dg::bc bc_x, bc_y;
 
-    std::string init, equations, output, timestepper;
+    std::string init, equations, output, timestepper, gamma_solver;
 
-    Parameters( const dg::file::WrappedJsonValue& ws ) {
+    Parameters( const dg::file::WrappedJsonValue& ws, enum dg::file::error mode = dg::file::error::is_throw ) {
         n  = ws["grid"].get("n", 5).asUInt();
         Nx = ws["grid"].get("Nx", 64).asUInt();
         Ny = ws["grid"].get("Ny", 64).asUInt();
@@ -64,6 +66,17 @@ struct Parameters
          
         eps_gamma1  = ws["helmholtz"].get("eps_gamma1",1e-6).asDouble();
         eps_gamma0  = ws["helmholtz"].get("eps_gamma0",1e-6).asDouble();
+        gamma_solver = ws["helmholtz"].get("gamma_solver", "multigrid").asString();
+        if( !(gamma_solver == "multigrid" || gamma_solver == "chebyshev"))
+        {
+            if( dg::file::error::is_throw == mode)
+                throw std::runtime_error( "Value "+gamma_solver+" for gamma_solver is invalid! Must be either multigrid or chebyshev\n");
+            else if ( dg::file::error::is_warning == mode)
+                std::cerr << "Value "+gamma_solver+" for gamma_solver is invalid!\n";
+            else
+                ;
+            gamma_solver = "multigrid";
+        }
         eps_cauchy = ws["helmholtz"].get("eps_cauchy",1e-10).asDouble();
         maxiter_sqrt = ws["helmholtz"].get("maxiter_sqrt",500).asUInt();
         maxiter_cauchy = ws["helmholtz"].get("maxiter_cauchy",40).asUInt();
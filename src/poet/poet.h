@@ -46,9 +46,14 @@ struct Poet
      */
     void gamma1_y( const container& y, container& yp)
     {
-        std::vector<unsigned> number = m_multigrid.direct_solve( m_multi_g1, yp, y, m_p.eps_gamma1);
-        if(  number[0] == m_multigrid.max_iter())
-            throw dg::Fail( m_p.eps_gamma1);
+        if( m_p.gamma_solver == "chebyshev")
+            m_cheby_g1.inverse( m_multi_g1[0], yp, y);
+        else
+        {
+            std::vector<unsigned> number = m_multigrid.direct_solve( m_multi_g1, yp, y, m_p.eps_gamma1);
+            if(  number[0] == m_multigrid.max_iter())
+                throw dg::Fail( m_p.eps_gamma1);
+        }
     }
     /**
      * @brief compute \f$  \Gamma_1 yp = y \f$ (or \f$ \sqrt{\Gamma_1} yp =  y \f$ )
@@ -150,6 +155,7 @@ struct Poet
     dg::Advection<Geometry, Matrix, container> m_adv;
     
     dg::MultigridCG2d<Geometry, Matrix, container> m_multigrid;
+    dg::ChebyshevHelmholtz<container> m_cheby_g1;
     dg::Extrapolation<container> m_phi_ex, m_psi1_ex, m_gamma_n_ex, m_gamma0sqrt_phi_ex, m_rho_ex, m_gamma0sqrtinv_rho_ex;
     std::vector<container> m_multi_chi, m_multi_iota;
     
@@ -189,6 +195,12 @@ Poet< Geometry, M,  container>::Poet( const Geometry& grid, const Parameters& p
         m_multi_g1[u].construct( m_multigrid.grid(u), -0.5*p.tau[1], dg::centered, p.jfactor);     
     }
     m_sqrtsolve.construct( m_multi_g0[0], grid, m_chi,  p.eps_cauchy, p.maxiter_sqrt, p.maxiter_cauchy,  p.eps_gamma0);
+    if( p.gamma_solver == "chebyshev")
+    {
+        m_cheby_g1.construct( m_chi, p.eps_gamma1);
+        m_cheby_g1.set_bounds( m_multi_g1[0], dg::construct<container>(
+            dg::evaluate( dg::WhiteNoise(), grid)));
+    }
 }
 
 template< class G,  class M, class container>
@@ -205,10 +217,8 @@ const container& Poet<G,  M,  container>::compute_psi( double t, const container
         }
         else {
             m_psi1_ex.extrapolate( t, m_psi1);
-            std::vector<unsigned> number = m_multigrid.direct_solve( m_multi_g1, m_psi1, potential, m_p.eps_gamma1);
+            gamma1_y( potential, m_psi1);
             m_psi1_ex.update( t, m_psi1);
-            if(  number[0] == m_multigrid.max_iter())
-                throw dg::Fail( m_p.eps_gamma1);
         }
 
         if ( m_p.equations == "ff-O2") {
@@ -263,10 +273,8 @@ const container& Poet<G,  M, container>::polarisation( double t, const std::arra
     }
     else { //"ff-lwl" || "df-lwl" || "df-O2"  || "ff-O2"
         m_gamma_n_ex.extrapolate(t, m_gamma_n);
-        std::vector<unsigned> number = m_multigrid.direct_solve( m_multi_g1, m_gamma_n, y[1], m_p.eps_gamma1);
+        gamma1_y( y[1], m_gamma_n);
         m_gamma_n_ex.update(t, m_gamma_n);
-        if(  number[0] == m_multigrid.max_iter())
-            throw dg::Fail( m_p.eps_gamma1);
     }
 
 //     if( m_p.equations == "ff-O2" || m_p.equations == "ff-O4" )
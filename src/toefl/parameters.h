@@ -27,6 +27,9 @@ struct Parameters
     std::string init, equations;
     bool boussinesq;
 
+    std::vector<double> probes_x, probes_y;
+    unsigned probes_buffer = 100;
+
     Parameters( const dg::file::WrappedJsonValue& js) {
         n  = js["n"].asUInt();
         Nx = js["Nx"].asUInt();
@@ -57,6 +60,15 @@ struct Parameters
         boussinesq = js.get("boussinesq", false).asBool();
         friction = js.get("friction", 0.).asDouble();
         jfactor = js.get("jfactor", 1.).asDouble();
+        if( js.asJson().isMember( "probes"))
+        {
+            for( unsigned i=0; i<js["probes"]["x"].asJson().size(); i++)
+            {
+                probes_x.push_back( js["probes"]["x"][i].asDouble());
+                probes_y.push_back( js["probes"]["y"][i].asDouble());
+            }
+            probes_buffer = js["probes"].get( "buffer", 100).asUInt();
+        }
     }
 
     void display( std::ostream& os = std::cout ) const
@@ -93,6 +105,7 @@ struct Parameters
             <<"scale for jump terms:    "<<jfactor<<"\n"
             <<"Stopping for Gamma CG:   "<<eps_gamma<<"\n"
             <<"Steps between output:    "<<itstp<<"\n"
-            <<"Number of outputs:       "<<maxout<<std::endl; //the endl is for the implicit flush
+            <<"Number of outputs:       "<<maxout<<"\n"
+            <<"Number of probes:        "<<probes_x.size()<<std::endl; //the endl is for the implicit flush
     }
 };
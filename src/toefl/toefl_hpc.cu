@@ -87,6 +87,11 @@ int main( int argc, char* argv[])
     DG_RANK0 err = nc_def_var( ncid, "mass",        NC_DOUBLE, 1, &EtimeID, &massID);
     DG_RANK0 err = nc_def_var( ncid, "dissipation", NC_DOUBLE, 1, &EtimeID, &dissID);
     DG_RANK0 err = nc_def_var( ncid, "dEdt",        NC_DOUBLE, 1, &EtimeID, &dEdtID);
+    //probes are buffered every time step and written in blocks
+    dg::file::Probes<dg::x::IDMatrix, dg::x::DVec> probes( p.probes_x,
+        p.probes_y, grid, {"electrons_probes", "ions_probes",
+        "potential_probes"}, p.probes_buffer);
+    DG_RANK0 err = probes.define( ncid);
     DG_RANK0 err = nc_enddef(ncid);
     dg::x::DVec transfer( dg::evaluate( dg::zero, grid));
     ///////////////////////////////////first output/////////////////////////
@@ -128,6 +133,13 @@ int main( int argc, char* argv[])
         for( unsigned j=0; j<p.itstp; j++)
         {
             karniadakis.step( exp, imp, time, y1);
+            probes.buffer( time, {&y1[0], &y1[1], &exp.potential()[0]});
+            if( probes.full())
+            {
+                DG_RANK0 err = nc_open(argv[2], NC_WRITE, &ncid);
+                err = probes.flush( ncid);
+                DG_RANK0 err = nc_close(ncid);
+            }
             //store accuracy details
             {
                 DG_RANK0 std::cout << "(m_tot-m_0)/m_0: "<< (exp.mass()-mass0)/mass_blob0<<"\t";
@@ -164,6 +176,7 @@ int main( int argc, char* argv[])
             dg::file::put_vara_double( ncid, dataIDs[k], start, grid_out, transferH);
         }
         DG_RANK0 err = nc_put_vara_double( ncid, tvarID, &start, &count, &time);
+        err = probes.flush( ncid);
         DG_RANK0 err = nc_close(ncid);
 
 #ifdef DG_BENCHMARK